@@ -0,0 +1,53 @@
+import os, struct
+import numpy as np
+
+# Reader of the binary event logs written by scratch/EventLog.h
+
+EVENT_TYPES = ['PktSent', 'PktRcvd', 'PktFwd']
+
+def read_records(file_name):
+    """Records of an event log, as a numpy structured array."""
+    with open(file_name, 'rb') as f:
+        magic = f.read(8)
+        if magic != b'NS3EVLOG':
+            raise ValueError(f'{file_name} is not an event log')
+        version, record_size, schema_size = struct.unpack('<III', f.read(12))
+        if version != 1:
+            raise ValueError(f'unknown event log version {version} in {file_name}')
+        schema = f.read(schema_size).decode()
+        dtype = np.dtype([(name, '<' + code) for name, code in (column.split(':') for column in schema.split(','))])
+        if dtype.itemsize != record_size:
+            raise ValueError(f'schema of {file_name} does not match the record size')
+        return np.fromfile(f, dtype=dtype)
+
+def to_columns(records):
+    """Columns of the records, with seqNo and eventType as in the former CSV logs."""
+    columns = {name: records[name] for name in records.dtype.names}
+    if 'src' in columns and 'seq' in columns:
+        columns['seqNo'] = np.char.add(np.char.add(records['src'].astype(str), '-'), records['seq'].astype(str))
+    if 'eventType' in columns:
+        columns['eventType'] = np.array(EVENT_TYPES)[records['eventType']]
+    return columns
+
+def read_polars(file_name):
+    """Event log as a polars DataFrame; name.csv is read if there is no name.evlog."""
+    import polars as pl
+    base, _ = os.path.splitext(file_name)
+    if os.path.isfile(base + '.evlog'):
+        return pl.DataFrame(to_columns(read_records(base + '.evlog')))
+    return pl.read_csv(base + '.csv')
+
+def read_pandas(file_name):
+    """Event log as a pandas DataFrame; name.csv is read if there is no name.evlog."""
+    import pandas as pd
+    base, _ = os.path.splitext(file_name)
+    if os.path.isfile(base + '.evlog'):
+        return pd.DataFrame(to_columns(read_records(base + '.evlog')))
+    return pd.read_csv(base + '.csv')
+
+def remove(file_name):
+    """Remove an event log, whichever its format."""
+    base, _ = os.path.splitext(file_name)
+    for ext in ['.evlog', '.csv']:
+        if os.path.isfile(base + ext):
+            os.remove(base + ext)
@@ -4,6 +4,8 @@ import polars as pl
 import numpy as np
 import time
 import argparse
+from event_log import read_polars as read_event_log
+from trajectory import read_polars as read_trajectory
 from google.cloud import bigquery
 
 def persist_df(df, table_name, backoff_window = 10):
@@ -36,9 +38,7 @@ def persist_df(df, table_name, backoff_window = 10):
         persist_df(df, table_name, backoff_window * 2)
 
 def get_reception_rate(events, positions):
-    event_times = events['timestamp'].unique()
-    positions = positions.groupby('nodeId').apply(lambda group: pl.concat([group, pl.DataFrame(event_times)], how="diagonal").sort('timestamp').interpolate())
-    positions = positions.filter(~pl.col('pos_x').is_null() & pl.col('timestamp').is_in(event_times))
+    # positions holds the exact position of every node at every event time
     events = events.join(positions, how='inner', on=['nodeId','timestamp'])
     sent_events = events.filter(pl.col('eventType') == "PktSent")
     received_events = events.filter((pl.col('eventType') == "PktRcvd") & (pl.col('numHops') == 0))
@@ -73,8 +73,8 @@ def main(args):
     v = args.v
     event_log = args.events_file_name
     position_log = args.course_file_name
-    events = pl.read_csv(f'./res/v{v}/{event_log}.csv')
-    positions = pl.read_csv(f'./res/v{v}/{position_log}.csv', dtypes = [pl.Float64, pl.Int64, pl.Float32, pl.Float32, pl.Float32])
+    events = read_event_log(f'./res/v{v}/{event_log}')
+    positions = read_trajectory(f'./res/v{v}/{position_log}.evlog', events['timestamp'].unique()).with_columns([pl.col('nodeId').cast(pl.Int64), pl.col('pos_x').cast(pl.Float32), pl.col('pos_y').cast(pl.Float32), pl.col('pos_z').cast(pl.Float32)])
     (reception_rates, estimated_loss_rate, pos_x, pos_y) = get_reception_rate(events, positions)
     loss_rate = pd.DataFrame({
         'pos_x': pos_x,
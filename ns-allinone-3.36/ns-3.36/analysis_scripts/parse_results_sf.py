@@ -2,6 +2,7 @@ import sys, os
 import json
 import pandas as pd
 import numpy as np
+import event_log
 
 
 def get_dissemation_ratio(data, nodeId):
@@ -43,7 +44,7 @@ def get_avg_aoi(aoi_ts):
     return np.trapz(y, x) / total_time
 
 def main(v, num_nodes, send_interval=500, forwardingProbability=1.0, run=1):
-    data = pd.read_csv(f'./res/v{v}/sf_n{int(num_nodes)}_i{int(send_interval)}_p{int(forwardingProbability * 100)}_r{run}.csv')
+    data = event_log.read_pandas(f'./res/v{v}/sf_n{int(num_nodes)}_i{int(send_interval)}_p{int(forwardingProbability * 100)}_r{run}')
     forwarded_events = data[(data['eventType'] == 'PktRcvd')]
 
     aoi = []
@@ -68,7 +69,7 @@ def main(v, num_nodes, send_interval=500, forwardingProbability=1.0, run=1):
 
     with open(f'./res/v{v}_parsed/sf_n{int(num_nodes)}_i{int(send_interval)}_p{int(forwardingProbability * 100)}_r{run}.json', 'w') as f:
         json.dump(data, f, indent=4, sort_keys=True)
-        os.remove(f'./res/v{v}/sf_n{int(num_nodes)}_i{int(send_interval)}_p{int(forwardingProbability * 100)}_r{run}.csv')
+        event_log.remove(f'./res/v{v}/sf_n{int(num_nodes)}_i{int(send_interval)}_p{int(forwardingProbability * 100)}_r{run}')
 
 
 if __name__ == "__main__":
@@ -17,13 +17,14 @@ def main(v, file_name):
     except:
         print('No loss rate found')
 
+    # The KPI file is a time series, its last line holds the KPIs of the whole run
     stats = {
-        'num_sent': int(data['sumSent'][0]),
-        'num_coded': int(data['sumSentCoded'][0]),
-        'num_rcvd': int(data['sumRcvd'][0]),
-        'num_fwd': int(data['sumFwd'][0]),
-        'excess_probability_1_R_peak': float(data['pe500'][0]),
-        'avg_dissemination_rate': float(data['pd'][0]),
+        'num_sent': int(data['sumSent'].iloc[-1]),
+        'num_coded': int(data['sumSentCoded'].iloc[-1]),
+        'num_rcvd': int(data['sumRcvd'].iloc[-1]),
+        'num_fwd': int(data['sumFwd'].iloc[-1]),
+        'excess_probability_1_R_peak': float(data['pe500'].iloc[-1]),
+        'avg_dissemination_rate': float(data['pd'].iloc[-1]),
         'avg_loss_rate': avg_loss_rate
     }
 
@@ -48,13 +48,14 @@ def main(args):
 
     duration = time.time() - args.start_time
 
+    # The KPI file is a time series, its last line holds the KPIs of the whole run
     stats = {
-        'num_sent': int(data['sumSent'][0]),
-        'num_coded': int(data['sumSentCoded'][0]),
-        'num_rcvd': int(data['sumRcvd'][0]),
-        'num_fwd': int(data['sumFwd'][0]),
-        'excess_probability_1_R_peak': float(data['pe500'][0]),
-        'avg_dissemination_rate': float(data['pd'][0]),
+        'num_sent': int(data['sumSent'][-1]),
+        'num_coded': int(data['sumSentCoded'][-1]),
+        'num_rcvd': int(data['sumRcvd'][-1]),
+        'num_fwd': int(data['sumFwd'][-1]),
+        'excess_probability_1_R_peak': float(data['pe500'][-1]),
+        'avg_dissemination_rate': float(data['pd'][-1]),
         'avg_loss_rate': avg_loss_rate,
         'duration': duration,
         'v': args.v,
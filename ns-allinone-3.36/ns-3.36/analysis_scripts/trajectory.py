@@ -0,0 +1,71 @@
+import numpy as np
+import event_log
+
+# Reader of the trajectory files written by ns3::TrajectoryRecorder: one
+# segment (timestamp, position, velocity) per course change of a node, in
+# the binary event log format.
+
+class Trajectories:
+    def __init__(self, file_name):
+        records = event_log.read_records(file_name)
+        if 'vel_x' not in records.dtype.names:
+            raise ValueError(f'{file_name} is not a trajectory file')
+        # Stable, so that of several segments starting at the same time the last one written stays last
+        records = records[np.lexsort((records['timestamp'], records['nodeId']))]
+        self.node_ids, self.starts = np.unique(records['nodeId'], return_index=True)
+        self.ends = np.append(self.starts[1:], len(records))
+        self.timestamps = records['timestamp']
+        self.positions = np.stack([records['pos_x'], records['pos_y'], records['pos_z']], axis=1)
+        self.velocities = np.stack([records['vel_x'], records['vel_y'], records['vel_z']], axis=1)
+
+    def segments(self, node_ids, times):
+        """Index of the segment of each node at each time."""
+        node_ids = np.asarray(node_ids)
+        times = np.asarray(times, dtype=np.float64)
+        node_ids, times = np.broadcast_arrays(node_ids, times)
+        nodes = np.searchsorted(self.node_ids, node_ids)
+        if np.any(nodes >= len(self.node_ids)) or np.any(self.node_ids[np.minimum(nodes, len(self.node_ids) - 1)] != node_ids):
+            raise KeyError('no trajectory for some of the nodes')
+        index = np.empty(node_ids.shape, dtype=np.int64)
+        for node in np.unique(nodes):
+            mask = nodes == node
+            start, end = self.starts[node], self.ends[node]
+            found = np.searchsorted(self.timestamps[start:end], times[mask], side='right') - 1
+            # Before the first segment, the node is at its first position
+            index[mask] = start + np.maximum(found, 0)
+        return index, times
+
+    def position(self, node_ids, times):
+        """Exact positions, as an array of shape (..., 3), of the nodes at the times."""
+        index, times = self.segments(node_ids, times)
+        dt = np.maximum(times - self.timestamps[index], 0.0)
+        return self.positions[index] + self.velocities[index] * dt[..., np.newaxis]
+
+    def velocity(self, node_ids, times):
+        """Velocities, as an array of shape (..., 3), of the nodes at the times."""
+        index, _ = self.segments(node_ids, times)
+        return self.velocities[index]
+
+    def columns(self, times, node_ids=None):
+        """Positions of the nodes (all by default) at each of the times, as columns like those of the former course logs."""
+        node_ids = self.node_ids if node_ids is None else np.asarray(node_ids)
+        times = np.asarray(times, dtype=np.float64)
+        grid_nodes, grid_times = np.meshgrid(node_ids, times, indexing='ij')
+        positions = self.position(grid_nodes.ravel(), grid_times.ravel())
+        return {
+            'timestamp': grid_times.ravel(),
+            'nodeId': grid_nodes.ravel(),
+            'pos_x': positions[:, 0],
+            'pos_y': positions[:, 1],
+            'pos_z': positions[:, 2],
+        }
+
+def read_polars(file_name, times, node_ids=None):
+    """Positions of the nodes at the times, as a polars DataFrame."""
+    import polars as pl
+    return pl.DataFrame(Trajectories(file_name).columns(times, node_ids))
+
+def read_pandas(file_name, times, node_ids=None):
+    """Positions of the nodes at the times, as a pandas DataFrame."""
+    import pandas as pd
+    return pd.DataFrame(Trajectories(file_name).columns(times, node_ids))
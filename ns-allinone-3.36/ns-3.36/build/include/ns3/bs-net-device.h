@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/wimax/model/bs-net-device.h
\ No newline at end of file
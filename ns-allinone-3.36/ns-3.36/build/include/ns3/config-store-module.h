@@ -0,0 +1,8 @@
+#ifdef NS3_MODULE_COMPILATION 
+    error "Do not include ns3 module aggregator headers from other modules these are meant only for end user scripts." 
+#endif 
+#ifndef NS3_MODULE_CONFIG_STORE
+    // Module headers: 
+    #include <ns3/file-config.h>
+    #include <ns3/config-store.h>
+#endif 
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/config-store/model/config-store.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/spectrum/model/constant-spectrum-propagation-loss.h
\ No newline at end of file
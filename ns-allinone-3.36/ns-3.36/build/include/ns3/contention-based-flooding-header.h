@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/applications/model/contention-based-flooding-header.h
\ No newline at end of file
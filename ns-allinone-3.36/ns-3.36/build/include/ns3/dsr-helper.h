@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/dsr/helper/dsr-helper.h
\ No newline at end of file
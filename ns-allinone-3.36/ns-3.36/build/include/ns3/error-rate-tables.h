@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/wifi/model/reference/error-rate-tables.h
\ No newline at end of file
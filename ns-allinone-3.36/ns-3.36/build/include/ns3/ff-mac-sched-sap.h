@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/lte/model/ff-mac-sched-sap.h
\ No newline at end of file
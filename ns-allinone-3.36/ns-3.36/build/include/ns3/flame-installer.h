@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/mesh/helper/flame/flame-installer.h
\ No newline at end of file
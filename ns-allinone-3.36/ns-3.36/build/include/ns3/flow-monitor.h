@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/flow-monitor/model/flow-monitor.h
\ No newline at end of file
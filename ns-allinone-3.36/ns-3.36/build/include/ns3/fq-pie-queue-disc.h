@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/traffic-control/model/fq-pie-queue-disc.h
\ No newline at end of file
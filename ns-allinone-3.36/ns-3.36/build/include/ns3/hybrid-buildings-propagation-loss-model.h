@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/buildings/model/hybrid-buildings-propagation-loss-model.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/internet/model/icmpv4-l4-protocol.h
\ No newline at end of file
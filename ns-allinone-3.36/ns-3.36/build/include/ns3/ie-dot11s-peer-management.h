@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/mesh/model/dot11s/ie-dot11s-peer-management.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/internet/helper/ipv4-address-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/internet/model/ipv4-end-point-demux.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/nix-vector-routing/model/ipv4-nix-vector-routing.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/antenna/model/isotropic-antenna-model.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/propagation/model/kun-2600-mhz-propagation-loss-model.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/lr-wpan/model/lr-wpan-csmaca.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/lr-wpan/model/lr-wpan-lqi-tag.h
\ No newline at end of file
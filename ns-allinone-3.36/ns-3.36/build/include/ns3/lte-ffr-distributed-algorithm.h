@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/lte/model/lte-ffr-distributed-algorithm.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/wifi/model/he/mu-edca-parameter-set.h
\ No newline at end of file
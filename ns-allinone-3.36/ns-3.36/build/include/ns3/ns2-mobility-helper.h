@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/mobility/helper/ns2-mobility-helper.h
\ No newline at end of file
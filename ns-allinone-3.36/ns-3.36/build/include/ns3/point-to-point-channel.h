@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/point-to-point/model/point-to-point-channel.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/point-to-point-layout/model/point-to-point-grid.h
\ No newline at end of file
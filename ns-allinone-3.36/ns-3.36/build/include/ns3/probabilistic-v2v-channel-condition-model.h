@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/propagation/model/probabilistic-v2v-channel-condition-model.h
\ No newline at end of file
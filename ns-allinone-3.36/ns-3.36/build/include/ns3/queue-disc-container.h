@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/traffic-control/helper/queue-disc-container.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/buildings/model/random-walk-2d-outdoor-mobility-model.h
\ No newline at end of file
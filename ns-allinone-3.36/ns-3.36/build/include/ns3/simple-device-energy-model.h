@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/energy/model/simple-device-energy-model.h
\ No newline at end of file
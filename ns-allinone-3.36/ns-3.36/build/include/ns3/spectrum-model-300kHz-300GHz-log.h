@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/spectrum/model/spectrum-model-300kHz-300GHz-log.h
\ No newline at end of file
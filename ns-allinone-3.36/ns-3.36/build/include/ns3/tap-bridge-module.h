@@ -0,0 +1,9 @@
+#ifdef NS3_MODULE_COMPILATION 
+    error "Do not include ns3 module aggregator headers from other modules these are meant only for end user scripts." 
+#endif 
+#ifndef NS3_MODULE_TAP_BRIDGE
+    // Module headers: 
+    #include <ns3/tap-bridge-helper.h>
+    #include <ns3/tap-bridge.h>
+    #include <ns3/tap-encode-decode.h>
+#endif 
\ No newline at end of file
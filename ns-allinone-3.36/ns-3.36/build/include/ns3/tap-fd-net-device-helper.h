@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/fd-net-device/helper/tap-fd-net-device-helper.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/buildings/model/three-gpp-v2v-channel-condition-model.h
\ No newline at end of file
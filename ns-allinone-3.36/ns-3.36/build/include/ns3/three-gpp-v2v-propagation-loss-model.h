@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/propagation/model/three-gpp-v2v-propagation-loss-model.h
\ No newline at end of file
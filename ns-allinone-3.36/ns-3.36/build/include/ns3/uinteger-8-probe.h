@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/stats/model/uinteger-8-probe.h
\ No newline at end of file
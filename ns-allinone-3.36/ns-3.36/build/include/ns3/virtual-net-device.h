@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/virtual-net-device/model/virtual-net-device.h
\ No newline at end of file
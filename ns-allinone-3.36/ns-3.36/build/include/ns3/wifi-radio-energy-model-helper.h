@@ -0,0 +1 @@
+/root/repo/ns-allinone-3.36/ns-3.36/src/wifi/helper/wifi-radio-energy-model-helper.h
\ No newline at end of file
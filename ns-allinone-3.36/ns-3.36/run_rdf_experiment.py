@@ -21,13 +21,56 @@ def get_params(run_idx = 0):
         return None
     return params[run_idx]
 
+def run_batch(first_idx, count, v):
+    """Run count parameter sets in one process through flooding-scenario."""
+    study_name = f'./res/v{v}'
+    os.makedirs(f'{study_name}', exist_ok=True)
+    res_file_names = []
+    manifest = f'{study_name}/manifest_{first_idx}.txt'
+    with open(manifest, 'w') as f:
+        for idx in range(first_idx, first_idx + count):
+            params = get_params(idx)
+            if params == None:
+                break
+            num_nodes = params.get('num_nodes')
+            send_interval = params.get('send_interval')
+            run = params.get('run')
+            q = params.get('q')
+            density = 12
+            warmup = 5
+            A = num_nodes / density
+            size = math.sqrt(A) * 1000
+            simTime = size/33.3 + warmup
+
+            res_file_name = f'kpi_rdf_n{num_nodes}_i{int(send_interval*1000)}_q{int(q*100)}_r{run}'
+            if os.path.isfile(f'./res/v{v}_parsed/summary_{res_file_name}.json'):
+                continue
+            res_file_names.append(res_file_name)
+            f.write(f'scenarios/rdf.ini scenario.numNodes={num_nodes} scenario.seed={run} scenario.simTime={simTime}'
+                    f' protocol.interval={send_interval} protocol.decayFactor={q} mobility.size={size}'
+                    f' output.kpi={study_name}/{res_file_name}.csv'
+                    f' output.aoi={study_name}/{res_file_name.replace("kpi_", "aoi_", 1)}.csv\n')
+
+    if len(res_file_names) > 0:
+        subprocess.run(['./ns3', 'run', 'flooding-scenario', '--', f'--manifest={manifest}'])
+    for res_file_name in res_file_names:
+        subprocess.run(['python3', 'analysis_scripts/parse_results_v4.py', f'{v}', res_file_name])
+    os.remove(manifest)
+
 if __name__ == '__main__':
     run_command = 'rate-decay-flooding' 
     run_idx = int(sys.argv[1])
     offset = int(sys.argv[2])
-    params = get_params(run_idx + offset)
+    # optional: number of consecutive parameter sets run in one process
+    batch = int(sys.argv[3]) if len(sys.argv) > 3 else 1
     v = 43
 
+    if batch > 1:
+        run_batch(run_idx + offset, batch, v)
+        sys.exit(0)
+
+    params = get_params(run_idx + offset)
+
     if params != None:
 
         study_name = f'./res/v{v}'
@@ -18,8 +18,11 @@ public:
 
   ~CsvLogger ();
 
+  // Closes the current file, if any
   void SetFile(std::string file);
 
+  void Flush();
+
   void CreateEntry (uint32_t node_id, string seqNo, string eventType, string src, string lastHop, string delay, string numHops, string pL = "-1.0");
 
   void CreateCourse(uint32_t node_id, ns3::Ptr<const ns3::MobilityModel> mobility);
@@ -42,9 +45,17 @@ CsvLogger::~CsvLogger () {
 }
 
 void CsvLogger::SetFile(std::string file) {
+  if (outputFile.is_open()) {
+    outputFile.close();
+  }
+  createHeader = true;
   outputFile.open(file);
 }
 
+void CsvLogger::Flush() {
+  outputFile.flush();
+}
+
 void CsvLogger::CreateEntry (uint32_t node_id, string seqNo, string eventType, string src, string lastHop, string delay, string numHops, string pL){
   if (createHeader) {
     createHeader = false;
@@ -0,0 +1,298 @@
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+
+// Binary event logs, read by analysis_scripts/event_log.py without any
+// text parsing. Courses are recorded by ns3::TrajectoryRecorder, in the same
+// format. The file holds fixed size records after a header:
+//
+//   "NS3EVLOG"   magic, 8 bytes
+//   uint32       format version
+//   uint32       record size, in bytes
+//   uint32       schema size, then the schema: "name:type,..." where type
+//                is a numpy type code (f8, u4, u1)
+//   records      packed, little endian
+//
+// Records are buffered and written in large blocks, by a background thread
+// if asked for, so that logging does not flush the stream on every event.
+
+using namespace std;
+
+class EventLogWriter {
+public:
+  static const uint32_t VERSION = 1;
+  static const size_t BUFFER_SIZE = 4 << 20;
+
+  EventLogWriter ();
+
+  ~EventLogWriter ();
+
+  EventLogWriter (const EventLogWriter&) = delete;
+  EventLogWriter& operator= (const EventLogWriter&) = delete;
+
+  // Closes the current file, if any
+  void Open (std::string file, std::string schema, uint32_t recordSize, bool backgroundFlush);
+
+  bool IsOpen () const;
+
+  void Append (const void *record);
+
+  // Write the buffered records to the file
+  void Flush ();
+
+  void Close ();
+
+private:
+  void WriteBuffer ();
+
+  void FlushLoop ();
+
+  FILE *outputFile = nullptr;
+  uint32_t recordSize = 0;
+  std::vector<char> buffer;
+  size_t used = 0;
+
+  // Background flush: the thread writes pending while records go to buffer
+  bool background = false;
+  std::thread flushThread;
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<char> pending;
+  size_t pendingUsed = 0;
+  bool stop = false;
+};
+
+EventLogWriter::EventLogWriter () {
+}
+
+EventLogWriter::~EventLogWriter () {
+  Close();
+}
+
+void EventLogWriter::Open (std::string file, std::string schema, uint32_t recordSize, bool backgroundFlush) {
+  Close();
+  outputFile = fopen(file.c_str(), "wb");
+  if (outputFile == nullptr) {
+    NS_FATAL_ERROR("Cannot write event log " << file);
+  }
+  this->recordSize = recordSize;
+  buffer.resize(BUFFER_SIZE - BUFFER_SIZE % recordSize);
+  used = 0;
+
+  uint32_t header[3] = {VERSION, recordSize, static_cast<uint32_t>(schema.size())};
+  fwrite("NS3EVLOG", 1, 8, outputFile);
+  fwrite(header, sizeof(uint32_t), 3, outputFile);
+  fwrite(schema.data(), 1, schema.size(), outputFile);
+
+  background = backgroundFlush;
+  if (background) {
+    pending.resize(buffer.size());
+    pendingUsed = 0;
+    stop = false;
+    flushThread = std::thread(&EventLogWriter::FlushLoop, this);
+  }
+}
+
+bool EventLogWriter::IsOpen () const {
+  return outputFile != nullptr;
+}
+
+void EventLogWriter::Append (const void *record) {
+  if (used + recordSize > buffer.size()) {
+    WriteBuffer();
+  }
+  memcpy(&buffer[used], record, recordSize);
+  used += recordSize;
+}
+
+void EventLogWriter::WriteBuffer () {
+  if (used == 0) {
+    return;
+  }
+  if (!background) {
+    fwrite(buffer.data(), 1, used, outputFile);
+    used = 0;
+    return;
+  }
+  // Wait for the previous block to be written, then hand this one over
+  std::unique_lock<std::mutex> lock(mutex);
+  cv.wait(lock, [this] { return pendingUsed == 0; });
+  buffer.swap(pending);
+  pendingUsed = used;
+  used = 0;
+  cv.notify_all();
+}
+
+void EventLogWriter::FlushLoop () {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    cv.wait(lock, [this] { return pendingUsed > 0 || stop; });
+    if (pendingUsed > 0) {
+      // The producer waits for pendingUsed == 0 before touching pending
+      lock.unlock();
+      fwrite(pending.data(), 1, pendingUsed, outputFile);
+      lock.lock();
+      pendingUsed = 0;
+      cv.notify_all();
+    }
+    else if (stop) {
+      return;
+    }
+  }
+}
+
+void EventLogWriter::Flush () {
+  if (outputFile == nullptr) {
+    return;
+  }
+  WriteBuffer();
+  if (background) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return pendingUsed == 0; });
+  }
+  fflush(outputFile);
+}
+
+void EventLogWriter::Close () {
+  if (outputFile == nullptr) {
+    return;
+  }
+  Flush();
+  if (background) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    cv.notify_all();
+    flushThread.join();
+    background = false;
+  }
+  fclose(outputFile);
+  outputFile = nullptr;
+}
+
+/**
+ * Log of one record type, which provides its schema. Records are written
+ * as they are in memory, so they must be packed.
+ */
+template <class Record>
+class EventLog {
+public:
+  void SetFile (std::string file, bool backgroundFlush = false) {
+    writer.Open(file, Record::GetSchema(), sizeof(Record), backgroundFlush);
+  }
+
+  void Write (const Record &record) {
+    if (writer.IsOpen()) {
+      writer.Append(&record);
+    }
+  }
+
+  void Flush () {
+    writer.Flush();
+  }
+
+  void Close () {
+    writer.Close();
+  }
+
+private:
+  EventLogWriter writer;
+};
+
+#pragma pack(push, 1)
+
+struct PacketEvent {
+  enum Type : uint8_t {
+    SENT = 0,
+    RCVD = 1,
+    FWD = 2
+  };
+
+  double timestamp;
+  uint32_t nodeId;
+  uint32_t src;
+  uint32_t seq;
+  uint8_t eventType;
+  uint32_t lastHop;
+  double delay;
+  uint32_t numHops;
+  double pL;
+
+  static std::string GetSchema () {
+    return "timestamp:f8,nodeId:u4,src:u4,seq:u4,eventType:u1,lastHop:u4,delay:f8,numHops:u4,pL:f8";
+  }
+};
+
+struct ForwardingOptionEvent {
+  double timestamp;
+  uint32_t src;
+  uint32_t seq;
+  uint32_t forwarder;
+  double forwarder_x;
+  double forwarder_y;
+  uint32_t forwarded_from;
+  double forwarded_from_x;
+  double forwarded_from_y;
+  uint32_t option;
+  double option_x;
+  double option_y;
+
+  static std::string GetSchema () {
+    return "timestamp:f8,src:u4,seq:u4,forwarder:u4,forwarder_x:f8,forwarder_y:f8,"
+           "forwarded_from:u4,forwarded_from_x:f8,forwarded_from_y:f8,option:u4,option_x:f8,option_y:f8";
+  }
+};
+
+#pragma pack(pop)
+
+// Drop-in replacements of the CSV loggers
+
+class PacketEventLog : public EventLog<PacketEvent> {
+public:
+  void CreateEntry (uint32_t nodeId, uint32_t src, uint32_t seq, PacketEvent::Type type, uint32_t lastHop, double delay, uint32_t numHops, double pL = -1.0) {
+    PacketEvent event;
+    event.timestamp = ns3::Simulator::Now().GetSeconds();
+    event.nodeId = nodeId;
+    event.src = src;
+    event.seq = seq;
+    event.eventType = type;
+    event.lastHop = lastHop;
+    event.delay = delay;
+    event.numHops = numHops;
+    event.pL = pL;
+    Write(event);
+  }
+};
+
+class ForwardingOptionsEventLog : public EventLog<ForwardingOptionEvent> {
+public:
+  void CreateEntry (uint32_t src, uint32_t seq, uint32_t forwarder, ns3::Vector forwarderPos, uint32_t forwardedFrom, ns3::Vector forwardedFromPos, uint32_t option, ns3::Vector optionPos) {
+    ForwardingOptionEvent event;
+    event.timestamp = ns3::Simulator::Now().GetSeconds();
+    event.src = src;
+    event.seq = seq;
+    event.forwarder = forwarder;
+    event.forwarder_x = forwarderPos.x;
+    event.forwarder_y = forwarderPos.y;
+    event.forwarded_from = forwardedFrom;
+    event.forwarded_from_x = forwardedFromPos.x;
+    event.forwarded_from_y = forwardedFromPos.y;
+    event.option = option;
+    event.option_x = optionPos.x;
+    event.option_y = optionPos.y;
+    Write(event);
+  }
+};
+
+#endif
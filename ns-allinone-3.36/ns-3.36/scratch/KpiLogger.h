@@ -16,8 +16,11 @@ public:
 
   ~KpiLogger ();
 
+  // Closes the current file, if any
   void SetFile(std::string file);
 
+  void Flush();
+
   void CreateEntry (double pd, double pe500);
   void CreateEntry (double pd, double pe500, double sumSent, double sumRcvd, double sumFwd, double sumSentCoded = 0);
 
@@ -39,9 +42,17 @@ KpiLogger::~KpiLogger () {
 }
 
 void KpiLogger::SetFile(std::string file) {
+  if (outputFile.is_open()) {
+    outputFile.close();
+  }
+  createHeader = true;
   outputFile.open(file);
 }
 
+void KpiLogger::Flush() {
+  outputFile.flush();
+}
+
 void KpiLogger::CreateEntry (double pd, double pe500){
   if (createHeader) {
     createHeader = false;
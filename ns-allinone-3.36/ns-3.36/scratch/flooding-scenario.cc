@@ -0,0 +1,727 @@
+#include "ns3/core-module.h"
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/string.h"
+#include "ns3/log.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/yans-wifi-channel.h"
+#include "ns3/mobility-model.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-generator.h"
+
+#include "ns3/wifi-standards.h"
+#include "ns3/rectangle.h"
+#include "ns3/application-container.h"
+#include "ns3/flooding-helper.h"
+#include "ns3/aoi-histogram.h"
+#include "ns3/pure-flooding-application.h"
+#include "ns3/pure-flooding-header.h"
+#include "ns3/contention-based-flooding-application.h"
+#include "ns3/contention-based-flooding-header.h"
+#include "ns3/rate-decay-flooding-application.h"
+#include "ns3/rate-decay-flooding-nc-header.h"
+#include "ns3/trajectory-recorder.h"
+#include "ns3/reception-ratio-helper.h"
+#include "ns3/flooding-kpi-sampler.h"
+#include "EventLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Runs the flooding scenarios of the per-protocol scratch mains from a
+// scenario file, or a whole list of them in one process:
+//
+//   ./ns3 run "flooding-scenario --scenario=scenarios/rdf.ini"
+//   ./ns3 run "flooding-scenario --manifest=scenarios/example.manifest"
+//
+// A scenario file is made of "key = value" lines under [section] headers,
+// see scenarios/rdf.ini for all the keys. Every line of a manifest is a
+// scenario file followed by "section.key=value" overrides. The runs of a
+// manifest are meant to be spread over --threads threads, each with its own
+// simulator, but only --threads=1 is accepted for now: the callbacks shared
+// between threads still have plain reference counts, and the templated
+// TypeIds a run registers on first use are appended to the TypeId database
+// without a lock.
+//
+// A scenario with [variant.<name>] sections runs once up to
+// scenario.branchTime, then fork()s one process per variant, which sets
+// the attributes.* keys of its section with Config::Set and runs to the
+// end, writing the output.* files of its section. The trace and course up
+// to the branch time are those of the base scenario; outputs a variant does
+// not rename get "_<name>" appended.
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE("FloodingScenario");
+
+// fork() only copies the calling thread
+bool g_threaded = false;
+
+/**
+ * Parameters of a run, by "section.key".
+ */
+class Scenario
+{
+public:
+  void Load(const string &file)
+  {
+    ifstream in(file);
+    if (!in)
+    {
+      NS_FATAL_ERROR("Cannot read scenario " << file);
+    }
+    string line;
+    string section;
+    while (getline(in, line))
+    {
+      size_t comment = line.find_first_of(";#");
+      if (comment != string::npos)
+      {
+        line.erase(comment);
+      }
+      line = Trim(line);
+      if (line.empty())
+      {
+        continue;
+      }
+      if (line.front() == '[' && line.back() == ']')
+      {
+        section = Trim(line.substr(1, line.size() - 2));
+        continue;
+      }
+      size_t eq = line.find('=');
+      if (eq == string::npos)
+      {
+        NS_FATAL_ERROR("Invalid line in " << file << ": " << line);
+      }
+      Set(section + "." + Trim(line.substr(0, eq)), Trim(line.substr(eq + 1)));
+    }
+  }
+
+  /// \param assignment "section.key=value"
+  void Override(const string &assignment)
+  {
+    size_t eq = assignment.find('=');
+    if (eq == string::npos)
+    {
+      NS_FATAL_ERROR("Invalid override " << assignment);
+    }
+    Set(Trim(assignment.substr(0, eq)), Trim(assignment.substr(eq + 1)));
+  }
+
+  void Set(const string &key, const string &value)
+  {
+    if (m_values.find(key) == m_values.end())
+    {
+      m_keys.push_back(key);
+    }
+    m_values[key] = value;
+  }
+
+  string GetString(const string &key, const string &defaultValue = "") const
+  {
+    auto it = m_values.find(key);
+    return it == m_values.end() ? defaultValue : it->second;
+  }
+
+  double GetDouble(const string &key, double defaultValue) const
+  {
+    auto it = m_values.find(key);
+    return it == m_values.end() ? defaultValue : stod(it->second);
+  }
+
+  int GetInt(const string &key, int defaultValue) const
+  {
+    auto it = m_values.find(key);
+    return it == m_values.end() ? defaultValue : stoi(it->second);
+  }
+
+  /// \returns the names of the [variant.<name>] sections, in file order
+  vector<string> GetVariants() const
+  {
+    vector<string> variants;
+    string prefix = "variant.";
+    for (const string &key : m_keys)
+    {
+      if (key.compare(0, prefix.size(), prefix) != 0)
+      {
+        continue;
+      }
+      string name = key.substr(prefix.size(), key.find('.', prefix.size()) - prefix.size());
+      if (find(variants.begin(), variants.end(), name) == variants.end())
+      {
+        variants.push_back(name);
+      }
+    }
+    return variants;
+  }
+
+  /// \returns this scenario with the keys of the variant section set
+  Scenario GetVariant(const string &name) const
+  {
+    Scenario variant = *this;
+    for (const auto &entry : GetSection("variant." + name))
+    {
+      variant.Set(entry.first, entry.second);
+    }
+    return variant;
+  }
+
+  /// \returns the (key, value) pairs of the section, in file order
+  vector<pair<string, string>> GetSection(const string &section) const
+  {
+    vector<pair<string, string>> entries;
+    string prefix = section + ".";
+    for (const string &key : m_keys)
+    {
+      if (key.compare(0, prefix.size(), prefix) == 0)
+      {
+        entries.push_back(make_pair(key.substr(prefix.size()), m_values.at(key)));
+      }
+    }
+    return entries;
+  }
+
+private:
+  static string Trim(const string &s)
+  {
+    size_t begin = s.find_first_not_of(" \t\r");
+    if (begin == string::npos)
+    {
+      return "";
+    }
+    size_t end = s.find_last_not_of(" \t\r");
+    return s.substr(begin, end - begin + 1);
+  }
+
+  map<string, string> m_values;
+  vector<string> m_keys;
+};
+
+/**
+ * Output files of a run, closed when the run is done.
+ */
+struct RunOutputs
+{
+  PacketEventLog trace;
+  TrajectoryRecorder course;
+  ReceptionRatioHelper receptionRatio;
+  // Flushed at every sample
+  FloodingKpiSampler kpi;
+  bool tracing = false;
+  bool courses = false;
+  bool receptionRatios = false;
+
+  void Flush()
+  {
+    trace.Flush();
+    course.Flush();
+    receptionRatio.Flush();
+  }
+};
+
+struct PacketInfo
+{
+  uint32_t src;
+  uint32_t seq;
+  uint32_t lastHop;
+  uint32_t numHops;
+  Time ts;
+};
+
+template <class Header>
+PacketInfo GetPacketInfo(Ptr<const Packet> pkt)
+{
+  Header header;
+  pkt->PeekHeader(header);
+  return {header.GetSrc(), header.GetSeq(), header.GetLastHop(), (uint32_t)header.GetNumHops(), header.GetTs()};
+}
+
+template <>
+PacketInfo GetPacketInfo<RateDecayFloodingNcHeader>(Ptr<const Packet> pkt)
+{
+  RateDecayFloodingNcHeader header;
+  pkt->PeekHeader(header);
+  return {header.GetSrcLeft(), header.GetSeqLeft(), header.GetLastHop(), (uint32_t)header.GetNumHopsLeft(), header.GetTsLeft()};
+}
+
+void LogPacket(PacketEventLog *trace, PacketEvent::Type type, uint32_t nodeId, const PacketInfo &info, bool withDelay, double pL = -1.0)
+{
+  double delay = -1;
+  if (withDelay)
+  {
+    delay = (Simulator::Now() - info.ts).GetSeconds() * 1000;
+  }
+  trace->CreateEntry(nodeId, info.src, info.seq, type, info.lastHop, delay, info.numHops, pL);
+}
+
+template <class Header>
+void OnPacketReceive(PacketEventLog *trace, std::string context, Ptr<const Packet> pkt, uint32_t nodeId)
+{
+  LogPacket(trace, PacketEvent::RCVD, nodeId, GetPacketInfo<Header>(pkt), true);
+}
+
+template <class Header>
+void OnPacketSent(PacketEventLog *trace, std::string context, Ptr<const Packet> pkt, uint32_t nodeId)
+{
+  LogPacket(trace, PacketEvent::SENT, nodeId, GetPacketInfo<Header>(pkt), false);
+}
+
+template <class Header>
+void OnPacketForward(PacketEventLog *trace, std::string context, Ptr<const Packet> pkt, uint32_t nodeId)
+{
+  LogPacket(trace, PacketEvent::FWD, nodeId, GetPacketInfo<Header>(pkt), true);
+}
+
+void OnNcPacketSent(PacketEventLog *trace, std::string context, Ptr<const Packet> pkt, uint32_t nodeId, double pL)
+{
+  LogPacket(trace, PacketEvent::SENT, nodeId, GetPacketInfo<RateDecayFloodingNcHeader>(pkt), false, pL);
+}
+
+void OnNcPacketForward(PacketEventLog *trace, std::string context, Ptr<const Packet> pkt, uint32_t nodeId,
+                       vector<Ptr<Packet>> forwardingBuffer, Vector nodePos, double pL)
+{
+  LogPacket(trace, PacketEvent::FWD, nodeId, GetPacketInfo<ContentionBasedFloodingHeader>(pkt), true, pL);
+}
+
+/// Trace sources of the applications with a PlainCodingPolicy
+template <class Header>
+void ConnectPlainTraces(const string &typeName, RunOutputs &outputs)
+{
+  string path = "/NodeList/*/ApplicationList/0/$" + typeName + "/";
+  Config::Connect(path + "Rx", MakeBoundCallback(&OnPacketReceive<Header>, &outputs.trace));
+  Config::Connect(path + "Tx", MakeBoundCallback(&OnPacketSent<Header>, &outputs.trace));
+  Config::Connect(path + "Fwd", MakeBoundCallback(&OnPacketForward<Header>, &outputs.trace));
+}
+
+void ConnectRdfTraces(const string &typeName, RunOutputs &outputs)
+{
+  string path = "/NodeList/*/ApplicationList/0/$" + typeName + "/";
+  Config::Connect(path + "Rx", MakeBoundCallback(&OnPacketReceive<ContentionBasedFloodingHeader>, &outputs.trace));
+  Config::Connect(path + "Tx", MakeBoundCallback(&OnNcPacketSent, &outputs.trace));
+  Config::Connect(path + "Fwd", MakeBoundCallback(&OnNcPacketForward, &outputs.trace));
+}
+
+template <class App>
+void ResetStats(Ptr<App> app)
+{
+  app->ResetStats();
+}
+
+/**
+ * 802.11p nodes in a square, moving with RandomDirection2d, with IPv4.
+ */
+NodeContainer CreateNodes(const Scenario &scenario)
+{
+  int numNodes = scenario.GetInt("scenario.numNodes", 10);
+  double size = scenario.GetDouble("mobility.size", 0);
+  double speedMin = scenario.GetDouble("mobility.speedMin", -1.0);
+  double speedMax = scenario.GetDouble("mobility.speedMax", -1.0);
+  string phyMode = scenario.GetString("phy.phyMode", "OfdmRate3MbpsBW10MHz");
+
+  NodeContainer c;
+  c.Create(numNodes);
+
+  WifiHelper wifi;
+  wifi.SetStandard(WIFI_STANDARD_80211p);
+
+  YansWifiPhyHelper wifiPhy;
+  wifiPhy.Set("RxGain", DoubleValue(0));
+  wifiPhy.Set("RxSensitivity", DoubleValue(scenario.GetDouble("phy.rxSensitivity", -85)));
+  wifiPhy.Set("ChannelWidth", UintegerValue(10));
+  wifiPhy.Set("TxPowerStart", DoubleValue(scenario.GetDouble("phy.txPower", 20)));
+  wifiPhy.Set("TxPowerEnd", DoubleValue(scenario.GetDouble("phy.txPower", 20)));
+
+  YansWifiChannelHelper wifiChannel;
+  wifiChannel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
+  wifiChannel.AddPropagationLoss("ns3::FriisPropagationLossModel", "Frequency", DoubleValue(scenario.GetDouble("phy.frequency", 5.90e9)));
+  wifiPhy.SetChannel(wifiChannel.Create());
+
+  WifiMacHelper wifiMac;
+  // Fix non-unicast data rate to be the same as that of unicast. Set on the
+  // station managers rather than as a default, which all the threads share.
+  wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager", "DataMode", StringValue(phyMode), "ControlMode", StringValue(phyMode),
+                               "NonUnicastMode", StringValue(phyMode));
+  wifiMac.SetType("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install(wifiPhy, wifiMac, c);
+
+  ObjectFactory pos;
+  pos.SetTypeId("ns3::RandomRectanglePositionAllocator");
+  pos.Set("X", StringValue("ns3::UniformRandomVariable[Min=0.0|Max=" + to_string(size) + "]"));
+  pos.Set("Y", StringValue("ns3::UniformRandomVariable[Min=0.0|Max=" + to_string(size) + "]"));
+  Ptr<PositionAllocator> posAlloc = pos.Create()->GetObject<PositionAllocator>();
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel("ns3::RandomDirection2dMobilityModel",
+                            "Bounds", RectangleValue(Rectangle(0, size, 0, size)),
+                            "Speed", StringValue("ns3::UniformRandomVariable[Min=" + to_string(speedMin) + "|Max=" + to_string(speedMax) + "]"),
+                            "Pause", StringValue("ns3::ConstantRandomVariable[Constant=0.0]"));
+  mobility.SetPositionAllocator(posAlloc);
+  mobility.Install(c);
+
+  InternetStackHelper internet;
+  internet.Install(c);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase("10.1.0.0", "255.255.0.0");
+  ipv4.Assign(devices);
+  return c;
+}
+
+/**
+ * Fork one process per variant, and wait for them in the parent.
+ *
+ * \returns the variant to run in a child, or an empty string in the parent
+ */
+string ForkVariants(const vector<string> &variants, RunOutputs &outputs)
+{
+  if (g_threaded)
+  {
+    NS_FATAL_ERROR("Variants cannot be forked with --threads");
+  }
+  // Anything still buffered would be written by every child
+  outputs.Flush();
+  cout.flush();
+  clog.flush();
+
+  vector<pid_t> children;
+  for (const string &variant : variants)
+  {
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+      NS_FATAL_ERROR("fork() failed for variant " << variant);
+    }
+    if (pid == 0)
+    {
+      return variant;
+    }
+    children.push_back(pid);
+  }
+  for (size_t i = 0; i < children.size(); i++)
+  {
+    int status;
+    waitpid(children[i], &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+      NS_LOG_UNCOND("Variant " << variants[i] << " failed");
+    }
+  }
+  return "";
+}
+
+/**
+ * Install the applications, run the simulation and write the outputs.
+ */
+template <class App, class Helper>
+void RunFlooding(const Scenario &scenario, Helper &client, NodeContainer c, RunOutputs &outputs,
+                 void (*connectTraces)(const string &, RunOutputs &))
+{
+  // Any attribute of the application, by name
+  for (const auto &attribute : scenario.GetSection("attributes"))
+  {
+    client.SetAttribute(attribute.first, StringValue(attribute.second));
+  }
+
+  double startSpread = scenario.GetDouble("scenario.startSpread", 5.0);
+  Time warmup = Seconds(scenario.GetDouble("scenario.warmup", 5.0));
+  Ptr<UniformRandomVariable> startTimeRNG = CreateObject<UniformRandomVariable>();
+
+  for (uint32_t i = 0; i < c.GetN(); i++)
+  {
+    ApplicationContainer apps = client.Install(c.Get(i));
+    apps.Start(Seconds(startTimeRNG->GetValue(0.0, startSpread)));
+    Simulator::ScheduleWithContext(c.Get(i)->GetId(), warmup, &ResetStats<App>, c.Get(i)->GetApplication(0)->GetObject<App>());
+  }
+  outputs.kpi.SetInterval(Seconds(scenario.GetDouble("output.kpiInterval", 10.0)));
+  outputs.kpi.Install(c);
+  // After the ResetStats of the applications
+  Simulator::Schedule(warmup, &FloodingKpiSampler::Start, &outputs.kpi);
+  if (outputs.courses)
+  {
+    outputs.course.Install(c);
+  }
+  if (outputs.receptionRatios)
+  {
+    // Potential receivers from a grid rebuilt every second, widened by the top speed
+    double speedMax = scenario.GetDouble("mobility.speedMax", -1.0);
+    if (speedMax > 0)
+    {
+      outputs.receptionRatio.SetGridUpdateInterval(Seconds(1));
+      outputs.receptionRatio.SetMaxSpeed(speedMax);
+    }
+    outputs.receptionRatio.Install(c);
+    Simulator::Schedule(warmup, &ReceptionRatioHelper::ResetStats, &outputs.receptionRatio);
+  }
+  client.AssignStreams(c, 0);
+
+  if (outputs.tracing)
+  {
+    connectTraces(App::GetTypeId().GetName(), outputs);
+  }
+
+  Time simTime = Seconds(scenario.GetDouble("scenario.simTime", 180));
+  vector<string> variants = scenario.GetVariants();
+  string variantName;
+  Scenario variant;
+  const Scenario *current = &scenario;
+  if (!variants.empty())
+  {
+    // Shared warm-up, up to the branch time
+    Simulator::Stop(Seconds(scenario.GetDouble("scenario.branchTime", 0.0)));
+    Simulator::Run();
+    variantName = ForkVariants(variants, outputs);
+    if (variantName.empty())
+    {
+      return;
+    }
+
+    variant = scenario.GetVariant(variantName);
+    current = &variant;
+    // Outputs not renamed by the variant get its name as a suffix
+    for (string key : {"output.trace", "output.course", "output.kpi", "output.aoi", "output.receptionRatio"})
+    {
+      string file = variant.GetString(key);
+      if (!file.empty() && file == scenario.GetString(key))
+      {
+        size_t dot = file.find_last_of('.');
+        size_t slash = file.find_last_of('/');
+        if (dot == string::npos || (slash != string::npos && dot < slash))
+        {
+          dot = file.size();
+        }
+        variant.Set(key, file.substr(0, dot) + "_" + variantName + file.substr(dot));
+      }
+    }
+    string path = "/NodeList/*/ApplicationList/0/$" + App::GetTypeId().GetName() + "/";
+    for (const auto &attribute : variant.GetSection("attributes"))
+    {
+      Config::Set(path + attribute.first, StringValue(attribute.second));
+    }
+    if (!variant.GetString("output.kpi").empty())
+    {
+      outputs.kpi.Open(variant.GetString("output.kpi"));
+    }
+    if (outputs.tracing)
+    {
+      outputs.trace.SetFile(variant.GetString("output.trace"));
+    }
+    if (outputs.courses)
+    {
+      outputs.course.Open(variant.GetString("output.course"));
+    }
+    if (outputs.receptionRatios)
+    {
+      outputs.receptionRatio.EnablePerPacketOutput(variant.GetString("output.receptionRatio"));
+    }
+    NS_LOG_UNCOND("Variant " << variantName << " from " << Simulator::Now().As(Time::S));
+  }
+
+  Simulator::Stop(simTime - Simulator::Now());
+  Simulator::Run();
+
+  outputs.kpi.Finish();
+  NS_LOG_UNCOND(Simulator::Now().As(Time::S) << " P_D = " << outputs.kpi.GetDeliveryProbability()
+                << ", P_EX = " << outputs.kpi.GetExcessProbability());
+  if (outputs.receptionRatios)
+  {
+    outputs.receptionRatio.Finish();
+    NS_LOG_UNCOND(Simulator::Now().As(Time::S) << " reception ratio = " << outputs.receptionRatio.GetReceptionRatio()
+                  << " (" << outputs.receptionRatio.GetReceivers() << " / " << outputs.receptionRatio.GetPotentialReceivers()
+                  << "), mean per update = " << outputs.receptionRatio.GetMeanPacketReceptionRatio());
+  }
+  string aoiFile = current->GetString("output.aoi");
+  if (!aoiFile.empty())
+  {
+    WriteAoiHistogram<App>(aoiFile, c);
+  }
+
+  if (!variantName.empty())
+  {
+    // The child is done, without running the destructors of the parent
+    outputs.Flush();
+    cout.flush();
+    clog.flush();
+    _exit(0);
+  }
+}
+
+void RunScenario(const Scenario &scenario)
+{
+  string protocol = scenario.GetString("protocol.name", "rdf");
+  uint32_t seed = scenario.GetInt("scenario.seed", 0);
+  Time interval = Seconds(scenario.GetDouble("protocol.interval", 1.0));
+  uint32_t packetSize = scenario.GetInt("protocol.packetSize", 100);
+  double decayFactor = scenario.GetDouble("protocol.decayFactor", 1.0);
+
+  RunOutputs outputs;
+  if (!scenario.GetString("output.kpi").empty())
+  {
+    outputs.kpi.Open(scenario.GetString("output.kpi"));
+  }
+  if (!scenario.GetString("output.trace").empty())
+  {
+    // fork() does not copy the flush thread
+    outputs.trace.SetFile(scenario.GetString("output.trace"), scenario.GetVariants().empty());
+    outputs.tracing = true;
+  }
+  if (!scenario.GetString("output.course").empty())
+  {
+    outputs.course.Open(scenario.GetString("output.course"));
+    outputs.courses = true;
+  }
+  if (!scenario.GetString("output.receptionRatio").empty())
+  {
+    outputs.receptionRatio.EnablePerPacketOutput(scenario.GetString("output.receptionRatio"));
+    outputs.receptionRatios = true;
+  }
+
+  // Same random numbers as a run in its own process
+  RngSeedManager::ResetNextStreamIndex();
+  SeedManager::SetSeed(seed + 10);
+  // The addresses of the previous run are still marked as allocated
+  Ipv4AddressGenerator::Reset();
+
+  NodeContainer c = CreateNodes(scenario);
+
+  if (protocol == "pf" || protocol == "sf")
+  {
+    // Pure flooding is stochastic flooding forwarding every update, with a
+    // jitter of a whole send interval
+    double forwardingProbability = protocol == "pf" ? 1.0 : scenario.GetDouble("protocol.forwardingProbability", 1.0);
+    Time jitter = protocol == "pf" ? interval : Seconds(0.01);
+    PureFloodingAppHelper client(3000, interval, jitter, packetSize, forwardingProbability);
+    RunFlooding<PureFloodingApp>(scenario, client, c, outputs, &ConnectPlainTraces<PureFloodingHeader>);
+  }
+  else if (protocol == "cbf")
+  {
+    ContentionBasedFloodingAppHelper client(3000, interval, Seconds(0.1), packetSize, 509.003);
+    RunFlooding<ContentionBasedFloodingApp>(scenario, client, c, outputs, &ConnectPlainTraces<ContentionBasedFloodingHeader>);
+  }
+  else if (protocol == "rdf" || protocol == "nc-rdf")
+  {
+    double minGain = 0.0;
+    double lossRate = 0.0;
+    if (protocol == "nc-rdf")
+    {
+      minGain = scenario.GetDouble("protocol.minGain", 0.0);
+      lossRate = scenario.GetDouble("protocol.lossRate", 0.0);
+      if (minGain >= 10.0)
+      {
+        // if there is no encoding, reduce packet size to compensate for unnecessary headers
+        packetSize = packetSize - 8; // only the second src is to be counted, the rest is xored anyway
+      }
+    }
+    RateDecayFloodingAppHelper client(3000, interval, Seconds(0.01), packetSize, 509.003, decayFactor, minGain, lossRate);
+    RunFlooding<RateDecayFloodingApp>(scenario, client, c, outputs, &ConnectRdfTraces);
+  }
+  else
+  {
+    NS_FATAL_ERROR("Unknown protocol " << protocol << ", expected pf, sf, cbf, rdf or nc-rdf");
+  }
+
+  Simulator::Destroy();
+}
+
+int main(int argc, char *argv[])
+{
+  string scenarioFile;
+  string manifestFile;
+  uint32_t numThreads = 1;
+
+  CommandLine cmd(__FILE__);
+  cmd.AddValue("scenario", "scenario file to run", scenarioFile);
+  cmd.AddValue("manifest", "file listing one run per line: a scenario file, then section.key=value overrides", manifestFile);
+  cmd.AddValue("threads", "number of manifest runs simulated concurrently", numThreads);
+  cmd.Parse(argc, argv);
+
+  if (scenarioFile.empty() && manifestFile.empty())
+  {
+    NS_FATAL_ERROR("Give a --scenario or a --manifest");
+  }
+  if (numThreads > 1)
+  {
+    NS_FATAL_ERROR("--threads > 1 is not supported yet, the runs are not thread safe");
+  }
+
+  if (!scenarioFile.empty())
+  {
+    Scenario scenario;
+    scenario.Load(scenarioFile);
+    NS_LOG_UNCOND("START " << scenarioFile);
+    RunScenario(scenario);
+    NS_LOG_UNCOND("END");
+  }
+
+  if (!manifestFile.empty())
+  {
+    ifstream manifest(manifestFile);
+    if (!manifest)
+    {
+      NS_FATAL_ERROR("Cannot read manifest " << manifestFile);
+    }
+    vector<string> runs;
+    string line;
+    while (getline(manifest, line))
+    {
+      istringstream tokens(line);
+      string file;
+      if ((tokens >> file) && file[0] != '#')
+      {
+        runs.push_back(line);
+      }
+    }
+
+    // Every thread takes the next run of the manifest until none is left
+    atomic<size_t> nextRun(0);
+    auto worker = [&runs, &nextRun]() {
+      for (size_t run = nextRun++; run < runs.size(); run = nextRun++)
+      {
+        istringstream tokens(runs[run]);
+        string file;
+        tokens >> file;
+        Scenario scenario;
+        scenario.Load(file);
+        string assignment;
+        while (tokens >> assignment)
+        {
+          scenario.Override(assignment);
+        }
+        NS_LOG_UNCOND("START " << run << ": " << runs[run]);
+        RunScenario(scenario);
+        NS_LOG_UNCOND("END " << run);
+      }
+    };
+    g_threaded = numThreads > 1;
+    if (numThreads <= 1)
+    {
+      worker();
+    }
+    else
+    {
+      vector<thread> threads;
+      for (uint32_t i = 0; i < numThreads; i++)
+      {
+        threads.emplace_back(worker);
+      }
+      for (thread &t : threads)
+      {
+        t.join();
+      }
+    }
+  }
+
+  return 0;
+}
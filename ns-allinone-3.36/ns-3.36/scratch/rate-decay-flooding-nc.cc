@@ -18,12 +18,13 @@
 #include "ns3/application-container.h"
 #include "ns3/pure-flooding-application.h"
 #include "ns3/flooding-helper.h"
+#include "ns3/aoi-histogram.h"
 #include "ns3/contention-based-flooding-header.h"
 #include "ns3/rate-decay-flooding-nc-header.h"
 #include "ns3/rate-decay-flooding-application.h"
-#include "CsvLogger.h"
-#include "KpiLogger.h"
-#include "ForwardingOptionsLogger.h"
+#include "ns3/trajectory-recorder.h"
+#include "ns3/flooding-kpi-sampler.h"
+#include "EventLog.h"
 #include <vector>
 
 using namespace ns3;
@@ -32,16 +33,11 @@ using namespace std::string_literals;
 
 NS_LOG_COMPONENT_DEFINE("RDF");
 
-CsvLogger resLogger = CsvLogger();
-CsvLogger courseLogger = CsvLogger();
-ForwardingOptionsLogger forwardingOptionsLogger = ForwardingOptionsLogger();
-KpiLogger kpiLogger = KpiLogger();
-
-void CourseChange(Ptr<const MobilityModel> mobility, uint32_t nodeId)
-{
-  courseLogger.CreateCourse(nodeId, mobility);
-  Simulator::Schedule(Seconds(0.1), &CourseChange, mobility, nodeId);
-}
+PacketEventLog resLogger;
+TrajectoryRecorder courseRecorder;
+ForwardingOptionsEventLog forwardingOptionsLogger;
+FloodingKpiSampler kpiSampler;
+std::string aoiFile;
 
 void OnPacketReceive(std::string context, Ptr<const Packet> pkt, uint32_t nodeId)
 {
@@ -56,11 +52,9 @@ void OnPacketReceive(std::string context, Ptr<const Packet> pkt, uint32_t nodeId
   uint32_t lastHop = header.GetLastHop();
   uint32_t numHops = header.GetNumHops();
 
-  string seqNo = to_string(src) + "-" + to_string(header.GetSeq());
+  uint32_t seq = header.GetSeq();
 
-  string type = "PktRcvd";
-  resLogger.CreateEntry(nodeId, seqNo, type, to_string(src), to_string(lastHop), to_string(delay), to_string(numHops));
-  // uint32_t node_id, string eventType, string src, string lastHop, string delay, string numHops
+  resLogger.CreateEntry(nodeId, src, seq, PacketEvent::RCVD, lastHop, delay, numHops);
 }
 
 void OnPacketSent(std::string context, Ptr<const Packet> pkt, uint32_t nodeId, double pL = -1.0)
@@ -72,10 +66,9 @@ void OnPacketSent(std::string context, Ptr<const Packet> pkt, uint32_t nodeId, d
   uint32_t lastHop = header.GetLastHop();
   uint32_t numHops = header.GetNumHopsLeft();
 
-  string seqNo = to_string(src) + "-" + to_string(header.GetSeqLeft());
+  uint32_t seq = header.GetSeqLeft();
 
-  string type = "PktSent";
-  resLogger.CreateEntry(nodeId, seqNo, type, to_string(src), to_string(lastHop), "-1", to_string(numHops), to_string(pL));
+  resLogger.CreateEntry(nodeId, src, seq, PacketEvent::SENT, lastHop, -1, numHops, pL);
 }
 
 void OnPacketForward(std::string context, Ptr<const Packet> pkt, uint32_t nodeId, vector<Ptr<Packet>> forwardingBuffer, Vector nodePos, double pL = -1.0)
@@ -91,16 +84,15 @@ void OnPacketForward(std::string context, Ptr<const Packet> pkt, uint32_t nodeId
   uint32_t lastHop = header.GetLastHop();
   uint32_t numHops = header.GetNumHops();
 
-  string seqNo = to_string(src) + "-" + to_string(header.GetSeq());
+  uint32_t seq = header.GetSeq();
 
-  string type = "PktFwd";
-  resLogger.CreateEntry(nodeId, seqNo, type, to_string(src), to_string(lastHop), to_string(delay), to_string(numHops), to_string(pL));
+  resLogger.CreateEntry(nodeId, src, seq, PacketEvent::FWD, lastHop, delay, numHops, pL);
   
   for (auto it = forwardingBuffer.begin(); it != forwardingBuffer.end(); it++) {
     auto optionPkt = *it;
     ContentionBasedFloodingHeader optionHeader;
     optionPkt->PeekHeader(optionHeader);
-    forwardingOptionsLogger.CreateEntry(seqNo, nodeId, nodePos, header.GetLastHop(), header.GetLastPos(), optionHeader.GetLastHop(),optionHeader.GetLastPos());
+    forwardingOptionsLogger.CreateEntry(src, seq, nodeId, nodePos, header.GetLastHop(), header.GetLastPos(), optionHeader.GetLastHop(),optionHeader.GetLastPos());
   }
 }
 
@@ -110,34 +102,11 @@ void LogProgress()
   Simulator::Schedule(Seconds(5), &LogProgress);
 }
 
-void GetKPIs(NodeContainer c, int numNodes)
+void GetKPIs()
 {
-
-  double sumNodesSeen = 0;
-  double sumInTime = 0;
-  double sumLate = 0;
-
-  double sumSent = 0;
-  double sumRcvd = 0;
-  double sumFwd = 0;
-  double sumSentCoded = 0;
-  for (int i = 0; i < numNodes; i++)
-  {
-    auto rdfApp = c.Get(i)->GetApplication(0)->GetObject<RateDecayFloodingApp>();
-    sumNodesSeen += rdfApp->GetNumSeenNodes();
-    sumInTime += rdfApp->GetNumUpdatesReceivedInTime();
-    sumLate += rdfApp->GetNumUpdatesReceivedLate();
-
-    sumSent += rdfApp->GetNumSent();
-    sumSentCoded += rdfApp->GetNumSentCoded();
-    sumRcvd += rdfApp->GetNumRcvd();
-    sumFwd += rdfApp->GetNumFwd();
-  }
-
-  double pd = sumNodesSeen / (numNodes * (numNodes - 1));
-  double pe500 = sumLate / (sumInTime + sumLate);
-  kpiLogger.CreateEntry(pd, pe500, sumSent, sumRcvd, sumFwd, sumSentCoded);
-  NS_LOG_UNCOND(Simulator::Now().As(Time::S) << " P_D = " << pd << ", P_EX = " << pe500);
+  // Last window, the previous ones are already in the file
+  kpiSampler.Finish();
+  NS_LOG_UNCOND(Simulator::Now().As(Time::S) << " P_D = " << kpiSampler.GetDeliveryProbability() << ", P_EX = " << kpiSampler.GetExcessProbability());
 }
 
 void ResetStats(Ptr<RateDecayFloodingApp> app)
@@ -161,6 +130,7 @@ int main(int argc, char *argv[])
   double speedMax = -1.0;
   double lossRate = 0.0;
   bool tracing = false;
+  double kpiInterval = 10; // seconds
 
   CommandLine cmd(__FILE__);
   cmd.AddValue("packetSize", "size of application packet sent", packetSize);
@@ -175,16 +145,18 @@ int main(int argc, char *argv[])
   cmd.AddValue("speedMax", "speedMax", speedMax);
   cmd.AddValue("speedMin", "speedMin", speedMin);
   cmd.AddValue("tracing", "tracing", tracing);
+  cmd.AddValue("kpiInterval", "interval (seconds) between the KPI samples", kpiInterval);
   cmd.AddValue("lossRate", "lossRate", lossRate);
   cmd.Parse(argc, argv);
 
-  kpiLogger.SetFile("res/v" + to_string(version) + "/kpi_rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_mg" + to_string(int(minGain * 100)) + "_pL" + to_string(int(lossRate * 100)) + "_r" + to_string(seed) + ".csv");
+  kpiSampler.Open("res/v" + to_string(version) + "/kpi_rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_mg" + to_string(int(minGain * 100)) + "_pL" + to_string(int(lossRate * 100)) + "_r" + to_string(seed) + ".csv");
+  aoiFile = "res/v" + to_string(version) + "/aoi_rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_mg" + to_string(int(minGain * 100)) + "_pL" + to_string(int(lossRate * 100)) + "_r" + to_string(seed) + ".csv";
 
   if (tracing)
   {
-    resLogger.SetFile("res/v" + to_string(version) + "/rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_mg" + to_string(int(minGain * 100)) + "_pL" + to_string(int(lossRate * 100)) + "_r" + to_string(seed) + ".csv");
-    courseLogger.SetFile("res/v" + to_string(version) + "/course_rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_mg" + to_string(int(minGain * 100)) + "_pL" + to_string(int(lossRate * 100)) + "_r" + to_string(seed) + ".csv");
-    forwardingOptionsLogger.SetFile("res/v" + to_string(version) + "/fwd_options_rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_mg" + to_string(int(minGain * 100)) + "_pL" + to_string(int(lossRate * 100)) + "_r" + to_string(seed) + ".csv");
+    resLogger.SetFile("res/v" + to_string(version) + "/rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_mg" + to_string(int(minGain * 100)) + "_pL" + to_string(int(lossRate * 100)) + "_r" + to_string(seed) + ".evlog", true);
+    courseRecorder.Open("res/v" + to_string(version) + "/course_rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_mg" + to_string(int(minGain * 100)) + "_pL" + to_string(int(lossRate * 100)) + "_r" + to_string(seed) + ".evlog");
+    forwardingOptionsLogger.SetFile("res/v" + to_string(version) + "/fwd_options_rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_mg" + to_string(int(minGain * 100)) + "_pL" + to_string(int(lossRate * 100)) + "_r" + to_string(seed) + ".evlog", true);
   }
   ns3::SeedManager::SetSeed(seed + 10);
 
@@ -263,13 +235,16 @@ int main(int argc, char *argv[])
     ApplicationContainer apps = client.Install(c.Get(i));
     apps.Start(Seconds(startTimeRNG->GetValue(0.0, 5.0))); //
     Simulator::ScheduleWithContext(c.Get(i)->GetId(), Seconds(5.0), &ResetStats, c.Get(i)->GetApplication(0)->GetObject<RateDecayFloodingApp>());
-    if(tracing){
-      Simulator::ScheduleWithContext(c.Get(i)->GetId(), Seconds(0), &CourseChange, c.Get(i)->GetObject<MobilityModel>(), c.Get(i)->GetId());
-    }
   }
 
+  kpiSampler.SetInterval(Seconds(kpiInterval));
+  kpiSampler.Install(c);
+  // After the ResetStats of the applications
+  Simulator::Schedule(Seconds(5.0), &FloodingKpiSampler::Start, &kpiSampler);
+
   if (tracing)
   {
+    courseRecorder.Install(c);
     Config::Connect("/NodeList/*/ApplicationList/0/$ns3::RateDecayFloodingApp/Rx", MakeCallback(&OnPacketReceive));
     Config::Connect("/NodeList/*/ApplicationList/0/$ns3::RateDecayFloodingApp/Tx", MakeCallback(&OnPacketSent));
     Config::Connect("/NodeList/*/ApplicationList/0/$ns3::RateDecayFloodingApp/Fwd", MakeCallback(&OnPacketForward));
@@ -277,8 +252,10 @@ int main(int argc, char *argv[])
 
   Simulator::Stop(Seconds(simTime));
   Simulator::Run();
+  courseRecorder.Close();
 
-  GetKPIs(c, numNodes);
+  GetKPIs();
+  WriteAoiHistogram<RateDecayFloodingApp>(aoiFile, c);
 
   Simulator::Destroy();
   NS_LOG_UNCOND("END");
@@ -18,10 +18,12 @@
 #include "ns3/application-container.h"
 #include "ns3/pure-flooding-application.h"
 #include "ns3/flooding-helper.h"
+#include "ns3/aoi-histogram.h"
 #include "ns3/contention-based-flooding-header.h"
 #include "ns3/rate-decay-flooding-application.h"
-#include "CsvLogger.h"
-#include "KpiLogger.h"
+#include "ns3/trajectory-recorder.h"
+#include "ns3/flooding-kpi-sampler.h"
+#include "EventLog.h"
 
 using namespace ns3;
 using namespace std;
@@ -29,15 +31,10 @@ using namespace std::string_literals;
 
 NS_LOG_COMPONENT_DEFINE("RDF");
 
-CsvLogger resLogger = CsvLogger();
-CsvLogger courseLogger = CsvLogger();
-KpiLogger kpiLogger = KpiLogger();
-
-void CourseChange(Ptr<const MobilityModel> mobility, uint32_t nodeId)
-{
-  courseLogger.CreateCourse(nodeId, mobility);
-  Simulator::Schedule(Seconds(0.1), &CourseChange, mobility, nodeId);
-}
+PacketEventLog resLogger;
+TrajectoryRecorder courseRecorder;
+FloodingKpiSampler kpiSampler;
+std::string aoiFile;
 
 void OnPacketReceive(std::string context, Ptr<const Packet> pkt, uint32_t nodeId)
 {
@@ -52,11 +49,9 @@ void OnPacketReceive(std::string context, Ptr<const Packet> pkt, uint32_t nodeId
   uint32_t lastHop = header.GetLastHop();
   uint32_t numHops = header.GetNumHops();
 
-  string seqNo = to_string(src) + "-" + to_string(header.GetSeq());
+  uint32_t seq = header.GetSeq();
 
-  string type = "PktRcvd";
-  resLogger.CreateEntry(nodeId, seqNo, type, to_string(src), to_string(lastHop), to_string(delay), to_string(numHops));
-  // uint32_t node_id, string eventType, string src, string lastHop, string delay, string numHops
+  resLogger.CreateEntry(nodeId, src, seq, PacketEvent::RCVD, lastHop, delay, numHops);
 }
 
 void OnPacketSent(std::string context, Ptr<const Packet> pkt, uint32_t nodeId)
@@ -68,10 +63,9 @@ void OnPacketSent(std::string context, Ptr<const Packet> pkt, uint32_t nodeId)
   uint32_t lastHop = header.GetLastHop();
   uint32_t numHops = header.GetNumHops();
 
-  string seqNo = to_string(src) + "-" + to_string(header.GetSeq());
+  uint32_t seq = header.GetSeq();
 
-  string type = "PktSent";
-  resLogger.CreateEntry(nodeId, seqNo, type, to_string(src), to_string(lastHop), "-1", to_string(numHops));
+  resLogger.CreateEntry(nodeId, src, seq, PacketEvent::SENT, lastHop, -1, numHops);
 }
 
 void OnPacketForward(std::string context, Ptr<const Packet> pkt, uint32_t nodeId, vector<Ptr<Packet>> forwardingBuffer)
@@ -87,10 +81,9 @@ void OnPacketForward(std::string context, Ptr<const Packet> pkt, uint32_t nodeId
   uint32_t lastHop = header.GetLastHop();
   uint32_t numHops = header.GetNumHops();
 
-  string seqNo = to_string(src) + "-" + to_string(header.GetSeq());
+  uint32_t seq = header.GetSeq();
 
-  string type = "PktFwd";
-  resLogger.CreateEntry(nodeId, seqNo, type, to_string(src), to_string(lastHop), to_string(delay), to_string(numHops));
+  resLogger.CreateEntry(nodeId, src, seq, PacketEvent::FWD, lastHop, delay, numHops);
 }
 
 void LogProgress()
@@ -99,32 +92,11 @@ void LogProgress()
   Simulator::Schedule(Seconds(5), &LogProgress);
 }
 
-void GetKPIs(NodeContainer c, int numNodes)
+void GetKPIs()
 {
-
-  double sumNodesSeen = 0;
-  double sumInTime = 0;
-  double sumLate = 0;
-
-  double sumSent = 0;
-  double sumRcvd = 0;
-  double sumFwd = 0;
-  for (int i = 0; i < numNodes; i++)
-  {
-    auto rdfApp = c.Get(i)->GetApplication(0)->GetObject<RateDecayFloodingApp>();
-    sumNodesSeen += rdfApp->GetNumSeenNodes();
-    sumInTime += rdfApp->GetNumUpdatesReceivedInTime();
-    sumLate += rdfApp->GetNumUpdatesReceivedLate();
-
-    sumSent += rdfApp->GetNumSent();
-    sumRcvd += rdfApp->GetNumRcvd();
-    sumFwd += rdfApp->GetNumFwd();
-  }
-
-  double pd = sumNodesSeen / (numNodes * (numNodes - 1));
-  double pe500 = sumLate / (sumInTime + sumLate);
-  kpiLogger.CreateEntry(pd, pe500, sumSent, sumRcvd, sumFwd);
-  NS_LOG_UNCOND(Simulator::Now().As(Time::S) << " P_D = " << pd << ", P_EX = " << pe500);
+  // Last window, the previous ones are already in the file
+  kpiSampler.Finish();
+  NS_LOG_UNCOND(Simulator::Now().As(Time::S) << " P_D = " << kpiSampler.GetDeliveryProbability() << ", P_EX = " << kpiSampler.GetExcessProbability());
 }
 
 void ResetStats(Ptr<RateDecayFloodingApp> app)
@@ -146,6 +118,9 @@ int main(int argc, char *argv[])
   double speedMin = -1.0;
   double speedMax = -1.0;
   bool tracing = false;
+  double kpiInterval = 10; // seconds
+  double aggregationWindow = 0; // seconds
+  bool packetSocket = false;
 
   CommandLine cmd(__FILE__);
   cmd.AddValue("packetSize", "size of application packet sent", packetSize);
@@ -159,14 +134,18 @@ int main(int argc, char *argv[])
   cmd.AddValue("speedMax", "speedMax", speedMax);
   cmd.AddValue("speedMin", "speedMin", speedMin);
   cmd.AddValue("tracing", "tracing", tracing);
+  cmd.AddValue("kpiInterval", "interval (seconds) between the KPI samples", kpiInterval);
+  cmd.AddValue("aggregationWindow", "pending updates due within this time (seconds) are sent in one frame", aggregationWindow);
+  cmd.AddValue("packetSocket", "send the frames on the link layer rather than over UDP/IPv4", packetSocket);
   cmd.Parse(argc, argv);
 
-  kpiLogger.SetFile("res/v" + to_string(version) + "/kpi_rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_r" + to_string(seed) + ".csv");
+  kpiSampler.Open("res/v" + to_string(version) + "/kpi_rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_r" + to_string(seed) + ".csv");
+  aoiFile = "res/v" + to_string(version) + "/aoi_rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_r" + to_string(seed) + ".csv";
 
   if (tracing)
   {
-    resLogger.SetFile("res/v" + to_string(version) + "/rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_r" + to_string(seed) + ".csv");
-    courseLogger.SetFile("res/v" + to_string(version) + "/course_rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_r" + to_string(seed) + ".csv");
+    resLogger.SetFile("res/v" + to_string(version) + "/rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_r" + to_string(seed) + ".evlog", true);
+    courseRecorder.Open("res/v" + to_string(version) + "/course_rdf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_q" + to_string(int(decayFactor * 100)) + "_r" + to_string(seed) + ".evlog");
   }
   ns3::SeedManager::SetSeed(seed + 10);
 
@@ -232,6 +211,8 @@ int main(int argc, char *argv[])
   Ipv4InterfaceContainer i = ipv4.Assign(devices);
 
   RateDecayFloodingAppHelper client(3000, interPacketInterval, Seconds(0.01), packetSize, 509.003, decayFactor);
+  client.SetAttribute("AggregationWindow", TimeValue(Seconds(aggregationWindow)));
+  client.SetTransport(packetSocket ? PACKET_TRANSPORT : UDP_TRANSPORT);
 
   Ptr<UniformRandomVariable> startTimeRNG = CreateObject<UniformRandomVariable>();
 
@@ -240,13 +221,16 @@ int main(int argc, char *argv[])
     ApplicationContainer apps = client.Install(c.Get(i));
     apps.Start(Seconds(startTimeRNG->GetValue(0.0, 5.0))); //
     Simulator::ScheduleWithContext(c.Get(i)->GetId(), Seconds(5.0), &ResetStats, c.Get(i)->GetApplication(0)->GetObject<RateDecayFloodingApp>());
-    if(tracing){
-      Simulator::ScheduleWithContext(c.Get(i)->GetId(), Seconds(0), &CourseChange, c.Get(i)->GetObject<MobilityModel>(), c.Get(i)->GetId());
-    }
   }
 
+  kpiSampler.SetInterval(Seconds(kpiInterval));
+  kpiSampler.Install(c);
+  // After the ResetStats of the applications
+  Simulator::Schedule(Seconds(5.0), &FloodingKpiSampler::Start, &kpiSampler);
+
   if (tracing)
   {
+    courseRecorder.Install(c);
     Config::Connect("/NodeList/*/ApplicationList/0/$ns3::RateDecayFloodingApp/Rx", MakeCallback(&OnPacketReceive));
     Config::Connect("/NodeList/*/ApplicationList/0/$ns3::RateDecayFloodingApp/Tx", MakeCallback(&OnPacketSent));
     Config::Connect("/NodeList/*/ApplicationList/0/$ns3::RateDecayFloodingApp/Fwd", MakeCallback(&OnPacketForward));
@@ -254,8 +238,10 @@ int main(int argc, char *argv[])
 
   Simulator::Stop(Seconds(simTime));
   Simulator::Run();
+  courseRecorder.Close();
 
-  GetKPIs(c, numNodes);
+  GetKPIs();
+  WriteAoiHistogram<RateDecayFloodingApp>(aoiFile, c);
 
   Simulator::Destroy();
   NS_LOG_UNCOND("END");
@@ -18,9 +18,11 @@
 #include "ns3/application-container.h"
 #include "ns3/pure-flooding-application.h"
 #include "ns3/flooding-helper.h"
+#include "ns3/aoi-histogram.h"
 #include "ns3/pure-flooding-header.h"
-#include "CsvLogger.h"
-#include "KpiLogger.h"
+#include "ns3/trajectory-recorder.h"
+#include "ns3/flooding-kpi-sampler.h"
+#include "EventLog.h"
 
 using namespace ns3;
 using namespace std;
@@ -28,15 +30,10 @@ using namespace std::string_literals;
 
 NS_LOG_COMPONENT_DEFINE("SF");
 
-CsvLogger resLogger = CsvLogger();
-CsvLogger courseLogger = CsvLogger();
-KpiLogger kpiLogger = KpiLogger();
-
-void CourseChange(Ptr<const MobilityModel> mobility, uint32_t nodeId)
-{
-  courseLogger.CreateCourse(nodeId, mobility);
-  Simulator::Schedule(Seconds(0.1), &CourseChange, mobility, nodeId);
-}
+PacketEventLog resLogger;
+TrajectoryRecorder courseRecorder;
+FloodingKpiSampler kpiSampler;
+std::string aoiFile;
 
 void OnPacketReceive(std::string context, Ptr<const Packet> pkt, uint32_t nodeId)
 {
@@ -51,11 +48,9 @@ void OnPacketReceive(std::string context, Ptr<const Packet> pkt, uint32_t nodeId
   uint32_t lastHop = header.GetLastHop();
   uint32_t numHops = header.GetNumHops();
 
-  string seqNo = to_string(src) + "-" + to_string(header.GetSeq());
+  uint32_t seq = header.GetSeq();
 
-  string type = "PktRcvd";
-  resLogger.CreateEntry(nodeId, seqNo, type, to_string(src), to_string(lastHop), to_string(delay), to_string(numHops));
-  // uint32_t node_id, string eventType, string src, string lastHop, string delay, string numHops
+  resLogger.CreateEntry(nodeId, src, seq, PacketEvent::RCVD, lastHop, delay, numHops);
 }
 
 void OnPacketSent(std::string context, Ptr<const Packet> pkt, uint32_t nodeId)
@@ -67,10 +62,9 @@ void OnPacketSent(std::string context, Ptr<const Packet> pkt, uint32_t nodeId)
   uint32_t lastHop = header.GetLastHop();
   uint32_t numHops = header.GetNumHops();
 
-  string seqNo = to_string(src) + "-" + to_string(header.GetSeq());
+  uint32_t seq = header.GetSeq();
 
-  string type = "PktSent";
-  resLogger.CreateEntry(nodeId, seqNo, type, to_string(src), to_string(lastHop), "-1", to_string(numHops));
+  resLogger.CreateEntry(nodeId, src, seq, PacketEvent::SENT, lastHop, -1, numHops);
 }
 
 void OnPacketForward(std::string context, Ptr<const Packet> pkt, uint32_t nodeId)
@@ -86,10 +80,9 @@ void OnPacketForward(std::string context, Ptr<const Packet> pkt, uint32_t nodeId
   uint32_t lastHop = header.GetLastHop();
   uint32_t numHops = header.GetNumHops();
 
-  string seqNo = to_string(src) + "-" + to_string(header.GetSeq());
+  uint32_t seq = header.GetSeq();
 
-  string type = "PktFwd";
-  resLogger.CreateEntry(nodeId, seqNo, type, to_string(src), to_string(lastHop), to_string(delay), to_string(numHops));
+  resLogger.CreateEntry(nodeId, src, seq, PacketEvent::FWD, lastHop, delay, numHops);
 }
 
 void LogProgress()
@@ -98,32 +91,11 @@ void LogProgress()
   Simulator::Schedule(Seconds(5), &LogProgress);
 }
 
-void GetKPIs(NodeContainer c, int numNodes)
+void GetKPIs()
 {
-
-    double sumNodesSeen = 0;
-    double sumInTime = 0;
-    double sumLate = 0;
-
-    double sumSent = 0;
-    double sumRcvd = 0;
-    double sumFwd = 0;
-    for (int i = 0; i < numNodes; i++)
-    {
-        auto rdfApp = c.Get(i)->GetApplication(0)->GetObject<PureFloodingApp>();
-        sumNodesSeen += rdfApp->GetNumSeenNodes();
-        sumInTime += rdfApp->GetNumUpdatesReceivedInTime();
-        sumLate += rdfApp->GetNumUpdatesReceivedLate();
-
-        sumSent += rdfApp->GetNumSent();
-        sumRcvd += rdfApp->GetNumRcvd();
-        sumFwd += rdfApp->GetNumFwd();
-    }
-
-    double pd = sumNodesSeen / (numNodes * (numNodes - 1));
-    double pe500 = sumLate / (sumInTime + sumLate);
-    kpiLogger.CreateEntry(pd, pe500, sumSent, sumRcvd, sumFwd);
-    NS_LOG_UNCOND(Simulator::Now().As(Time::S) << " P_D = " << pd << ", P_EX = " << pe500);
+    // Last window, the previous ones are already in the file
+    kpiSampler.Finish();
+    NS_LOG_UNCOND(Simulator::Now().As(Time::S) << " P_D = " << kpiSampler.GetDeliveryProbability() << ", P_EX = " << kpiSampler.GetExcessProbability());
 }
 
 void ResetStats(Ptr<PureFloodingApp> app) {
@@ -144,6 +116,7 @@ int main(int argc, char *argv[])
     double speedMin = -1.0;
     double speedMax = -1.0;
   bool tracing = false;
+    double kpiInterval = 10; // seconds
 
     CommandLine cmd(__FILE__);
     cmd.AddValue("packetSize", "size of application packet sent", packetSize);
@@ -157,14 +130,16 @@ int main(int argc, char *argv[])
     cmd.AddValue("speedMax", "speedMax", speedMax);
     cmd.AddValue("speedMin", "speedMin", speedMin);
   cmd.AddValue("tracing", "tracing", tracing);
+    cmd.AddValue("kpiInterval", "interval (seconds) between the KPI samples", kpiInterval);
     cmd.Parse(argc, argv);
 
-    kpiLogger.SetFile("res/v" + to_string(version) + "/kpi_sf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_p" + to_string(int(forwardingProbability * 100)) + "_r" + to_string(seed) + ".csv");
+    kpiSampler.Open("res/v" + to_string(version) + "/kpi_sf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_p" + to_string(int(forwardingProbability * 100)) + "_r" + to_string(seed) + ".csv");
+    aoiFile = "res/v" + to_string(version) + "/aoi_sf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_p" + to_string(int(forwardingProbability * 100)) + "_r" + to_string(seed) + ".csv";
 
   if (tracing)
   {
-    resLogger.SetFile("res/v" + to_string(version) + "/sf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_p" + to_string(int(forwardingProbability * 100)) + "_r" + to_string(seed) + ".csv");
-    courseLogger.SetFile("res/v" + to_string(version) + "/course_sf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_p" + to_string(int(forwardingProbability * 100)) + "_r" + to_string(seed) + ".csv");
+    resLogger.SetFile("res/v" + to_string(version) + "/sf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_p" + to_string(int(forwardingProbability * 100)) + "_r" + to_string(seed) + ".evlog", true);
+    courseRecorder.Open("res/v" + to_string(version) + "/course_sf_n" + to_string(numNodes) + "_i" + to_string(int(interval * 1000)) + "_p" + to_string(int(forwardingProbability * 100)) + "_r" + to_string(seed) + ".evlog");
   }
 
     ns3::SeedManager::SetSeed(seed + 10);
@@ -238,13 +213,18 @@ int main(int argc, char *argv[])
         ApplicationContainer apps = client.Install(c.Get(i));
         apps.Start(Seconds(startTimeRNG->GetValue(0.0, 5.0))); 
         Simulator::ScheduleWithContext(c.Get(i)->GetId(), Seconds (5.0), &ResetStats, c.Get(i)->GetApplication(0)->GetObject<PureFloodingApp>());
-        if(tracing){
-      Simulator::ScheduleWithContext(c.Get(i)->GetId(), Seconds(0), &CourseChange, c.Get(i)->GetObject<MobilityModel>(), c.Get(i)->GetId());
-    }
     }
+    // Forwarding decisions independent of the other random variables
+    client.AssignStreams(c, 0);
+
+    kpiSampler.SetInterval(Seconds(kpiInterval));
+    kpiSampler.Install(c);
+    // After the ResetStats of the applications
+    Simulator::Schedule(Seconds(5.0), &FloodingKpiSampler::Start, &kpiSampler);
 
       if (tracing)
         {
+            courseRecorder.Install(c);
             Config::Connect("/NodeList/*/ApplicationList/0/$ns3::PureFloodingApp/Rx", MakeCallback(&OnPacketReceive));
             Config::Connect("/NodeList/*/ApplicationList/0/$ns3::PureFloodingApp/Tx", MakeCallback(&OnPacketSent));
             Config::Connect("/NodeList/*/ApplicationList/0/$ns3::PureFloodingApp/Fwd", MakeCallback(&OnPacketForward));
@@ -253,8 +233,10 @@ int main(int argc, char *argv[])
 
     Simulator::Stop(Seconds(simTime));
     Simulator::Run();
+    courseRecorder.Close();
 
-    GetKPIs(c, numNodes);
+    GetKPIs();
+    WriteAoiHistogram<PureFloodingApp>(aoiFile, c);
 
     Simulator::Destroy();
     NS_LOG_UNCOND("END");
@@ -22,6 +22,7 @@
 #include "ns3/contention-based-flooding-application.h"
 #include "ns3/rate-decay-flooding-application.h"
 #include "ns3/uinteger.h"
+#include "ns3/enum.h"
 #include "ns3/names.h"
 
 namespace ns3 {
@@ -45,6 +46,12 @@ PureFloodingAppHelper::SetAttribute (
   m_factory.Set (name, value);
 }
 
+void
+PureFloodingAppHelper::SetTransport (FloodingTransport transport)
+{
+  m_factory.Set ("Transport", EnumValue (transport));
+}
+
 ApplicationContainer
 PureFloodingAppHelper::Install (Ptr<Node> node) const
 {
@@ -79,6 +86,26 @@ PureFloodingAppHelper::InstallPriv (Ptr<Node> node) const
   return app;
 }
 
+int64_t
+PureFloodingAppHelper::AssignStreams (NodeContainer c, int64_t stream)
+{
+  int64_t currentStream = stream;
+  Ptr<Node> node;
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      node = (*i);
+      for (uint32_t j = 0; j < node->GetNApplications (); j++)
+        {
+          Ptr<PureFloodingApp> app = DynamicCast<PureFloodingApp> (node->GetApplication (j));
+          if (app)
+            {
+              currentStream += app->AssignStreams (currentStream);
+            }
+        }
+    }
+  return (currentStream - stream);
+}
+
 ContentionBasedFloodingAppHelper::ContentionBasedFloodingAppHelper (uint16_t port, Time sendInterval, Time forwardingJitter, uint32_t packetSize, double maxDistance)
 {
   m_factory.SetTypeId (ContentionBasedFloodingApp::GetTypeId ());
@@ -97,6 +124,12 @@ ContentionBasedFloodingAppHelper::SetAttribute (
   m_factory.Set (name, value);
 }
 
+void
+ContentionBasedFloodingAppHelper::SetTransport (FloodingTransport transport)
+{
+  m_factory.Set ("Transport", EnumValue (transport));
+}
+
 ApplicationContainer
 ContentionBasedFloodingAppHelper::Install (Ptr<Node> node) const
 {
@@ -131,6 +164,26 @@ ContentionBasedFloodingAppHelper::InstallPriv (Ptr<Node> node) const
   return app;
 }
 
+int64_t
+ContentionBasedFloodingAppHelper::AssignStreams (NodeContainer c, int64_t stream)
+{
+  int64_t currentStream = stream;
+  Ptr<Node> node;
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      node = (*i);
+      for (uint32_t j = 0; j < node->GetNApplications (); j++)
+        {
+          Ptr<ContentionBasedFloodingApp> app = DynamicCast<ContentionBasedFloodingApp> (node->GetApplication (j));
+          if (app)
+            {
+              currentStream += app->AssignStreams (currentStream);
+            }
+        }
+    }
+  return (currentStream - stream);
+}
+
 RateDecayFloodingAppHelper::RateDecayFloodingAppHelper (uint16_t port, Time sendInterval, Time forwardingJitter, uint32_t packetSize, double maxDistance, double decayFactor, double minGain, double lossRate)
 {
   m_factory.SetTypeId (RateDecayFloodingApp::GetTypeId ());
@@ -154,6 +207,12 @@ RateDecayFloodingAppHelper::SetAttribute (
   m_factory.Set (name, value);
 }
 
+void
+RateDecayFloodingAppHelper::SetTransport (FloodingTransport transport)
+{
+  m_factory.Set ("Transport", EnumValue (transport));
+}
+
 ApplicationContainer
 RateDecayFloodingAppHelper::Install (Ptr<Node> node) const
 {
@@ -188,4 +247,24 @@ RateDecayFloodingAppHelper::InstallPriv (Ptr<Node> node) const
   return app;
 }
 
+int64_t
+RateDecayFloodingAppHelper::AssignStreams (NodeContainer c, int64_t stream)
+{
+  int64_t currentStream = stream;
+  Ptr<Node> node;
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      node = (*i);
+      for (uint32_t j = 0; j < node->GetNApplications (); j++)
+        {
+          Ptr<RateDecayFloodingApp> app = DynamicCast<RateDecayFloodingApp> (node->GetApplication (j));
+          if (app)
+            {
+              currentStream += app->AssignStreams (currentStream);
+            }
+        }
+    }
+  return (currentStream - stream);
+}
+
 } // namespace ns3
@@ -26,6 +26,7 @@
 #include "ns3/object-factory.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv6-address.h"
+#include "ns3/flooding-app.h"
 
 namespace ns3 {
 
@@ -48,6 +49,14 @@ public:
    */
   void SetAttribute (std::string name, const AttributeValue &value);
 
+  /**
+   * Select how the applications send their frames, by setting their
+   * Transport attribute.
+   *
+   * \param transport UDP_TRANSPORT (the default) or PACKET_TRANSPORT
+   */
+  void SetTransport (FloodingTransport transport);
+
   /**
    * Create a UdpEchoServerApplication on the specified Node.
    *
@@ -81,6 +90,19 @@ public:
    */
   ApplicationContainer Install (NodeContainer c) const;
 
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by the PureFloodingApp applications installed on the nodes. Return the number
+   * of streams (possibly zero) that have been assigned. The Install() method
+   * should have previously been called by the user.
+   *
+   * \param c NodeContainer of the set of nodes for which the applications
+   *          should be modified to use a fixed stream
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this helper
+   */
+  int64_t AssignStreams (NodeContainer c, int64_t stream);
+
 private:
   /**
    * Install an ns3::UdpEchoServer on the node configured with all the
@@ -113,6 +135,14 @@ public:
    */
   void SetAttribute (std::string name, const AttributeValue &value);
 
+  /**
+   * Select how the applications send their frames, by setting their
+   * Transport attribute.
+   *
+   * \param transport UDP_TRANSPORT (the default) or PACKET_TRANSPORT
+   */
+  void SetTransport (FloodingTransport transport);
+
   /**
    * Create a UdpEchoServerApplication on the specified Node.
    *
@@ -146,6 +176,19 @@ public:
    */
   ApplicationContainer Install (NodeContainer c) const;
 
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by the ContentionBasedFloodingApp applications installed on the nodes. Return the number
+   * of streams (possibly zero) that have been assigned. The Install() method
+   * should have previously been called by the user.
+   *
+   * \param c NodeContainer of the set of nodes for which the applications
+   *          should be modified to use a fixed stream
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this helper
+   */
+  int64_t AssignStreams (NodeContainer c, int64_t stream);
+
 private:
   /**
    * Install an ns3::UdpEchoServer on the node configured with all the
@@ -178,6 +221,14 @@ public:
    */
   void SetAttribute (std::string name, const AttributeValue &value);
 
+  /**
+   * Select how the applications send their frames, by setting their
+   * Transport attribute.
+   *
+   * \param transport UDP_TRANSPORT (the default) or PACKET_TRANSPORT
+   */
+  void SetTransport (FloodingTransport transport);
+
   /**
    * Create a UdpEchoServerApplication on the specified Node.
    *
@@ -211,6 +262,19 @@ public:
    */
   ApplicationContainer Install (NodeContainer c) const;
 
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by the RateDecayFloodingApp applications installed on the nodes. Return the number
+   * of streams (possibly zero) that have been assigned. The Install() method
+   * should have previously been called by the user.
+   *
+   * \param c NodeContainer of the set of nodes for which the applications
+   *          should be modified to use a fixed stream
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this helper
+   */
+  int64_t AssignStreams (NodeContainer c, int64_t stream);
+
 private:
   /**
    * Install an ns3::UdpEchoServer on the node configured with all the
@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "flooding-kpi-sampler.h"
+#include "ns3/pure-flooding-application.h"
+#include "ns3/contention-based-flooding-application.h"
+#include "ns3/rate-decay-flooding-application.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include <limits>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FloodingKpiSampler");
+
+FloodingKpiSampler::FloodingKpiSampler ()
+  : m_counters (Create<FloodingCounters> ()),
+    m_interval (Seconds (10)),
+    m_sampled (false),
+    m_numNodes (0)
+{
+}
+
+FloodingKpiSampler::~FloodingKpiSampler ()
+{
+  if (m_output.is_open ())
+    {
+      m_output.close ();
+    }
+}
+
+void
+FloodingKpiSampler::SetInterval (Time interval)
+{
+  NS_ABORT_MSG_UNLESS (interval.IsStrictlyPositive (), "The sampling interval must be positive");
+  m_interval = interval;
+}
+
+void
+FloodingKpiSampler::Install (NodeContainer c)
+{
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      Ptr<Node> node = *i;
+      m_numNodes++;
+      if (node->GetNApplications () == 0)
+        {
+          continue;
+        }
+      Ptr<Application> app = node->GetApplication (0);
+      if (Ptr<PureFloodingApp> pf = DynamicCast<PureFloodingApp> (app))
+        {
+          pf->SetCounters (m_counters);
+        }
+      else if (Ptr<ContentionBasedFloodingApp> cbf = DynamicCast<ContentionBasedFloodingApp> (app))
+        {
+          cbf->SetCounters (m_counters);
+        }
+      else if (Ptr<RateDecayFloodingApp> rdf = DynamicCast<RateDecayFloodingApp> (app))
+        {
+          rdf->SetCounters (m_counters);
+        }
+    }
+}
+
+void
+FloodingKpiSampler::Open (std::string filename)
+{
+  if (m_output.is_open ())
+    {
+      m_output.close ();
+    }
+  m_output.open (filename, std::ios::trunc);
+  NS_ABORT_MSG_UNLESS (m_output.is_open (), "Cannot write " << filename);
+  m_output << "timestamp,pd,pe500,sumSent,sumSentCoded,sumRcvd,sumFwd,"
+           << "windowPe500,windowSent,windowSentCoded,windowRcvd,windowFwd" << std::endl;
+}
+
+void
+FloodingKpiSampler::Start (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_counters->Reset ();
+  m_last.Reset ();
+  m_lastSample = Simulator::Now ();
+  m_sampled = false;
+  m_event.Cancel ();
+  m_event = Simulator::Schedule (m_interval, &FloodingKpiSampler::Periodic, this);
+}
+
+void
+FloodingKpiSampler::Periodic (void)
+{
+  Sample ();
+  m_event = Simulator::Schedule (m_interval, &FloodingKpiSampler::Periodic, this);
+}
+
+void
+FloodingKpiSampler::Sample (void)
+{
+  NS_LOG_FUNCTION (this);
+  const FloodingCounters &now = *m_counters;
+  if (m_output.is_open ())
+    {
+      m_output << std::to_string (Simulator::Now ().GetSeconds ()) << ","
+               << GetDeliveryProbability () << ","
+               << GetExcessProbability () << ","
+               << now.sent << ","
+               << now.sentCoded << ","
+               << now.received << ","
+               << now.forwarded << ","
+               << ExcessProbability (now.receivedLate - m_last.receivedLate,
+                                     now.receivedInTime - m_last.receivedInTime) << ","
+               << now.sent - m_last.sent << ","
+               << now.sentCoded - m_last.sentCoded << ","
+               << now.received - m_last.received << ","
+               << now.forwarded - m_last.forwarded << std::endl;
+    }
+  m_last.seenPairs = now.seenPairs;
+  m_last.receivedInTime = now.receivedInTime;
+  m_last.receivedLate = now.receivedLate;
+  m_last.sent = now.sent;
+  m_last.sentCoded = now.sentCoded;
+  m_last.received = now.received;
+  m_last.forwarded = now.forwarded;
+  m_lastSample = Simulator::Now ();
+  m_sampled = true;
+}
+
+void
+FloodingKpiSampler::Finish (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_event.Cancel ();
+  if (!m_sampled || Simulator::Now () > m_lastSample)
+    {
+      Sample ();
+    }
+}
+
+Ptr<FloodingCounters>
+FloodingKpiSampler::GetCounters (void) const
+{
+  return m_counters;
+}
+
+double
+FloodingKpiSampler::GetDeliveryProbability (void) const
+{
+  if (m_numNodes < 2)
+    {
+      return 0.0;
+    }
+  return m_counters->seenPairs / (m_numNodes * (m_numNodes - 1.0));
+}
+
+double
+FloodingKpiSampler::GetExcessProbability (void) const
+{
+  return ExcessProbability (m_counters->receivedLate, m_counters->receivedInTime);
+}
+
+double
+FloodingKpiSampler::ExcessProbability (uint64_t late, uint64_t inTime)
+{
+  if (late + inTime == 0)
+    {
+      return std::numeric_limits<double>::quiet_NaN ();
+    }
+  return static_cast<double> (late) / (late + inTime);
+}
+
+} // namespace ns3
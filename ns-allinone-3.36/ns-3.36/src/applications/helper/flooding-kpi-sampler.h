@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef FLOODING_KPI_SAMPLER_H
+#define FLOODING_KPI_SAMPLER_H
+
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include "ns3/event-id.h"
+#include "ns3/flooding-counters.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup applications
+ *
+ * \brief KPIs of the flooding applications, written as a time series
+ * during the simulation.
+ *
+ * The applications count their metrics in shared FloodingCounters, so
+ * that a sample costs the same whatever the number of nodes. Every
+ * Interval after Start, a line is appended to the KPI file and the file is
+ * flushed, so that a simulation which is killed leaves the KPIs up to its
+ * last window.
+ *
+ * The columns are those of the KPI files written at the end of a run,
+ * accounted since Start: P_D (pd) is the ratio of the (node, source) pairs
+ * with an update received, P_EX (pe500) the ratio of the updates received
+ * after the AoI threshold, followed by the updates sent, the coded frames
+ * sent, the updates received and forwarded. The last line of a finished
+ * run is thus its KPIs. The window* columns hold P_EX and the counts over
+ * the window ending at the line only; pe500 and windowPe500 are nan
+ * without any update received.
+ */
+class FloodingKpiSampler
+{
+public:
+  FloodingKpiSampler ();
+  ~FloodingKpiSampler ();
+
+  FloodingKpiSampler (const FloodingKpiSampler &) = delete;
+  FloodingKpiSampler & operator= (const FloodingKpiSampler &) = delete;
+
+  /**
+   * \param interval duration of the windows, 10 s by default
+   */
+  void SetInterval (Time interval);
+
+  /**
+   * Count the metrics of the first application of the nodes, if it is a
+   * PureFloodingApp, a ContentionBasedFloodingApp or a
+   * RateDecayFloodingApp, in the counters of the sampler.
+   *
+   * \param c the nodes
+   */
+  void Install (NodeContainer c);
+
+  /**
+   * \param filename CSV file receiving the samples:
+   *        timestamp,pd,pe500,sumSent,sumSentCoded,sumRcvd,sumFwd,
+   *        windowPe500,windowSent,windowSentCoded,windowRcvd,windowFwd
+   *
+   * Closes the previous file, if any.
+   */
+  void Open (std::string filename);
+
+  /**
+   * Reset the counters, e.g. at the end of the warm-up after the
+   * ResetStats of the applications, and sample every Interval from now on.
+   */
+  void Start (void);
+
+  /**
+   * Append the line of the window ending now and flush the file.
+   */
+  void Sample (void);
+
+  /**
+   * Stop sampling, after the line of the last window if it was not
+   * written yet, e.g. at the end of the simulation.
+   */
+  void Finish (void);
+
+  /**
+   * \returns the counters incremented by the installed applications
+   */
+  Ptr<FloodingCounters> GetCounters (void) const;
+
+  /**
+   * \returns P_D since Start
+   */
+  double GetDeliveryProbability (void) const;
+
+  /**
+   * \returns P_EX since Start
+   */
+  double GetExcessProbability (void) const;
+
+private:
+  /// Sample and schedule the next sample
+  void Periodic (void);
+
+  /**
+   * \param late updates received late
+   * \param inTime updates received in time
+   * \returns late / (late + inTime), nan if no update was received
+   */
+  static double ExcessProbability (uint64_t late, uint64_t inTime);
+
+  Ptr<FloodingCounters> m_counters;    //!< counters of the installed applications
+  FloodingCounters m_last;             //!< counters at the previous sample
+  Time m_interval;                     //!< duration of the windows
+  Time m_lastSample;                   //!< time of the previous sample
+  bool m_sampled;                      //!< whether a line was written since Start
+  uint32_t m_numNodes;                 //!< installed nodes
+  EventId m_event;                     //!< next sample
+  std::ofstream m_output;              //!< KPI file
+};
+
+} // namespace ns3
+
+#endif /* FLOODING_KPI_SAMPLER_H */
@@ -0,0 +1,344 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "reception-ratio-helper.h"
+#include "ns3/pure-flooding-application.h"
+#include "ns3/contention-based-flooding-application.h"
+#include "ns3/rate-decay-flooding-application.h"
+#include "ns3/rate-decay-flooding-nc-header.h"
+#include "ns3/mobility-model.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ReceptionRatioHelper");
+
+ReceptionRatioHelper::ReceptionRatioHelper (double range)
+  : m_range (range),
+    m_gridUpdateInterval (Seconds (0)),
+    m_maxSpeed (0.0),
+    m_receptionWindow (Seconds (1)),
+    m_gridValid (false),
+    m_pendingBase (0),
+    m_packets (0),
+    m_potential (0),
+    m_receivers (0),
+    m_packetsWithPotential (0),
+    m_ratioSum (0.0)
+{
+}
+
+ReceptionRatioHelper::~ReceptionRatioHelper ()
+{
+  for (auto &connection : m_connections)
+    {
+      connection.source->TraceDisconnectWithoutContext (connection.name, connection.sink);
+    }
+  if (m_output.is_open ())
+    {
+      m_output.close ();
+    }
+}
+
+void
+ReceptionRatioHelper::SetGridUpdateInterval (Time interval)
+{
+  m_gridUpdateInterval = interval;
+}
+
+void
+ReceptionRatioHelper::SetMaxSpeed (double speed)
+{
+  m_maxSpeed = speed;
+}
+
+void
+ReceptionRatioHelper::SetReceptionWindow (Time window)
+{
+  m_receptionWindow = window;
+}
+
+void
+ReceptionRatioHelper::Install (NodeContainer c)
+{
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      Ptr<Node> node = *i;
+      Ptr<MobilityModel> mobility = node->GetObject<MobilityModel> ();
+      NS_ABORT_MSG_UNLESS (mobility, "Node " << node->GetId () << " has no MobilityModel");
+      if (m_indexOf.find (node->GetId ()) != m_indexOf.end ())
+        {
+          continue;
+        }
+      m_indexOf[node->GetId ()] = m_nodeIds.size ();
+      m_nodeIds.push_back (node->GetId ());
+      m_mobility.push_back (mobility);
+      Connect (node);
+    }
+  m_gridValid = false;
+}
+
+void
+ReceptionRatioHelper::Connect (Ptr<Node> node)
+{
+  if (node->GetNApplications () == 0)
+    {
+      return;
+    }
+  Ptr<Application> app = node->GetApplication (0);
+  Connection tx;
+  Connection rx;
+  tx.source = app;
+  tx.name = "Tx";
+  rx.source = app;
+  rx.name = "Rx";
+  if (DynamicCast<PureFloodingApp> (app))
+    {
+      tx.sink = MakeBoundCallback (&ReceptionRatioHelper::PlainTx<PureFloodingHeader>, this);
+      rx.sink = MakeBoundCallback (&ReceptionRatioHelper::Rx<PureFloodingHeader>, this);
+    }
+  else if (DynamicCast<ContentionBasedFloodingApp> (app))
+    {
+      tx.sink = MakeBoundCallback (&ReceptionRatioHelper::PlainTx<ContentionBasedFloodingHeader>, this);
+      rx.sink = MakeBoundCallback (&ReceptionRatioHelper::Rx<ContentionBasedFloodingHeader>, this);
+    }
+  else if (DynamicCast<RateDecayFloodingApp> (app))
+    {
+      // The received updates are traced with a contention based header
+      tx.sink = MakeBoundCallback (&ReceptionRatioHelper::NcTx, this);
+      rx.sink = MakeBoundCallback (&ReceptionRatioHelper::Rx<ContentionBasedFloodingHeader>, this);
+    }
+  else
+    {
+      return;
+    }
+  app->TraceConnectWithoutContext (tx.name, tx.sink);
+  app->TraceConnectWithoutContext (rx.name, rx.sink);
+  m_connections.push_back (tx);
+  m_connections.push_back (rx);
+}
+
+template <class Header>
+void
+ReceptionRatioHelper::PlainTx (ReceptionRatioHelper *helper, Ptr<const Packet> packet, uint32_t nodeId)
+{
+  Header header;
+  packet->PeekHeader (header);
+  helper->PacketSent (header.GetSrc (), header.GetSeq ());
+}
+
+void
+ReceptionRatioHelper::NcTx (ReceptionRatioHelper *helper, Ptr<const Packet> packet, uint32_t nodeId, double pL)
+{
+  RateDecayFloodingNcHeader header;
+  packet->PeekHeader (header);
+  helper->PacketSent (header.GetSrcLeft (), header.GetSeqLeft (), pL);
+}
+
+template <class Header>
+void
+ReceptionRatioHelper::Rx (ReceptionRatioHelper *helper, Ptr<const Packet> packet, uint32_t nodeId)
+{
+  Header header;
+  packet->PeekHeader (header);
+  helper->PacketReceived (nodeId, header.GetSrc (), header.GetSeq (), header.GetNumHops ());
+}
+
+void
+ReceptionRatioHelper::EnablePerPacketOutput (std::string filename)
+{
+  if (m_output.is_open ())
+    {
+      m_output.close ();
+    }
+  m_output.open (filename, std::ios::trunc);
+  NS_ABORT_MSG_UNLESS (m_output.is_open (), "Cannot write " << filename);
+  m_output << "timestamp,src,seq,pos_x,pos_y,potentialReceivers,receivers,pL\n";
+}
+
+void
+ReceptionRatioHelper::PacketSent (uint32_t src, uint32_t seq, double pL)
+{
+  NS_LOG_FUNCTION (this << src << seq << pL);
+  Expire ();
+  auto index = m_indexOf.find (src);
+  NS_ABORT_MSG_IF (index == m_indexOf.end (), "Node " << src << " is not installed");
+  Pending pending;
+  pending.time = Simulator::Now ();
+  pending.src = src;
+  pending.seq = seq;
+  pending.position = m_mobility[index->second]->GetPosition ();
+  pending.potential = CountWithinRange (pending.position, src);
+  pending.receivers = 0;
+  pending.pL = pL;
+  m_pendingIndex[std::make_pair (src, seq)] = m_pendingBase + m_pending.size ();
+  m_pending.push_back (pending);
+}
+
+void
+ReceptionRatioHelper::PacketReceived (uint32_t nodeId, uint32_t src, uint32_t seq, uint32_t numHops)
+{
+  if (numHops != 0)
+    {
+      return;
+    }
+  Expire ();
+  auto it = m_pendingIndex.find (std::make_pair (src, seq));
+  if (it == m_pendingIndex.end ())
+    {
+      // Sent before the helper was installed or reset, or out of the window
+      return;
+    }
+  m_pending[it->second - m_pendingBase].receivers++;
+}
+
+void
+ReceptionRatioHelper::Expire (void)
+{
+  Time now = Simulator::Now ();
+  while (!m_pending.empty () && now - m_pending.front ().time > m_receptionWindow)
+    {
+      Account (m_pending.front ());
+      m_pendingIndex.erase (std::make_pair (m_pending.front ().src, m_pending.front ().seq));
+      m_pending.pop_front ();
+      m_pendingBase++;
+    }
+}
+
+void
+ReceptionRatioHelper::Account (const Pending &pending)
+{
+  m_packets++;
+  m_potential += pending.potential;
+  m_receivers += pending.receivers;
+  if (pending.potential > 0)
+    {
+      m_packetsWithPotential++;
+      m_ratioSum += static_cast<double> (pending.receivers) / pending.potential;
+    }
+  if (m_output.is_open ())
+    {
+      m_output << pending.time.GetSeconds () << "," << pending.src << "," << pending.seq << ","
+               << pending.position.x << "," << pending.position.y << ","
+               << pending.potential << "," << pending.receivers << "," << pending.pL << "\n";
+    }
+}
+
+void
+ReceptionRatioHelper::Flush (void)
+{
+  if (m_output.is_open ())
+    {
+      m_output.flush ();
+    }
+}
+
+void
+ReceptionRatioHelper::Finish (void)
+{
+  for (const Pending &pending : m_pending)
+    {
+      Account (pending);
+    }
+  m_pendingBase += m_pending.size ();
+  m_pending.clear ();
+  m_pendingIndex.clear ();
+  Flush ();
+}
+
+void
+ReceptionRatioHelper::ResetStats (void)
+{
+  m_pendingBase += m_pending.size ();
+  m_pending.clear ();
+  m_pendingIndex.clear ();
+  m_packets = 0;
+  m_potential = 0;
+  m_receivers = 0;
+  m_packetsWithPotential = 0;
+  m_ratioSum = 0.0;
+}
+
+uint64_t
+ReceptionRatioHelper::GetPackets (void) const
+{
+  return m_packets;
+}
+
+uint64_t
+ReceptionRatioHelper::GetPotentialReceivers (void) const
+{
+  return m_potential;
+}
+
+uint64_t
+ReceptionRatioHelper::GetReceivers (void) const
+{
+  return m_receivers;
+}
+
+double
+ReceptionRatioHelper::GetReceptionRatio (void) const
+{
+  return m_potential == 0 ? 0.0 : static_cast<double> (m_receivers) / m_potential;
+}
+
+double
+ReceptionRatioHelper::GetMeanPacketReceptionRatio (void) const
+{
+  return m_packetsWithPotential == 0 ? 0.0 : m_ratioSum / m_packetsWithPotential;
+}
+
+void
+ReceptionRatioHelper::BuildGrid (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<Vector> positions;
+  positions.reserve (m_mobility.size ());
+  for (const auto &mobility : m_mobility)
+    {
+      positions.push_back (mobility->GetPosition ());
+    }
+  m_grid.Build (positions, std::max (m_range, 1.0));
+  m_gridTime = Simulator::Now ();
+  m_gridValid = true;
+}
+
+uint32_t
+ReceptionRatioHelper::CountWithinRange (const Vector &position, uint32_t exclude)
+{
+  if (!m_gridValid || Simulator::Now () - m_gridTime > m_gridUpdateInterval)
+    {
+      BuildGrid ();
+    }
+  // Nodes may have moved since the grid was built
+  double radius = m_range + m_maxSpeed * (Simulator::Now () - m_gridTime).GetSeconds ();
+  m_grid.GetCandidates (position, radius, &m_candidates);
+  uint32_t count = 0;
+  for (uint32_t i : m_candidates)
+    {
+      if (m_nodeIds[i] != exclude
+          && CalculateDistance (m_mobility[i]->GetPosition (), position) <= m_range)
+        {
+          count++;
+        }
+    }
+  return count;
+}
+
+} // namespace ns3
@@ -0,0 +1,275 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef RECEPTION_RATIO_HELPER_H
+#define RECEPTION_RATIO_HELPER_H
+
+#include <stdint.h>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ns3/callback.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/spatial-grid.h"
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+class MobilityModel;
+class Packet;
+
+/**
+ * \ingroup applications
+ *
+ * \brief One-hop reception ratio of the updates originated by the flooding
+ * applications, accounted during the simulation.
+ *
+ * For each update a node originates (Tx trace source), the helper counts
+ * the installed nodes within Range of the sender at send time, the
+ * potential receivers, and then the nodes that receive the update directly
+ * from its source (Rx trace source, with no hop). The reception ratio of
+ * the update is receivers / potential receivers. This is what
+ * analysis_scripts/parse_detailed_results_v3.py computes from full packet
+ * and course traces, without having to trace every packet.
+ *
+ * The potential receivers are found with a uniform grid of the node
+ * positions, rebuilt when it is older than GridUpdateInterval. Between two
+ * rebuilds, the search is widened by MaxSpeed times the age of the grid and
+ * the candidates are checked at their current position, so the count is
+ * exact as long as no node moves faster than MaxSpeed.
+ *
+ * An update is accounted ReceptionWindow after it was sent, or when Finish
+ * is called. The per-update results can be written to a CSV file with
+ * EnablePerPacketOutput.
+ */
+class ReceptionRatioHelper
+{
+public:
+  /**
+   * \param range distance (m) within which a node is a potential receiver
+   */
+  ReceptionRatioHelper (double range = 509.8);
+  ~ReceptionRatioHelper ();
+
+  ReceptionRatioHelper (const ReceptionRatioHelper &) = delete;
+  ReceptionRatioHelper & operator= (const ReceptionRatioHelper &) = delete;
+
+  /**
+   * \param interval maximum age of the spatial grid; zero rebuilds it
+   *        whenever the simulation time has advanced
+   */
+  void SetGridUpdateInterval (Time interval);
+
+  /**
+   * \param speed upper bound on the speed (m/s) of the nodes
+   */
+  void SetMaxSpeed (double speed);
+
+  /**
+   * \param window time after which the receptions of an update are no
+   *        longer counted
+   */
+  void SetReceptionWindow (Time window);
+
+  /**
+   * Make the nodes potential receivers, and connect to the Tx and Rx trace
+   * sources of their first application if it is a PureFloodingApp, a
+   * ContentionBasedFloodingApp or a RateDecayFloodingApp.
+   *
+   * \param c the nodes, which must have a MobilityModel
+   */
+  void Install (NodeContainer c);
+
+  /**
+   * \param filename CSV file receiving one line per accounted update:
+   *        timestamp,src,seq,pos_x,pos_y,potentialReceivers,receivers,pL
+   *
+   * Closes the previous file, if any.
+   */
+  void EnablePerPacketOutput (std::string filename);
+
+  /**
+   * Account for an update originated by a node, at the current time.
+   *
+   * \param src the source of the update, which must be installed
+   * \param seq its sequence number
+   * \param pL the packet loss rate estimated by the source, -1 if none
+   */
+  void PacketSent (uint32_t src, uint32_t seq, double pL = -1.0);
+
+  /**
+   * Account for the reception of an update.
+   *
+   * \param nodeId the receiver
+   * \param src the source of the update
+   * \param seq its sequence number
+   * \param numHops the hops of the update before it was received, 0 if
+   *        received from its source
+   */
+  void PacketReceived (uint32_t nodeId, uint32_t src, uint32_t seq, uint32_t numHops);
+
+  /**
+   * Write the lines of the updates accounted so far to the per-update
+   * output.
+   */
+  void Flush (void);
+
+  /**
+   * Account for all the pending updates, e.g. at the end of the
+   * simulation, and flush the per-update output.
+   */
+  void Finish (void);
+
+  /**
+   * Forget the updates accounted so far, e.g. at the end of a warm-up.
+   * Pending updates are dropped.
+   */
+  void ResetStats (void);
+
+  /**
+   * \returns the number of updates accounted
+   */
+  uint64_t GetPackets (void) const;
+
+  /**
+   * \returns the sum of the potential receivers of the updates accounted
+   */
+  uint64_t GetPotentialReceivers (void) const;
+
+  /**
+   * \returns the sum of the receivers of the updates accounted
+   */
+  uint64_t GetReceivers (void) const;
+
+  /**
+   * \returns receivers / potential receivers, over all the updates
+   *          accounted; 0 if there were no potential receivers
+   */
+  double GetReceptionRatio (void) const;
+
+  /**
+   * \returns the mean reception ratio of the updates accounted that had
+   *          potential receivers
+   */
+  double GetMeanPacketReceptionRatio (void) const;
+
+private:
+  /// Update waiting for its receptions
+  struct Pending
+  {
+    Time time;                 //!< send time
+    uint32_t src;              //!< source
+    uint32_t seq;              //!< sequence number
+    Vector position;           //!< position of the source at send time
+    uint32_t potential;        //!< potential receivers
+    uint32_t receivers;        //!< receivers so far
+    double pL;                 //!< loss rate estimated by the source
+  };
+
+  /**
+   * Connect to the trace sources of a flooding application
+   * \param node the node of the application
+   */
+  void Connect (Ptr<Node> node);
+
+  /**
+   * Tx sink of the applications with a PlainCodingPolicy
+   * \param helper the helper
+   * \param packet the packet sent
+   * \param nodeId the sender
+   */
+  template <class Header>
+  static void PlainTx (ReceptionRatioHelper *helper, Ptr<const Packet> packet, uint32_t nodeId);
+
+  /**
+   * Tx sink of the applications with a NetworkCodingPolicy
+   * \param helper the helper
+   * \param packet the packet sent
+   * \param nodeId the sender
+   * \param pL the loss rate estimated by the sender
+   */
+  static void NcTx (ReceptionRatioHelper *helper, Ptr<const Packet> packet, uint32_t nodeId, double pL);
+
+  /**
+   * Rx sink
+   * \param helper the helper
+   * \param packet the packet received
+   * \param nodeId the receiver
+   */
+  template <class Header>
+  static void Rx (ReceptionRatioHelper *helper, Ptr<const Packet> packet, uint32_t nodeId);
+
+  /**
+   * \param position a position
+   * \param exclude node not counted
+   * \returns the installed nodes within range of the position
+   */
+  uint32_t CountWithinRange (const Vector &position, uint32_t exclude);
+
+  /// Rebuild the grid from the current positions of the nodes
+  void BuildGrid (void);
+
+  /// Account for the pending updates sent more than the reception window ago
+  void Expire (void);
+
+  /**
+   * Account for an update
+   * \param pending the update
+   */
+  void Account (const Pending &pending);
+
+  /// Connected trace sink
+  struct Connection
+  {
+    Ptr<Object> source;  //!< object of the trace source
+    std::string name;    //!< trace source name
+    CallbackBase sink;   //!< connected sink
+  };
+
+  double m_range;                      //!< range of the potential receivers (m)
+  Time m_gridUpdateInterval;           //!< maximum age of the grid
+  double m_maxSpeed;                   //!< upper bound on the node speed (m/s)
+  Time m_receptionWindow;              //!< receptions counted for this long
+
+  std::vector<uint32_t> m_nodeIds;                 //!< installed nodes
+  std::vector<Ptr<MobilityModel> > m_mobility;     //!< their mobility models
+  std::map<uint32_t, uint32_t> m_indexOf;          //!< index of a node id in m_nodeIds
+  std::vector<Connection> m_connections;           //!< connected sinks
+
+  bool m_gridValid;                    //!< whether the grid was built
+  Time m_gridTime;                     //!< time the grid was built
+  SpatialGrid m_grid;                  //!< grid of the positions of the nodes in m_nodeIds
+  std::vector<uint32_t> m_candidates;  //!< scratch list of the nodes near a position
+
+  std::deque<Pending> m_pending;                                   //!< updates in send order
+  std::map<std::pair<uint32_t, uint32_t>, size_t> m_pendingIndex;  //!< (src, seq) to offset from m_pendingBase
+  size_t m_pendingBase;                                            //!< number of updates popped from m_pending
+
+  uint64_t m_packets;                  //!< updates accounted
+  uint64_t m_potential;                //!< sum of the potential receivers
+  uint64_t m_receivers;                //!< sum of the receivers
+  uint64_t m_packetsWithPotential;     //!< updates accounted with potential receivers
+  double m_ratioSum;                   //!< sum of their reception ratios
+
+  std::ofstream m_output;              //!< per-update output
+};
+
+} // namespace ns3
+
+#endif /* RECEPTION_RATIO_HELPER_H */
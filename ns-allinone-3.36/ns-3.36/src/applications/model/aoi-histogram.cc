@@ -0,0 +1,232 @@
+#include "aoi-histogram.h"
+#include "ns3/assert.h"
+#include <algorithm>
+#include <math.h>
+
+namespace ns3
+{
+    const uint32_t AoiHistogram::SUB_BUCKET_BITS;
+    const uint32_t AoiHistogram::VALUE_BITS;
+    const uint64_t AoiHistogram::MAX_VALUE;
+    const uint32_t AoiHistogram::N_BUCKETS;
+
+    AoiHistogram::AoiHistogram(double ringWidth, uint32_t nRings, uint32_t nHops)
+    {
+        Configure(ringWidth, nRings, nHops);
+    }
+
+    void AoiHistogram::Configure(double ringWidth, uint32_t nRings, uint32_t nHops)
+    {
+        NS_ASSERT(ringWidth > 0.0 && nRings > 0 && nHops > 0);
+        m_ringWidth = ringWidth;
+        m_nRings = nRings;
+        m_nHops = nHops;
+        m_blocks.assign(nRings * nHops, 0);
+        m_cellCounts.assign(nRings * nHops, 0);
+        m_cellSums.assign(nRings * nHops, 0.0);
+        m_counts.clear();
+    }
+
+    void AoiHistogram::Clear()
+    {
+        std::fill(m_cellCounts.begin(), m_cellCounts.end(), 0);
+        std::fill(m_cellSums.begin(), m_cellSums.end(), 0.0);
+        // Keep the allocated cells, they are likely to be used again
+        std::fill(m_counts.begin(), m_counts.end(), 0);
+    }
+
+    double AoiHistogram::GetRingWidth() const
+    {
+        return m_ringWidth;
+    }
+
+    uint32_t AoiHistogram::GetNRings() const
+    {
+        return m_nRings;
+    }
+
+    uint32_t AoiHistogram::GetNHops() const
+    {
+        return m_nHops;
+    }
+
+    uint32_t AoiHistogram::GetBucket(uint64_t value)
+    {
+        const uint64_t sub = uint64_t(1) << SUB_BUCKET_BITS;
+        if (value > MAX_VALUE)
+        {
+            value = MAX_VALUE;
+        }
+        if (value < sub)
+        {
+            return value;
+        }
+        uint32_t msb = 63 - __builtin_clzll(value);
+        uint32_t shift = msb - SUB_BUCKET_BITS;
+        return ((shift + 1) << SUB_BUCKET_BITS) + ((value >> shift) - sub);
+    }
+
+    uint64_t AoiHistogram::GetBucketLowerBound(uint32_t bucket)
+    {
+        const uint64_t sub = uint64_t(1) << SUB_BUCKET_BITS;
+        if (bucket < sub)
+        {
+            return bucket;
+        }
+        uint32_t shift = (bucket >> SUB_BUCKET_BITS) - 1;
+        return (sub + (bucket & (sub - 1))) << shift;
+    }
+
+    uint64_t AoiHistogram::GetBucketUpperBound(uint32_t bucket)
+    {
+        const uint64_t sub = uint64_t(1) << SUB_BUCKET_BITS;
+        if (bucket < sub)
+        {
+            return bucket + 1;
+        }
+        uint32_t shift = (bucket >> SUB_BUCKET_BITS) - 1;
+        return (sub + (bucket & (sub - 1)) + 1) << shift;
+    }
+
+    uint32_t AoiHistogram::GetCell(uint32_t ring, uint32_t hops) const
+    {
+        NS_ASSERT(ring < m_nRings && hops < m_nHops);
+        return ring * m_nHops + hops;
+    }
+
+    const uint32_t *AoiHistogram::GetBuckets(uint32_t cell) const
+    {
+        if (m_blocks[cell] == 0)
+        {
+            return nullptr;
+        }
+        return &m_counts[(m_blocks[cell] - 1) * size_t(N_BUCKETS)];
+    }
+
+    void AoiHistogram::Record(double distance, uint32_t numHops, Time aoi)
+    {
+        uint32_t ring = m_nRings - 1;
+        if (distance < m_ringWidth * ring)
+        {
+            ring = static_cast<uint32_t>(distance / m_ringWidth);
+        }
+        uint32_t hops = std::min(numHops, m_nHops - 1);
+        uint32_t cell = ring * m_nHops + hops;
+
+        if (m_blocks[cell] == 0)
+        {
+            m_counts.resize(m_counts.size() + N_BUCKETS, 0);
+            m_blocks[cell] = m_counts.size() / N_BUCKETS;
+        }
+        int64_t us = aoi.GetMicroSeconds();
+        m_counts[(m_blocks[cell] - 1) * size_t(N_BUCKETS) + GetBucket(us > 0 ? us : 0)]++;
+        m_cellCounts[cell]++;
+        m_cellSums[cell] += aoi.GetSeconds();
+    }
+
+    void AoiHistogram::Merge(const AoiHistogram &other)
+    {
+        NS_ASSERT_MSG(other.m_ringWidth == m_ringWidth && other.m_nRings == m_nRings && other.m_nHops == m_nHops,
+                      "Merging AoI histograms with different cells");
+        for (uint32_t cell = 0; cell < m_blocks.size(); cell++)
+        {
+            const uint32_t *buckets = other.GetBuckets(cell);
+            if (buckets == nullptr)
+            {
+                continue;
+            }
+            if (m_blocks[cell] == 0)
+            {
+                m_counts.resize(m_counts.size() + N_BUCKETS, 0);
+                m_blocks[cell] = m_counts.size() / N_BUCKETS;
+            }
+            uint32_t *own = &m_counts[(m_blocks[cell] - 1) * size_t(N_BUCKETS)];
+            for (uint32_t b = 0; b < N_BUCKETS; b++)
+            {
+                own[b] += buckets[b];
+            }
+            m_cellCounts[cell] += other.m_cellCounts[cell];
+            m_cellSums[cell] += other.m_cellSums[cell];
+        }
+    }
+
+    uint64_t AoiHistogram::GetCount(uint32_t ring, uint32_t hops) const
+    {
+        return m_cellCounts[GetCell(ring, hops)];
+    }
+
+    Time AoiHistogram::GetMean(uint32_t ring, uint32_t hops) const
+    {
+        uint32_t cell = GetCell(ring, hops);
+        if (m_cellCounts[cell] == 0)
+        {
+            return Seconds(0);
+        }
+        return Seconds(m_cellSums[cell] / m_cellCounts[cell]);
+    }
+
+    Time AoiHistogram::GetPercentile(uint32_t ring, uint32_t hops, double p) const
+    {
+        NS_ASSERT(p >= 0.0 && p <= 1.0);
+        uint32_t cell = GetCell(ring, hops);
+        const uint32_t *buckets = GetBuckets(cell);
+        if (buckets == nullptr || m_cellCounts[cell] == 0)
+        {
+            return Seconds(0);
+        }
+        uint64_t rank = std::max<uint64_t>(1, ceil(p * m_cellCounts[cell]));
+        uint64_t seen = 0;
+        for (uint32_t b = 0; b < N_BUCKETS; b++)
+        {
+            seen += buckets[b];
+            if (seen >= rank)
+            {
+                return MicroSeconds((GetBucketLowerBound(b) + GetBucketUpperBound(b)) / 2);
+            }
+        }
+        return MicroSeconds(MAX_VALUE);
+    }
+
+    uint32_t AoiHistogram::GetBucketCount(uint32_t ring, uint32_t hops, uint32_t bucket) const
+    {
+        NS_ASSERT(bucket < N_BUCKETS);
+        const uint32_t *buckets = GetBuckets(GetCell(ring, hops));
+        return buckets == nullptr ? 0 : buckets[bucket];
+    }
+
+    void AoiHistogram::Print(std::ostream &os) const
+    {
+        os << "ring,hops,lower,upper,count" << std::endl;
+        for (uint32_t ring = 0; ring < m_nRings; ring++)
+        {
+            for (uint32_t hops = 0; hops < m_nHops; hops++)
+            {
+                const uint32_t *buckets = GetBuckets(GetCell(ring, hops));
+                if (buckets == nullptr)
+                {
+                    continue;
+                }
+                for (uint32_t b = 0; b < N_BUCKETS; b++)
+                {
+                    if (buckets[b] == 0)
+                    {
+                        continue;
+                    }
+                    os << ring << "," << hops << ","
+                       << GetBucketLowerBound(b) / 1e6 << ","
+                       << GetBucketUpperBound(b) / 1e6 << ","
+                       << buckets[b] << std::endl;
+                }
+            }
+        }
+    }
+
+    size_t AoiHistogram::GetMemoryFootprint() const
+    {
+        return m_blocks.capacity() * sizeof(uint32_t)
+            + m_cellCounts.capacity() * sizeof(uint64_t)
+            + m_cellSums.capacity() * sizeof(double)
+            + m_counts.capacity() * sizeof(uint32_t);
+    }
+
+} // namespace ns3
@@ -0,0 +1,141 @@
+#ifndef AOI_HISTOGRAM_H
+#define AOI_HISTOGRAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "ns3/application.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+
+namespace ns3
+{
+    /**
+     * Streaming distribution of the age of information (AoI), per distance
+     * ring from the source and per hop count.
+     *
+     * Every (ring, hops) cell holds a log-linear histogram of the AoI in
+     * microseconds: values below 2^SUB_BUCKET_BITS have their own bucket,
+     * and every power of two above is split in 2^SUB_BUCKET_BITS buckets
+     * of equal width, so that a bucket is at most 1/2^SUB_BUCKET_BITS of
+     * its lower bound wide. Values above MAX_VALUE fall in the last bucket.
+     *
+     * The buckets of a cell are allocated on its first sample, in one flat
+     * array shared by all the cells.
+     */
+    class AoiHistogram
+    {
+    public:
+        static const uint32_t SUB_BUCKET_BITS = 4;
+        static const uint32_t VALUE_BITS = 32;
+        static const uint64_t MAX_VALUE = (uint64_t(1) << VALUE_BITS) - 1;  //!< in microseconds, about 71 minutes
+        static const uint32_t N_BUCKETS = (VALUE_BITS - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+        /**
+         * TracedCallback signature of an AoI sample.
+         *
+         * \param [in] src the source of the update
+         * \param [in] distance the distance from the source when it sent the update
+         * \param [in] numHops the number of hops of the update, 0 if received directly
+         * \param [in] aoi the age of the previous update of the source, when replaced
+         */
+        typedef void (*TracedCallback)(uint32_t src, double distance, uint32_t numHops, Time aoi);
+
+        /**
+         * \param ringWidth width of a distance ring (m)
+         * \param nRings number of rings, the last one includes all the
+         *        farther distances
+         * \param nHops number of hop counts, the last one includes all the
+         *        larger ones
+         */
+        explicit AoiHistogram(double ringWidth = 100.0, uint32_t nRings = 6, uint32_t nHops = 8);
+
+        /**
+         * Change the cells, and clear the histogram.
+         */
+        void Configure(double ringWidth, uint32_t nRings, uint32_t nHops);
+
+        void Record(double distance, uint32_t numHops, Time aoi);
+
+        /**
+         * Add the samples of another histogram with the same cells.
+         */
+        void Merge(const AoiHistogram &other);
+
+        void Clear();
+
+        double GetRingWidth() const;
+        uint32_t GetNRings() const;
+        uint32_t GetNHops() const;
+
+        uint64_t GetCount(uint32_t ring, uint32_t hops) const;
+        Time GetMean(uint32_t ring, uint32_t hops) const;
+
+        /**
+         * \param p quantile, in [0, 1]
+         * \returns the middle of the bucket holding the quantile, or zero
+         *          if the cell is empty
+         */
+        Time GetPercentile(uint32_t ring, uint32_t hops, double p) const;
+
+        /**
+         * \returns the number of samples of the cell in the bucket
+         */
+        uint32_t GetBucketCount(uint32_t ring, uint32_t hops, uint32_t bucket) const;
+
+        /**
+         * Write the non-empty buckets as CSV lines
+         * "ring,hops,lower,upper,count", the bounds in seconds, after a
+         * header line.
+         */
+        void Print(std::ostream &os) const;
+
+        /**
+         * \returns an estimate of the heap memory used by the histogram, in bytes
+         */
+        size_t GetMemoryFootprint() const;
+
+        static uint32_t GetBucket(uint64_t value);
+        static uint64_t GetBucketLowerBound(uint32_t bucket);
+        /// \returns the first value above the bucket
+        static uint64_t GetBucketUpperBound(uint32_t bucket);
+
+    private:
+        uint32_t GetCell(uint32_t ring, uint32_t hops) const;
+        const uint32_t *GetBuckets(uint32_t cell) const;
+
+        double m_ringWidth;
+        uint32_t m_nRings;
+        uint32_t m_nHops;
+        std::vector<uint32_t> m_blocks;         //!< 1 + index of the buckets of a cell in m_counts / N_BUCKETS, 0 if none
+        std::vector<uint64_t> m_cellCounts;     //!< number of samples per cell
+        std::vector<double> m_cellSums;         //!< sum of the samples per cell, in seconds
+        std::vector<uint32_t> m_counts;         //!< buckets of the cells with samples
+    };
+
+    /**
+     * Merge the AoI histograms of the first applications of the nodes, and
+     * write them to a file with AoiHistogram::Print.
+     *
+     * \tparam App the flooding application installed on the nodes
+     * \param filename the file to write
+     * \param c the nodes
+     */
+    template <class App>
+    void WriteAoiHistogram(const std::string &filename, NodeContainer c)
+    {
+        AoiHistogram aoi = c.Get(0)->GetApplication(0)->GetObject<App>()->GetAoiHistogram();
+        for (uint32_t i = 1; i < c.GetN(); i++)
+        {
+            aoi.Merge(c.Get(i)->GetApplication(0)->GetObject<App>()->GetAoiHistogram());
+        }
+        std::ofstream out(filename);
+        aoi.Print(out);
+    }
+
+} // namespace ns3
+
+#endif /* AOI_HISTOGRAM_H */
@@ -5,30 +5,60 @@ using namespace std;
 namespace ns3
 {
 
-    BayesianPacketLossEstimator::BayesianPacketLossEstimator()
+    BayesianPacketLossEstimator::BayesianPacketLossEstimator(Mode mode)
+        : mode(mode)
     {
+        if (mode != GRID) {
+            return;
+        }
         for (double pL = 0; pL <= 1.0; pL += step) {
-            probabilities.push_back(1.0);
             packetLossCandidates.push_back(pL);
+            logLoss.push_back(log(pL));
+            logSuccess.push_back(log1p(-pL));
         }
-        probabilities = normalize(probabilities);
+        logProbabilities.assign(packetLossCandidates.size(), 0.0);
+        probabilities.resize(packetLossCandidates.size());
+        normalize();
+    }
+
+    BayesianPacketLossEstimator::Mode BayesianPacketLossEstimator::getMode() const {
+        return mode;
     }
 
     void BayesianPacketLossEstimator::reportObservation(int numSuccess, int numFailures) {
-        vector<double> posterior;
-        for (int i=0; i< packetLossCandidates.size(); i++) {
-            double pL = packetLossCandidates.at(i);
-            double likelihood = pow(pL, numFailures) * pow(1-pL, numSuccess);
-            posterior.push_back(probabilities.at(i) * likelihood);
+        if (mode == CONJUGATE) {
+            alpha += numFailures;
+            beta += numSuccess;
+            return;
+        }
+
+        // Log-likelihood, skipping the 0 * log(0) terms
+        double *logP = logProbabilities.data();
+        size_t n = logProbabilities.size();
+        if (numFailures > 0) {
+            const double *l = logLoss.data();
+            for (size_t i = 0; i < n; i++) {
+                logP[i] += numFailures * l[i];
+            }
+        }
+        if (numSuccess > 0) {
+            const double *l = logSuccess.data();
+            for (size_t i = 0; i < n; i++) {
+                logP[i] += numSuccess * l[i];
+            }
         }
 
-        probabilities = normalize(posterior);
+        normalize();
     }
 
     double BayesianPacketLossEstimator::getExpectedLoss() {
+        if (mode == CONJUGATE) {
+            return alpha / (alpha + beta);
+        }
+
         double loss = 0;
-        for (int i=0; i< packetLossCandidates.size(); i++) {
-            loss += packetLossCandidates.at(i) * probabilities.at(i);
+        for (size_t i=0; i< packetLossCandidates.size(); i++) {
+            loss += packetLossCandidates[i] * probabilities[i];
         }
 
         if (isnan(loss)) {
@@ -39,11 +69,32 @@ namespace ns3
     }
 
     double BayesianPacketLossEstimator::getLossPctl(double targetPctl) {
+        if (mode == CONJUGATE) {
+            if (targetPctl <= 0.0) {
+                return 0.0;
+            }
+            if (targetPctl >= 1.0) {
+                return 1.0;
+            }
+            // The CDF is increasing: bisect down to double precision
+            double lo = 0.0;
+            double hi = 1.0;
+            for (int i = 0; i < 64 && hi - lo > 1e-12; i++) {
+                double mid = 0.5 * (lo + hi);
+                if (incompleteBeta(mid, alpha, beta) < targetPctl) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+            return hi;
+        }
+
         double sum = 0.0;
-        for (int i=0; i< packetLossCandidates.size(); i++) {
-            sum += probabilities.at(i);
+        for (size_t i=0; i< packetLossCandidates.size(); i++) {
+            sum += probabilities[i];
             if (sum >= targetPctl) {
-                return packetLossCandidates.at(i);
+                return packetLossCandidates[i];
             }
         }
 
@@ -51,34 +102,104 @@ namespace ns3
     }
 
     double BayesianPacketLossEstimator::getMostLikelyLoss() {
+        if (mode == CONJUGATE) {
+            // With no failure the density peaks at 0, as does the uniform
+            // prior on the grid, which reports the first candidate
+            if (alpha <= 1.0) {
+                return 0.0;
+            }
+            if (beta <= 1.0) {
+                return 1.0;
+            }
+            return (alpha - 1) / (alpha + beta - 2);
+        }
+
         double loss = 0;
         double likelihood = 0;
-        for (int i=0; i< packetLossCandidates.size(); i++) {
-            if (probabilities.at(i) > likelihood) {
-                likelihood = probabilities.at(i);
-                loss = packetLossCandidates.at(i);
+        for (size_t i=0; i< packetLossCandidates.size(); i++) {
+            if (probabilities[i] > likelihood) {
+                likelihood = probabilities[i];
+                loss = packetLossCandidates[i];
             }
         }
 
         return loss;
     }
 
-    double BayesianPacketLossEstimator::sum(vector<double> data) {
+    void BayesianPacketLossEstimator::normalize() {
+        // Shift so that the largest term is exp(0): nothing underflows to a
+        // 0 / 0, however many observations were made
+        double *logP = logProbabilities.data();
+        size_t n = logProbabilities.size();
+        double maxLogP = *max_element(logP, logP + n);
         double total = 0;
-        for (int i=0; i< data.size(); i++) {
-            total += data.at(i);
+        for (size_t i = 0; i < n; i++) {
+            logP[i] -= maxLogP;
+            probabilities[i] = exp(logP[i]);
+            total += probabilities[i];
         }
+        for (size_t i = 0; i < n; i++) {
+            probabilities[i] /= total;
+        }
+    }
 
-        return total;
+    double BayesianPacketLossEstimator::incompleteBeta(double x, double a, double b) {
+        // Regularized incomplete beta I_x(a, b), with the continued fraction
+        // evaluated where it converges quickly
+        if (x <= 0.0) {
+            return 0.0;
+        }
+        if (x >= 1.0) {
+            return 1.0;
+        }
+        double logFront = lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log1p(-x);
+        if (x < (a + 1) / (a + b + 2)) {
+            return exp(logFront) * incompleteBetaFraction(x, a, b) / a;
+        }
+        return 1.0 - exp(logFront) * incompleteBetaFraction(1 - x, b, a) / b;
     }
 
-    vector<double> BayesianPacketLossEstimator::normalize(vector<double> data) {
-        double total = sum(data);
-        vector<double> normalizedData;
-        for (int i=0; i< data.size(); i++) {
-            normalizedData.push_back(data.at(i) / total);
+    double BayesianPacketLossEstimator::incompleteBetaFraction(double x, double a, double b) {
+        // Modified Lentz's method
+        const double tiny = 1e-300;
+        const double eps = 1e-15;
+        double c = 1.0;
+        double d = 1.0 - (a + b) * x / (a + 1);
+        if (fabs(d) < tiny) {
+            d = tiny;
         }
+        d = 1.0 / d;
+        double h = d;
+        for (int m = 1; m <= 1000; m++) {
+            double m2 = 2 * m;
+            double aa = m * (b - m) * x / ((a + m2 - 1) * (a + m2));
+            d = 1.0 + aa * d;
+            if (fabs(d) < tiny) {
+                d = tiny;
+            }
+            c = 1.0 + aa / c;
+            if (fabs(c) < tiny) {
+                c = tiny;
+            }
+            d = 1.0 / d;
+            h *= d * c;
 
-        return normalizedData;
+            aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1));
+            d = 1.0 + aa * d;
+            if (fabs(d) < tiny) {
+                d = tiny;
+            }
+            c = 1.0 + aa / c;
+            if (fabs(c) < tiny) {
+                c = tiny;
+            }
+            d = 1.0 / d;
+            double delta = d * c;
+            h *= delta;
+            if (fabs(delta - 1.0) < eps) {
+                break;
+            }
+        }
+        return h;
     }
 }
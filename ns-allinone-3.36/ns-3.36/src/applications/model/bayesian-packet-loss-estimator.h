@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <math.h>
+#include <vector>
 #include "ns3/application.h"
 #include "ns3/event-id.h"
 #include "ns3/ptr.h"
@@ -17,23 +18,57 @@ using namespace std;
 
 namespace ns3
 {
+    /**
+     * Bayesian estimate of a packet loss probability from counts of
+     * received and lost packets, starting from a uniform prior.
+     *
+     * GRID keeps the posterior on a grid of candidate loss rates (step
+     * 0.001), in log space. CONJUGATE uses the fact that the posterior is a
+     * Beta(1 + failures, 1 + successes) distribution and only keeps its two
+     * parameters; percentiles come from the regularized incomplete beta
+     * function.
+     */
     class BayesianPacketLossEstimator
     {
+    public:
+        enum Mode
+        {
+            GRID,
+            CONJUGATE
+        };
+
     private:
+        Mode mode;
+
+        // GRID
         double step = 0.001;
+        vector<double> logProbabilities;     // unnormalized, max is 0
         vector<double> probabilities;
         vector<double> packetLossCandidates;
+        vector<double> logLoss;              // log(pL)
+        vector<double> logSuccess;           // log(1 - pL)
+
+        // CONJUGATE
+        double alpha = 1.0;
+        double beta = 1.0;
 
         // Utilitues
-        vector<double> normalize(vector<double> data);
-        double sum(vector<double> data);
+        void normalize();
+        static double incompleteBetaFraction(double x, double a, double b);
 
     public:
-        BayesianPacketLossEstimator();
+        explicit BayesianPacketLossEstimator(Mode mode = GRID);
+        Mode getMode() const;
         double getExpectedLoss();
         double getMostLikelyLoss();
         double getLossPctl(double targetPctl);
         void reportObservation(int numSuccess, int numFailures);
+
+        /**
+         * \returns the regularized incomplete beta function I_x(a, b), i.e.
+         * the CDF at x of a Beta(a, b) distribution
+         */
+        static double incompleteBeta(double x, double a, double b);
     };
 
 } // namespace ns3
@@ -17,19 +17,10 @@
  */
 
 #include "ns3/log.h"
-#include "ns3/ipv4-address.h"
-#include "ns3/ipv6-address.h"
-#include "ns3/address-utils.h"
 #include "ns3/nstime.h"
-#include "ns3/inet-socket-address.h"
-#include "ns3/inet6-socket-address.h"
-#include "ns3/socket.h"
-#include "ns3/udp-socket.h"
-#include "ns3/simulator.h"
-#include "ns3/socket-factory.h"
-#include "ns3/packet.h"
 #include "ns3/uinteger.h"
-#include "ns3/mobility-module.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
 
 #include "contention-based-flooding-application.h"
 
@@ -45,7 +36,7 @@ namespace ns3
     TypeId
     ContentionBasedFloodingApp::GetTypeId(void)
     {
-        static TypeId tid = TypeId("ns3::ContentionBasedFloodingApp")
+        static TypeId tid = AddAoiAttributes(TypeId("ns3::ContentionBasedFloodingApp")
                                 .SetParent<Application>()
                                 .SetGroupName("Applications")
                                 .AddConstructor<ContentionBasedFloodingApp>()
@@ -69,6 +60,18 @@ namespace ns3
                                               DoubleValue(500.0),
                                               MakeDoubleAccessor(&ContentionBasedFloodingApp::m_maxDistance),
                                               MakeDoubleChecker<double>(0.0))
+                                .AddAttribute("HeaderFormat", "Wire format of the headers sent",
+                                              EnumValue(FloodingHeaderCodec::COMPACT),
+                                              MakeEnumAccessor(&ContentionBasedFloodingApp::m_headerFormat),
+                                              MakeEnumChecker(FloodingHeaderCodec::COMPACT, "Compact",
+                                                              FloodingHeaderCodec::FIXED, "Fixed"))
+                                .AddAttribute("Transport",
+                                              "Udp broadcasts over IPv4, or Packet to send the frames straight on the link layer "
+                                              "of the first non-loopback device, with a dedicated EtherType",
+                                              EnumValue(UDP_TRANSPORT),
+                                              MakeEnumAccessor(&ContentionBasedFloodingApp::m_transport),
+                                              MakeEnumChecker(UDP_TRANSPORT, "Udp",
+                                                              PACKET_TRANSPORT, "Packet"))
                                 .AddTraceSource("Rx", "A packet has been received",
                                                 MakeTraceSourceAccessor(&ContentionBasedFloodingApp::m_rxTrace),
                                                 "ns3::Packet::TracedCallback")
@@ -80,176 +83,19 @@ namespace ns3
                                                 "ns3::Packet::TracedCallback")
                                 .AddTraceSource("Fwd", "A packet has been Forwarded",
                                                 MakeTraceSourceAccessor(&ContentionBasedFloodingApp::m_fwdTrace),
-                                                "ns3::Packet::TracedCallback");
+                                                "ns3::Packet::TracedCallback"));
         return tid;
     }
 
     ContentionBasedFloodingApp::ContentionBasedFloodingApp()
+        : FloodingApp("ContentionBasedFloodingApp")
     {
         NS_LOG_FUNCTION(this);
-        m_socket = 0;
     }
 
     ContentionBasedFloodingApp::~ContentionBasedFloodingApp()
     {
         NS_LOG_FUNCTION(this);
-        m_socket = 0;
-    }
-
-    void
-    ContentionBasedFloodingApp::DoDispose(void)
-    {
-        NS_LOG_FUNCTION(this);
-        Application::DoDispose();
-    }
-
-    void
-    ContentionBasedFloodingApp::StartApplication(void)
-    {
-        NS_LOG_FUNCTION(this);
-
-        if (m_socket == 0)
-        {
-            TypeId tid = TypeId::LookupByName("ns3::UdpSocketFactory");
-            m_socket = Socket::CreateSocket(GetNode(), tid);
-            InetSocketAddress local = InetSocketAddress(Ipv4Address::GetAny(), m_port);
-            if (m_socket->Bind(local) == -1)
-            {
-                NS_FATAL_ERROR("Failed to bind socket");
-            }
-            if (addressUtils::IsMulticast(m_local))
-            {
-                Ptr<UdpSocket> udpSocket = DynamicCast<UdpSocket>(m_socket);
-                if (udpSocket)
-                {
-                    // equivalent to setsockopt (MCAST_JOIN_GROUP)
-                    udpSocket->MulticastJoinGroup(0, m_local);
-                }
-                else
-                {
-                    NS_FATAL_ERROR("Error: Failed to join multicast group");
-                }
-            }
-
-            InetSocketAddress remote = InetSocketAddress(Ipv4Address("255.255.255.255"), 3000);
-            m_socket->SetAllowBroadcast(true);
-            m_socket->Connect(remote);
-            ScheduleTransmit(m_sendInterval);
-        }
-
-        m_socket->SetRecvCallback(MakeCallback(&ContentionBasedFloodingApp::HandleRead, this));
-    }
-
-    void
-    ContentionBasedFloodingApp::StopApplication()
-    {
-        NS_LOG_FUNCTION(this);
-
-        if (m_socket != 0)
-        {
-            m_socket->Close();
-            m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
-        }
-    }
-
-    void
-    ContentionBasedFloodingApp::ScheduleTransmit(Time dt)
-    {
-        NS_LOG_FUNCTION(this << dt);
-        m_sendEvent = Simulator::Schedule(dt, &ContentionBasedFloodingApp::Send, this);
-    }
-
-    void ContentionBasedFloodingApp::Forward(Ptr<Packet> packet, string pkt_id)
-    {
-        if (std::find(twiceSeenSeqNos.begin(), twiceSeenSeqNos.end(), pkt_id) == twiceSeenSeqNos.end())
-        {
-            m_socket->Send(packet);
-            m_fwdTrace(packet, GetNode()->GetId());
-        }
-    }
-
-    void
-    ContentionBasedFloodingApp::Send(void)
-    {
-        NS_LOG_FUNCTION(this);
-
-        NS_ASSERT(m_sendEvent.IsExpired());
-        Address localAddress;
-        m_socket->GetSockName(localAddress);
-
-        Ptr<Packet> p = Create<Packet>(m_dataSize);
-        uint32_t nodeId = GetNode()->GetId();
-
-        Vector nodePos = GetNode()->GetObject<MobilityModel>()->GetPosition();
-
-        ContentionBasedFloodingHeader header;
-        header.SetSeq(this->seqNo++);
-        header.SetSrc(nodeId);
-        header.SetLastHop(nodeId);
-        header.SetLastPos(nodePos);
-        header.SetStartPos(nodePos);
-        p->AddHeader(header);
-        m_txTrace(p, GetNode()->GetId());
-        m_socket->Send(p);
-        ScheduleTransmit(m_sendInterval);
-
-        string pkt_id = to_string(GetNode()->GetId()) + "-" + to_string(header.GetSeq());
-        seenSeqNos.push_back(pkt_id);
-    }
-
-    void
-    ContentionBasedFloodingApp::HandleRead(Ptr<Socket> socket)
-    {
-        NS_LOG_FUNCTION(this << socket);
-
-        Ptr<Packet> packet;
-        Address from;
-        Address localAddress;
-        while ((packet = socket->RecvFrom(from)))
-        {
-            socket->GetSockName(localAddress);
-            Ptr<Packet> packetCopy = packet->Copy();
-            packetCopy->RemoveAllPacketTags();
-            packetCopy->RemoveAllByteTags();
-            ContentionBasedFloodingHeader header;
-            packetCopy->RemoveHeader(header);
-
-            Vector nodePos = GetNode()->GetObject<MobilityModel>()->GetPosition();
-            double dist_sender = CalculateDistance(header.GetStartPos(), nodePos);
-            double dist_sender_lastHop = CalculateDistance(header.GetStartPos(), header.GetLastPos());
-            double advance = dist_sender - dist_sender_lastHop;
-
-            header.SetNumHops(header.GetNumHops() + 1);
-            header.SetLastHop(GetNode()->GetId());
-            header.SetLastPos(nodePos);
-
-            packetCopy->AddHeader(header);
-
-            string pkt_id = to_string(header.GetSrc()) + "-" + to_string(header.GetSeq());
-
-            if (std::find(seenSeqNos.begin(), seenSeqNos.end(), pkt_id) == seenSeqNos.end())
-            {
-                m_rxTrace(packet, GetNode()->GetId());
-                m_rxTraceWithAddresses(packet, from, localAddress);
-                double scale = (1.0 - (advance / m_maxDistance));
-
-                if (scale < 0)
-                {
-                    scale = 1.0;
-                }
-
-                Time delay = m_forwardingJitter * scale;
-                Simulator::Schedule(delay, &ContentionBasedFloodingApp::Forward, this, packetCopy, pkt_id);
-                seenSeqNos.push_back(pkt_id);
-            }
-            else
-            {
-                if (std::find(twiceSeenSeqNos.begin(), twiceSeenSeqNos.end(), pkt_id) == twiceSeenSeqNos.end())
-                {
-                    twiceSeenSeqNos.push_back(pkt_id);
-                }
-            }
-        }
     }
 
 } // Namespace ns3
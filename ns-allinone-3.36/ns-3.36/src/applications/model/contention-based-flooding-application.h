@@ -19,73 +19,64 @@
 #ifndef CONTENTION_BASED_FLOODING_APP_H
 #define CONTENTION_BASED_FLOODING_APP_H
 
-#include <algorithm>
-#include "ns3/application.h"
-#include "ns3/event-id.h"
-#include "ns3/ptr.h"
-#include "ns3/address.h"
-#include "ns3/seq-ts-header.h"
-#include "ns3/traced-callback.h"
 #include "ns3/contention-based-flooding-header.h"
+#include "ns3/flooding-app.h"
+#include "ns3/flooding-policies.h"
 #include "ns3/core-module.h"
 #include "ns3/mobility-module.h"
 
 namespace ns3
 {
 
-  class Socket;
-  class Packet;
+  template <>
+  struct FloodingHeaderTraits<ContentionBasedFloodingHeader>
+  {
+    static FloodingUpdate Read(ContentionBasedFloodingHeader &header)
+    {
+      FloodingUpdate update;
+      update.src = header.GetSrc();
+      update.seq = header.GetSeq();
+      update.lastHop = header.GetLastHop();
+      update.numHops = header.GetNumHops();
+      update.ts = header.GetTs();
+      update.startPos = header.GetStartPos();
+      update.lastPos = header.GetLastPos();
+      return update;
+    }
+
+    static void Write(ContentionBasedFloodingHeader &header, const FloodingUpdate &update, FloodingHeaderCodec::Format format)
+    {
+      header.SetFormat(format);
+      header.SetSeq(update.seq);
+      header.SetSrc(update.src);
+      header.SetLastHop(update.lastHop);
+      header.SetNumHops(update.numHops);
+      header.SetTs(update.ts);
+      header.SetLastPos(update.lastPos);
+      header.SetStartPos(update.startPos);
+    }
+
+    static void SetForwarder(ContentionBasedFloodingHeader &header, uint32_t numHops, uint32_t nodeId, Vector nodePos)
+    {
+      header.SetNumHops(numHops);
+      header.SetLastHop(nodeId);
+      header.SetLastPos(nodePos);
+    }
+  };
 
-  class ContentionBasedFloodingApp : public Application
+  /**
+   * Contention-based flooding: the nodes farther from the last hop forward
+   * first, and an update heard again before its forwarding timer fires is
+   * not forwarded.
+   */
+  class ContentionBasedFloodingApp : public FloodingApp<ContentionOnlyForwardPolicy,
+                                                        ContentionDelayPolicy,
+                                                        PlainCodingPolicy<ContentionBasedFloodingHeader>>
   {
   public:
     static TypeId GetTypeId(void);
     ContentionBasedFloodingApp();
     virtual ~ContentionBasedFloodingApp();
-
-  protected:
-    virtual void DoDispose(void);
-
-  private:
-    virtual void StartApplication(void);
-    virtual void StopApplication(void);
-
-    void ScheduleTransmit(Time dt);
-
-    void Send(void);
-
-    void Forward(Ptr<Packet> packet, std::string pkt_id);
-
-    void HandleRead(Ptr<Socket> socket);
-
-    int seqNo = 0;
-
-    double m_maxDistance = 509.003;
-
-    Time m_sendInterval = Seconds(1);
-    Time m_forwardingJitter = Seconds(0.1);
-
-    uint32_t m_dataSize = 100;                              //!< packet payload size (must be equal to m_size)
-    uint16_t m_port;                                        //!< Port on which we listen for incoming packets.
-    Ptr<Socket> m_socket;                                   //!< IPv4 Socket
-    Address m_local;                                        //!< local multicast address
-    EventId m_sendEvent;                                    //!< Event to send the next packet
-    Address m_peerAddress = Ipv4Address("255.255.255.255"); //!< Remote peer address
-    uint16_t m_peerPort = 300;                              //!< Remote peer port
-    std::vector<std::string> seenSeqNos;
-    std::vector<std::string> twiceSeenSeqNos;
-
-    /// Callbacks for tracing the packet Rx events
-    TracedCallback<Ptr<const Packet>, uint32_t> m_rxTrace;
-
-    /// Callbacks for tracing the packet Tx events
-    TracedCallback<Ptr<const Packet>, uint32_t> m_txTrace;
-
-    /// Callbacks for tracing the packet Fwd events
-    TracedCallback<Ptr<const Packet>, uint32_t> m_fwdTrace;
-
-    /// Callbacks for tracing the packet Rx events, includes source and destination addresses
-    TracedCallback<Ptr<const Packet>, const Address &, const Address &> m_rxTraceWithAddresses;
   };
 
 } // namespace ns3
@@ -88,6 +88,16 @@ namespace ns3
         this->ts = ts.GetTimeStep();
     }
 
+    void ContentionBasedFloodingHeader::SetFormat(FloodingHeaderCodec::Format format)
+    {
+        this->format = format;
+    }
+
+    FloodingHeaderCodec::Format ContentionBasedFloodingHeader::GetFormat(void) const
+    {
+        return format;
+    }
+
     TypeId ContentionBasedFloodingHeader::GetTypeId(void)
     {
         static TypeId tid = TypeId("ns3::ContentionBasedFloodingHeader")
@@ -109,19 +119,46 @@ namespace ns3
     uint32_t ContentionBasedFloodingHeader::GetSerializedSize(void) const
     {
         NS_LOG_FUNCTION(this);
-        return 4        // seq
-               + 8      // ts
-               + 8      // src
-               + 8      // lastHop
-               + 8      // numHops
-               + 3 * 8  // startPos
-               + 3 * 8; // lastPos
+        using namespace FloodingHeaderCodec;
+        if (format == FIXED) {
+            return 1        // version
+                   + 4      // seq
+                   + 8      // ts
+                   + 4      // src
+                   + 4      // lastHop
+                   + 4      // numHops
+                   + 3 * 4  // startPos
+                   + 3 * 4; // lastPos
+        }
+        QuantizedPosition startQ = Quantize(start_pos);
+        return 1        // version
+               + GetVarintSize(seq)
+               + GetVarintSize(src)
+               + GetVarintSize(lastHop)
+               + GetVarintSize(numHops)
+               + 4      // ts
+               + GetPositionSize(startQ)
+               + GetPositionSize(Quantize(last_pos), startQ);
     }
 
     void ContentionBasedFloodingHeader::Serialize(Buffer::Iterator start) const
     {
         NS_LOG_FUNCTION(this << &start);
+        using namespace FloodingHeaderCodec;
         Buffer::Iterator i = start;
+        i.WriteU8(format);
+        if (format == COMPACT) {
+            WriteVarint(i, seq);
+            WriteVarint(i, src);
+            WriteVarint(i, lastHop);
+            WriteVarint(i, numHops);
+            WriteTimestamp(i, ts);
+            // The last position is sent relative to the start position
+            QuantizedPosition startQ = Quantize(start_pos);
+            WritePosition(i, startQ);
+            WritePosition(i, Quantize(last_pos), startQ);
+            return;
+        }
         i.WriteHtonU32(seq);
         i.WriteHtonU64(ts);
         i.WriteHtonU32(src);
@@ -148,7 +185,22 @@ namespace ns3
     uint32_t ContentionBasedFloodingHeader::Deserialize(Buffer::Iterator start)
     {
         NS_LOG_FUNCTION(this << &start);
+        using namespace FloodingHeaderCodec;
         Buffer::Iterator i = start;
+        uint8_t version = i.ReadU8();
+        NS_ASSERT_MSG(version == FIXED || version == COMPACT, "Unknown header version " << +version);
+        format = static_cast<Format>(version);
+        if (format == COMPACT) {
+            seq = ReadVarint(i);
+            src = ReadVarint(i);
+            lastHop = ReadVarint(i);
+            numHops = ReadVarint(i);
+            ts = ReadTimestamp(i);
+            QuantizedPosition startQ = ReadPosition(i);
+            start_pos = Dequantize(startQ);
+            last_pos = Dequantize(ReadPosition(i, startQ));
+            return i.GetDistanceFrom(start);
+        }
         seq = i.ReadNtohU32();
         ts = i.ReadNtohU64();
         src = i.ReadNtohU32();
@@ -165,7 +217,7 @@ namespace ns3
         uint32_t last_pos_z = i.ReadNtohU32();
         last_pos = Vector(last_pos_x, last_pos_y, last_pos_z);
 
-        return GetSerializedSize();
+        return i.GetDistanceFrom(start);
     }
 
 } // namespace ns3
@@ -25,6 +25,7 @@
 #include "ns3/nstime.h"
 #include "ns3/mobility-module.h"
 #include "ns3/core-module.h"
+#include "flooding-header-codec.h"
 
 namespace ns3
 {
@@ -50,12 +51,24 @@ namespace ns3
         void SetLastPos (Vector pos);
         Vector GetLastPos ();
 
+        /**
+         * Select the wire format written by Serialize. Deserialize reads the
+         * format from the version byte.
+         */
+        void SetFormat (FloodingHeaderCodec::Format format);
+        FloodingHeaderCodec::Format GetFormat (void) const;
+
         static TypeId GetTypeId(void);
 
         virtual TypeId GetInstanceTypeId(void) const;
         virtual void Print(std::ostream &os) const;
         virtual uint32_t GetSerializedSize(void) const;
         virtual void Serialize(Buffer::Iterator start) const;
+        /**
+         * In the COMPACT format, the timestamps are rebuilt relative to
+         * Simulator::Now(), see FloodingHeaderCodec::ReadTimestamp: only
+         * deserialize received frames, during the simulation.
+         */
         virtual uint32_t Deserialize(Buffer::Iterator start);
 
     private:
@@ -66,6 +79,7 @@ namespace ns3
         uint64_t ts = 0;
         Vector start_pos = Vector(0, 0, 0);
         Vector last_pos = Vector(0, 0, 0);
+        FloodingHeaderCodec::Format format = FloodingHeaderCodec::COMPACT;
 
         
     };
@@ -0,0 +1,157 @@
+#include "duplicate-filter.h"
+#include "ns3/assert.h"
+#include <algorithm>
+
+namespace ns3
+{
+    DuplicateFilter::DuplicateFilter(uint32_t windowSize)
+        : m_windowSize(((windowSize + 63) / 64) * 64)
+    {
+        NS_ASSERT(windowSize > 0);
+    }
+
+    DuplicateFilter::Position DuplicateFilter::Locate(const Window &window, uint32_t seq) const
+    {
+        // Serial number arithmetic, so that wrapping sequence numbers work
+        if (static_cast<int32_t>(seq - window.highest) > 0)
+        {
+            return AHEAD;
+        }
+        return window.highest - seq < m_windowSize ? INSIDE : BEHIND;
+    }
+
+    DuplicateFilter::Window &DuplicateFilter::Advance(uint32_t src, uint32_t seq)
+    {
+        auto it = m_windows.find(src);
+        if (it == m_windows.end())
+        {
+            Window &window = m_windows[src];
+            window.highest = seq;
+            window.seen.assign(m_windowSize / 64, 0);
+            window.twice.assign(m_windowSize / 64, 0);
+            return window;
+        }
+        Window &window = it->second;
+        if (Locate(window, seq) == AHEAD)
+        {
+            uint32_t delta = seq - window.highest;
+            if (delta >= m_windowSize)
+            {
+                std::fill(window.seen.begin(), window.seen.end(), 0);
+                std::fill(window.twice.begin(), window.twice.end(), 0);
+            }
+            else
+            {
+                // Recycle the slots of the sequence numbers leaving the window
+                for (uint32_t s = window.highest + 1; s != seq + 1; s++)
+                {
+                    uint32_t bit = s % m_windowSize;
+                    window.seen[bit / 64] &= ~(uint64_t(1) << (bit % 64));
+                    window.twice[bit / 64] &= ~(uint64_t(1) << (bit % 64));
+                }
+            }
+            window.highest = seq;
+        }
+        return window;
+    }
+
+    bool DuplicateFilter::TestBit(const std::vector<uint64_t> &bitmap, uint32_t bit)
+    {
+        return (bitmap[bit / 64] >> (bit % 64)) & 1;
+    }
+
+    void DuplicateFilter::SetBit(std::vector<uint64_t> &bitmap, uint32_t bit)
+    {
+        bitmap[bit / 64] |= uint64_t(1) << (bit % 64);
+    }
+
+    bool DuplicateFilter::IsSeen(uint32_t src, uint32_t seq) const
+    {
+        auto it = m_windows.find(src);
+        if (it == m_windows.end())
+        {
+            return false;
+        }
+        switch (Locate(it->second, seq))
+        {
+        case AHEAD:
+            return false;
+        case BEHIND:
+            return true;
+        default:
+            return TestBit(it->second.seen, seq % m_windowSize);
+        }
+    }
+
+    bool DuplicateFilter::IsSeenTwice(uint32_t src, uint32_t seq) const
+    {
+        auto it = m_windows.find(src);
+        if (it == m_windows.end())
+        {
+            return false;
+        }
+        switch (Locate(it->second, seq))
+        {
+        case AHEAD:
+            return false;
+        case BEHIND:
+            return true;
+        default:
+            return TestBit(it->second.twice, seq % m_windowSize);
+        }
+    }
+
+    bool DuplicateFilter::MarkSeen(uint32_t src, uint32_t seq)
+    {
+        auto it = m_windows.find(src);
+        if (it != m_windows.end() && Locate(it->second, seq) == BEHIND)
+        {
+            return false;
+        }
+        Window &window = Advance(src, seq);
+        uint32_t bit = seq % m_windowSize;
+        if (TestBit(window.seen, bit))
+        {
+            return false;
+        }
+        SetBit(window.seen, bit);
+        return true;
+    }
+
+    void DuplicateFilter::MarkSeenTwice(uint32_t src, uint32_t seq)
+    {
+        auto it = m_windows.find(src);
+        if (it != m_windows.end() && Locate(it->second, seq) == BEHIND)
+        {
+            return;
+        }
+        Window &window = Advance(src, seq);
+        uint32_t bit = seq % m_windowSize;
+        SetBit(window.seen, bit);
+        SetBit(window.twice, bit);
+    }
+
+    void DuplicateFilter::Remove(uint32_t src)
+    {
+        m_windows.erase(src);
+    }
+
+    void DuplicateFilter::Clear()
+    {
+        m_windows.clear();
+    }
+
+    size_t DuplicateFilter::GetNSources() const
+    {
+        return m_windows.size();
+    }
+
+    size_t DuplicateFilter::GetMemoryFootprint() const
+    {
+        // Hash table buckets, one node per source (key, value and next
+        // pointer) and the two bitmaps of every source
+        size_t perSource = sizeof(std::pair<const uint32_t, Window>) + sizeof(void *) + 2 * m_windowSize / 8;
+        return m_windows.bucket_count() * sizeof(void *) + m_windows.size() * perSource;
+    }
+
+} // namespace ns3
@@ -0,0 +1,86 @@
+#ifndef DUPLICATE_FILTER_H
+#define DUPLICATE_FILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+    /**
+     * Tracks which (source, sequence number) pairs have been seen once or
+     * more than once.
+     *
+     * For every source, only the last windowSize sequence numbers up to the
+     * highest one seen are tracked, in two bitmaps. Insertion and lookup are
+     * O(1). Sequence numbers older than the window are reported as seen (and
+     * seen twice), so that stale packets are suppressed.
+     */
+    class DuplicateFilter
+    {
+    public:
+        /**
+         * \param windowSize number of sequence numbers tracked per source,
+         *        rounded up to a multiple of 64
+         */
+        explicit DuplicateFilter(uint32_t windowSize = 1024);
+
+        bool IsSeen(uint32_t src, uint32_t seq) const;
+        bool IsSeenTwice(uint32_t src, uint32_t seq) const;
+
+        /**
+         * Mark the packet as seen.
+         * \returns false if the packet was already seen
+         */
+        bool MarkSeen(uint32_t src, uint32_t seq);
+
+        /**
+         * Mark the packet as seen twice. The packet is also marked as seen.
+         */
+        void MarkSeenTwice(uint32_t src, uint32_t seq);
+
+        /**
+         * Forget all the packets of the given source.
+         */
+        void Remove(uint32_t src);
+
+        void Clear();
+
+        /**
+         * \returns the number of sources currently tracked
+         */
+        size_t GetNSources() const;
+
+        /**
+         * \returns an estimate of the heap memory used by the filter, in bytes
+         */
+        size_t GetMemoryFootprint() const;
+
+    private:
+        struct Window
+        {
+            uint32_t highest = 0;          //!< highest sequence number seen
+            std::vector<uint64_t> seen;    //!< bitmap indexed by seq % windowSize
+            std::vector<uint64_t> twice;   //!< bitmap indexed by seq % windowSize
+        };
+
+        enum Position
+        {
+            AHEAD,     //!< newer than the highest sequence number seen
+            INSIDE,    //!< within the window
+            BEHIND     //!< older than the window
+        };
+
+        Position Locate(const Window &window, uint32_t seq) const;
+        Window &Advance(uint32_t src, uint32_t seq);
+        static bool TestBit(const std::vector<uint64_t> &bitmap, uint32_t bit);
+        static void SetBit(std::vector<uint64_t> &bitmap, uint32_t bit);
+
+        uint32_t m_windowSize;
+        std::unordered_map<uint32_t, Window> m_windows;
+    };
+
+} // namespace ns3
+
+#endif /* DUPLICATE_FILTER_H */
@@ -0,0 +1,987 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FLOODING_APP_H
+#define FLOODING_APP_H
+
+#include <algorithm>
+#include <vector>
+#include "ns3/application.h"
+#include "ns3/address.h"
+#include "ns3/address-utils.h"
+#include "ns3/double.h"
+#include "ns3/event-id.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/log.h"
+#include "ns3/loopback-net-device.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/packet-socket-address.h"
+#include "ns3/packet-socket-factory.h"
+#include "ns3/ptr.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/udp-socket.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/traced-callback.h"
+#include "ns3/traced-value.h"
+#include "ns3/uinteger.h"
+#include "ns3/vector.h"
+#include "ns3/aoi-histogram.h"
+#include "ns3/duplicate-filter.h"
+#include "ns3/flooding-counters.h"
+#include "ns3/flooding-header-codec.h"
+#include "ns3/position-snapshot.h"
+
+namespace ns3
+{
+
+  /**
+   * Fields of a flooded update, independent of the header carrying it.
+   */
+  struct FloodingUpdate
+  {
+    uint32_t src = 0;
+    uint32_t seq = 0;
+    uint32_t lastHop = 0;
+    uint32_t numHops = 0;
+    Time ts;
+    Vector startPos = Vector(0, 0, 0);
+    Vector lastPos = Vector(0, 0, 0);
+  };
+
+  /**
+   * Transport of the flooding frames
+   */
+  enum FloodingTransport
+  {
+    UDP_TRANSPORT,      //!< UDP broadcast over IPv4
+    PACKET_TRANSPORT    //!< PacketSocket on the link layer, with FLOODING_ETHER_TYPE
+  };
+
+  /// EtherType of the frames of PACKET_TRANSPORT (IEEE local experimental)
+  const uint16_t FLOODING_ETHER_TYPE = 0x88B5;
+
+  /**
+   * Conversions between a header and a FloodingUpdate, to be specialized
+   * for every header sent by PlainCodingPolicy:
+   *
+   * - static FloodingUpdate Read(Header &header)
+   * - static void Write(Header &header, const FloodingUpdate &update, FloodingHeaderCodec::Format format)
+   * - static void SetForwarder(Header &header, uint32_t numHops, uint32_t nodeId, Vector nodePos)
+   *   updates the fields that change when the node forwards the packet
+   */
+  template <class Header>
+  struct FloodingHeaderTraits;
+
+  /**
+   * Engine shared by the flooding applications.
+   *
+   * The engine sends an update every SendInterval, receives the frames,
+   * filters the duplicates, accounts the age of information and keeps the
+   * statistics. What differs between the flooding schemes is delegated at
+   * compile time to three policies, which are members of the engine and
+   * its friends:
+   *
+   * - ForwardPolicy decides whether a new update is scheduled for
+   *   forwarding, whether it is sent when its timer fires, and what a
+   *   duplicate does.
+   * - DelayPolicy gives the forwarding delay.
+   * - CodingPolicy owns the wire format: it decodes the received frames
+   *   into updates, builds the packets and transmits them, possibly
+   *   combining several updates in one frame.
+   *
+   * Each policy declares a SourceData struct, kept for every source next
+   * to the state of the engine, and implements the hooks called below (see
+   * FloodingPolicy). The concrete applications derive from
+   * an instance of the engine and only register their TypeId.
+   */
+  template <class ForwardPolicy, class DelayPolicy, class CodingPolicy>
+  class FloodingApp : public Application
+  {
+  public:
+    virtual ~FloodingApp();
+
+    void LogPerformance() {
+      NS_LOG_UNCOND("PERFORMANCE: " << numSeenNodes << " " << numUpdatesReceivedInTime << " " << numUpdatesReceivedLate);
+    };
+
+    int GetNumUpdatesReceivedInTime();
+    int GetNumUpdatesReceivedLate();
+    int GetNumSeenNodes();
+    int GetNumSent();
+    int GetNumFwd();
+    int GetNumRcvd();
+    /// \returns the number of forwarding timers which expired
+    uint64_t GetNumForwardTimersFired();
+    /// \returns the number of forwarding timers cancelled by a duplicate
+    uint64_t GetNumForwardTimersCancelled();
+
+    /**
+     * \returns the AoI of the updates received since the last ResetStats
+     */
+    const AoiHistogram &GetAoiHistogram() const;
+
+    /**
+     * \returns an estimate of the memory (bytes) used by the per-source state
+     */
+    uint64_t GetMemoryFootprint() const;
+
+    void ResetStats();
+
+    /**
+     * Also count the metrics of the application in shared counters, e.g.
+     * those of all the nodes of a simulation.
+     *
+     * \param counters the counters, or nullptr to stop counting in them
+     */
+    void SetCounters(Ptr<FloodingCounters> counters);
+
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by this model.  Return the number of streams (possibly zero) that
+     * have been assigned.
+     *
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this model
+     */
+    int64_t AssignStreams(int64_t stream);
+
+  protected:
+    /**
+     * \param logComponent name of the log component of the application
+     */
+    explicit FloodingApp(const char *logComponent);
+
+    /**
+     * Add the attributes of the AoI histogram and the Aoi trace source,
+     * which all the flooding applications have, to their TypeId.
+     *
+     * \param tid the TypeId of the application
+     * \returns tid
+     */
+    static TypeId AddAoiAttributes(TypeId tid);
+
+    virtual void DoDispose(void);
+
+    /**
+     * State kept for every source heard recently
+     */
+    struct SourceState
+    {
+      uint32_t src = 0;
+      Time lastActivity;
+      Time lastReceived;
+      bool hasLastReceived = false;
+      EventId forwardEvent;                     //!< latest forwarding timer of the source
+      uint32_t forwardSeq = 0;                  //!< sequence number forwarded by forwardEvent
+      typename ForwardPolicy::SourceData forward;
+      typename DelayPolicy::SourceData delay;
+      typename CodingPolicy::SourceData coding;
+    };
+
+    ForwardPolicy m_forward;
+    DelayPolicy m_delay;
+    CodingPolicy m_coding;
+
+    int seqNo = 0;
+
+    double m_maxDistance = 509.003;
+    FloodingHeaderCodec::Format m_headerFormat = FloodingHeaderCodec::COMPACT;
+    FloodingTransport m_transport = UDP_TRANSPORT;
+
+    Time m_aoiThreshold = Seconds(0.73573573573);
+    Time m_sendInterval = Seconds(1);
+    Time m_forwardingJitter = Seconds(0.1);
+    Time m_stateLifetime;                                   //!< time without activity before a state is dropped
+
+    double m_aoiRingWidth = 100.0;
+    uint32_t m_aoiRings = 6;
+    uint32_t m_aoiHops = 8;
+
+    uint32_t m_dataSize = 100;                              //!< packet payload size (must be equal to m_size)
+    uint16_t m_port;                                        //!< Port on which we listen for incoming packets.
+    Ptr<Socket> m_socket;                                   //!< IPv4 Socket
+    Address m_local;                                        //!< local multicast address
+    EventId m_sendEvent;                                    //!< Event to send the next packet
+    EventId m_evictionEvent;
+    Address m_peerAddress = Ipv4Address("255.255.255.255"); //!< Remote peer address
+    uint16_t m_peerPort = 300;                              //!< Remote peer port
+    DuplicateFilter seenPackets;
+
+    std::vector<uint32_t> m_stateIndex;         //!< 1 + index in m_states by source id, 0 if none
+    std::vector<SourceState> m_states;          //!< states of the sources heard recently
+    TracedValue<uint64_t> m_memoryFootprint;
+
+    // Metrics
+    std::vector<bool> seenNodes;
+    int numSeenNodes = 0;
+    int numUpdatesReceivedInTime = 0;
+    int numUpdatesReceivedLate = 0;
+    int numSent = 0;
+    int numReceived = 0;
+    int numForwarded = 0;
+    uint64_t numForwardTimersFired = 0;
+    uint64_t numForwardTimersCancelled = 0;
+    AoiHistogram m_aoiHistogram;
+    Ptr<FloodingCounters> m_counters;           //!< shared counters, if any
+
+    /// Callbacks for tracing the packet Rx events
+    TracedCallback<Ptr<const Packet>, uint32_t> m_rxTrace;
+
+    /// Callbacks for tracing the packet Tx events
+    typename CodingPolicy::TxTracedCallback m_txTrace;
+
+    /// Callbacks for tracing the packet Fwd events
+    typename CodingPolicy::FwdTracedCallback m_fwdTrace;
+
+    /// Callbacks for tracing the packet Rx events, includes source and destination addresses
+    TracedCallback<Ptr<const Packet>, const Address &, const Address &> m_rxTraceWithAddresses;
+
+    /// Callbacks for tracing the AoI samples
+    TracedCallback<uint32_t, double, uint32_t, Time> m_aoiTrace;
+
+    NS_LOG_TEMPLATE_DECLARE;
+
+  private:
+    friend ForwardPolicy;
+    friend DelayPolicy;
+    friend CodingPolicy;
+
+    virtual void StartApplication(void);
+    virtual void StopApplication(void);
+
+    /// Open m_socket for UDP broadcast
+    void OpenUdpSocket();
+    /**
+     * Open m_socket as a PacketSocket on the first device of the node which
+     * is not a loopback, aggregating a PacketSocketFactory to the node if
+     * it has none.
+     */
+    void OpenPacketSocket();
+
+    void ScheduleTransmit(Time dt);
+
+    void Send(void);
+
+    void HandleRead(Ptr<Socket> socket);
+
+    /**
+     * Handle an update decoded by the CodingPolicy.
+     *
+     * \param packet the frame carrying the update
+     * \param update the update, as received
+     * \param from the sender address
+     * \param localAddress the local address
+     * \param isEncodedPacket whether the update was decoded from a coded frame
+     */
+    void OnReceive(Ptr<Packet> packet, const FloodingUpdate &update, const Address &from,
+                   const Address &localAddress, bool isEncodedPacket);
+
+    /**
+     * Forwarding timer of an update.
+     *
+     * \param packet the packet returned by CodingPolicy::Enqueue, if any
+     */
+    void Forward(uint32_t src, uint32_t seq, Ptr<Packet> packet);
+
+    /**
+     * Remove the forwarding timer of the update from the event queue, if
+     * it is still pending, and release what the CodingPolicy keeps for it.
+     */
+    void CancelForward(uint32_t src, uint32_t seq);
+
+    /// \returns the state of the source, or nullptr if there is none
+    SourceState *FindState(uint32_t src);
+    /// \returns the state of the source, created if needed
+    SourceState &GetState(uint32_t src);
+
+    /**
+     * Drop the state of the sources without activity for StateLifetime,
+     * and reschedule itself.
+     */
+    void EvictStates();
+
+    void UpdateMemoryFootprint();
+  };
+
+  /**
+   * Default hooks of the flooding policies, to inherit from. A policy
+   * hides the defaults it does not want by declaring a hook of the same
+   * name. Only the policy itself is a friend of the FloodingApp, so the
+   * hooks accessing the application are not to be inherited.
+   *
+   * The hooks without a default are, for a ForwardPolicy:
+   * - bool ShouldSchedule(App &, const FloodingUpdate &forwarded, double advance)
+   * - bool ShouldSend(App &, uint32_t src, uint32_t seq)
+   *
+   * for a DelayPolicy:
+   * - Time GetDelay(App &, SourceState &, const FloodingUpdate &received, double advance, bool isEncodedPacket)
+   *
+   * and for a CodingPolicy, the TxTracedCallback and FwdTracedCallback
+   * types and Decode, MakeOriginal, TraceTx, GetRxPacket, Enqueue, Transmit,
+   * Release and GetMemoryFootprint, see PlainCodingPolicy.
+   */
+  struct FloodingPolicy
+  {
+    struct SourceData
+    {
+    };
+
+    /// Called by StartApplication
+    template <class App>
+    void Start(App &app)
+    {
+    }
+
+    /// Called by DoDispose
+    template <class App>
+    void Dispose(App &app)
+    {
+    }
+
+    /// Called for every new update, once its age is accounted
+    template <class App, class State>
+    void OnReceived(App &app, State &state, const FloodingUpdate &update)
+    {
+    }
+
+    /**
+     * Called for every update received again.
+     *
+     * \returns true if the pending forwarding of the update is suppressed
+     */
+    template <class App>
+    bool OnDuplicate(App &app, const FloodingUpdate &update, bool isEncodedPacket)
+    {
+      return false;
+    }
+
+    /// \returns true to keep the state of an inactive source past the horizon
+    template <class Data>
+    bool IsActive(const Data &data, Time horizon) const
+    {
+      return false;
+    }
+
+    void ResetStats()
+    {
+    }
+
+    /// \returns the number of random variable streams assigned
+    int64_t AssignStreams(int64_t stream)
+    {
+      return 0;
+    }
+  };
+
+  /**
+   * CodingPolicy sending every update in its own packet, with the given
+   * header. The packet to forward travels with the forwarding timer.
+   */
+  template <class Header>
+  struct PlainCodingPolicy : public FloodingPolicy
+  {
+    typedef TracedCallback<Ptr<const Packet>, uint32_t> TxTracedCallback;
+    typedef TracedCallback<Ptr<const Packet>, uint32_t> FwdTracedCallback;
+
+    template <class App>
+    void Decode(App &app, Ptr<Packet> packet, const Address &from, const Address &localAddress)
+    {
+      Header header;
+      packet->PeekHeader(header);
+      app.OnReceive(packet, FloodingHeaderTraits<Header>::Read(header), from, localAddress, false);
+    }
+
+    template <class App>
+    Ptr<Packet> MakeOriginal(App &app, const FloodingUpdate &update)
+    {
+      Ptr<Packet> p = Create<Packet>(app.m_dataSize);
+      Header header;
+      FloodingHeaderTraits<Header>::Write(header, update, app.m_headerFormat);
+      p->AddHeader(header);
+      return p;
+    }
+
+    template <class App>
+    void TraceTx(App &app, Ptr<Packet> packet)
+    {
+      app.m_txTrace(packet, app.GetNode()->GetId());
+    }
+
+    template <class App>
+    Ptr<Packet> GetRxPacket(App &app, Ptr<Packet> received, const FloodingUpdate &update)
+    {
+      return received;
+    }
+
+    /**
+     * \returns a copy of the received packet, with the header updated by
+     *          this hop
+     */
+    template <class App>
+    Ptr<Packet> Enqueue(App &app, typename App::SourceState &state, Ptr<Packet> received, const FloodingUpdate &update)
+    {
+      Ptr<Packet> packetCopy = received->Copy();
+      packetCopy->RemoveAllPacketTags();
+      packetCopy->RemoveAllByteTags();
+      Header header;
+      packetCopy->RemoveHeader(header);
+      uint32_t nodeId = app.GetNode()->GetId();
+      FloodingHeaderTraits<Header>::SetForwarder(header, update.numHops, nodeId, PositionSnapshot::GetPosition(nodeId));
+      packetCopy->AddHeader(header);
+      return packetCopy;
+    }
+
+    template <class App>
+    bool Transmit(App &app, uint32_t src, uint32_t seq, Ptr<Packet> packet)
+    {
+      app.m_socket->Send(packet);
+      app.m_fwdTrace(packet, app.GetNode()->GetId());
+      return true;
+    }
+
+    template <class App>
+    void Release(App &app, uint32_t src)
+    {
+    }
+
+    uint64_t GetMemoryFootprint() const
+    {
+      return 0;
+    }
+  };
+
+  template <class F, class D, class C>
+  FloodingApp<F, D, C>::FloodingApp(const char *logComponent)
+      : NS_LOG_TEMPLATE_DEFINE(logComponent)
+  {
+    NS_LOG_FUNCTION(this);
+    m_socket = 0;
+  }
+
+  template <class F, class D, class C>
+  FloodingApp<F, D, C>::~FloodingApp()
+  {
+    NS_LOG_FUNCTION(this);
+    m_socket = 0;
+  }
+
+  template <class F, class D, class C>
+  void
+  FloodingApp<F, D, C>::DoDispose(void)
+  {
+    NS_LOG_FUNCTION(this);
+    m_coding.Dispose(*this);
+    m_counters = nullptr;
+    Application::DoDispose();
+  }
+
+  template <class F, class D, class C>
+  void
+  FloodingApp<F, D, C>::StartApplication(void)
+  {
+    NS_LOG_FUNCTION(this);
+
+    if (m_socket == 0)
+    {
+      if (m_transport == PACKET_TRANSPORT)
+      {
+        OpenPacketSocket();
+      }
+      else
+      {
+        OpenUdpSocket();
+      }
+      m_aoiHistogram.Configure(m_aoiRingWidth, m_aoiRings, m_aoiHops);
+      ScheduleTransmit(m_sendInterval);
+      m_coding.Start(*this);
+      if (m_stateLifetime.IsStrictlyPositive())
+      {
+        m_evictionEvent = Simulator::Schedule(m_stateLifetime, &FloodingApp::EvictStates, this);
+      }
+    }
+
+    m_socket->SetRecvCallback(MakeCallback(&FloodingApp::HandleRead, this));
+  }
+
+  template <class F, class D, class C>
+  void
+  FloodingApp<F, D, C>::OpenUdpSocket()
+  {
+    TypeId tid = TypeId::LookupByName("ns3::UdpSocketFactory");
+    m_socket = Socket::CreateSocket(GetNode(), tid);
+    InetSocketAddress local = InetSocketAddress(Ipv4Address::GetAny(), m_port);
+    if (m_socket->Bind(local) == -1)
+    {
+      NS_FATAL_ERROR("Failed to bind socket");
+    }
+    if (addressUtils::IsMulticast(m_local))
+    {
+      Ptr<UdpSocket> udpSocket = DynamicCast<UdpSocket>(m_socket);
+      if (udpSocket)
+      {
+        // equivalent to setsockopt (MCAST_JOIN_GROUP)
+        udpSocket->MulticastJoinGroup(0, m_local);
+      }
+      else
+      {
+        NS_FATAL_ERROR("Error: Failed to join multicast group");
+      }
+    }
+
+    InetSocketAddress remote = InetSocketAddress(Ipv4Address("255.255.255.255"), 3000);
+    m_socket->SetAllowBroadcast(true);
+    m_socket->Connect(remote);
+  }
+
+  template <class F, class D, class C>
+  void
+  FloodingApp<F, D, C>::OpenPacketSocket()
+  {
+    Ptr<Node> node = GetNode();
+    Ptr<NetDevice> device;
+    for (uint32_t i = 0; i < node->GetNDevices(); i++)
+    {
+      if (DynamicCast<LoopbackNetDevice>(node->GetDevice(i)) == nullptr)
+      {
+        device = node->GetDevice(i);
+        break;
+      }
+    }
+    if (device == nullptr)
+    {
+      NS_FATAL_ERROR("No device to send the flooding frames on");
+    }
+    if (node->GetObject<PacketSocketFactory>() == nullptr)
+    {
+      node->AggregateObject(CreateObject<PacketSocketFactory>());
+    }
+
+    m_socket = Socket::CreateSocket(node, PacketSocketFactory::GetTypeId());
+    PacketSocketAddress local;
+    local.SetSingleDevice(device->GetIfIndex());
+    local.SetProtocol(FLOODING_ETHER_TYPE);
+    if (m_socket->Bind(local) == -1)
+    {
+      NS_FATAL_ERROR("Failed to bind socket");
+    }
+
+    PacketSocketAddress remote;
+    remote.SetSingleDevice(device->GetIfIndex());
+    remote.SetPhysicalAddress(device->GetBroadcast());
+    remote.SetProtocol(FLOODING_ETHER_TYPE);
+    m_socket->Connect(remote);
+  }
+
+  template <class F, class D, class C>
+  void
+  FloodingApp<F, D, C>::StopApplication()
+  {
+    NS_LOG_FUNCTION(this);
+
+    if (m_socket != 0)
+    {
+      m_socket->Close();
+      m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    }
+    m_evictionEvent.Cancel();
+  }
+
+  template <class F, class D, class C>
+  typename FloodingApp<F, D, C>::SourceState *
+  FloodingApp<F, D, C>::FindState(uint32_t src)
+  {
+    if (src >= m_stateIndex.size() || m_stateIndex[src] == 0)
+    {
+      return nullptr;
+    }
+    return &m_states[m_stateIndex[src] - 1];
+  }
+
+  template <class F, class D, class C>
+  typename FloodingApp<F, D, C>::SourceState &
+  FloodingApp<F, D, C>::GetState(uint32_t src)
+  {
+    SourceState *state = FindState(src);
+    if (state != nullptr)
+    {
+      return *state;
+    }
+    if (src >= m_stateIndex.size())
+    {
+      m_stateIndex.resize(src + 1, 0);
+    }
+    m_states.emplace_back();
+    m_states.back().src = src;
+    m_stateIndex[src] = m_states.size();
+    return m_states.back();
+  }
+
+  template <class F, class D, class C>
+  void
+  FloodingApp<F, D, C>::EvictStates()
+  {
+    NS_LOG_FUNCTION(this);
+    Time horizon = Simulator::Now() - m_stateLifetime;
+    for (size_t i = 0; i < m_states.size();)
+    {
+      SourceState &state = m_states[i];
+      if (state.lastActivity >= horizon || m_delay.IsActive(state.delay, horizon))
+      {
+        i++;
+        continue;
+      }
+      uint32_t src = state.src;
+      m_coding.Release(*this, src);
+      seenPackets.Remove(src);
+      // Move the last state into the freed slot
+      m_stateIndex[src] = 0;
+      if (i != m_states.size() - 1)
+      {
+        m_states[i] = m_states.back();
+        m_stateIndex[m_states[i].src] = i + 1;
+      }
+      m_states.pop_back();
+    }
+    UpdateMemoryFootprint();
+    m_evictionEvent = Simulator::Schedule(m_stateLifetime, &FloodingApp::EvictStates, this);
+  }
+
+  template <class F, class D, class C>
+  TypeId
+  FloodingApp<F, D, C>::AddAoiAttributes(TypeId tid)
+  {
+    return tid.AddAttribute("AoiRingWidth", "Width (m) of the distance rings of the AoI histogram",
+                            DoubleValue(100.0),
+                            MakeDoubleAccessor(&FloodingApp::m_aoiRingWidth),
+                            MakeDoubleChecker<double>(0.0))
+        .AddAttribute("AoiRings", "Number of distance rings of the AoI histogram, the last one is unbounded",
+                      UintegerValue(6),
+                      MakeUintegerAccessor(&FloodingApp::m_aoiRings),
+                      MakeUintegerChecker<uint32_t>(1))
+        .AddAttribute("AoiMaxHops", "Number of hop counts of the AoI histogram, the last one includes the larger counts",
+                      UintegerValue(8),
+                      MakeUintegerAccessor(&FloodingApp::m_aoiHops),
+                      MakeUintegerChecker<uint32_t>(1))
+        .AddTraceSource("Aoi", "The age of the previous update of a source, when a new one is received",
+                        MakeTraceSourceAccessor(&FloodingApp::m_aoiTrace),
+                        "ns3::AoiHistogram::TracedCallback");
+  }
+
+  template <class F, class D, class C>
+  const AoiHistogram &
+  FloodingApp<F, D, C>::GetAoiHistogram() const
+  {
+    return m_aoiHistogram;
+  }
+
+  template <class F, class D, class C>
+  uint64_t
+  FloodingApp<F, D, C>::GetMemoryFootprint() const
+  {
+    return m_stateIndex.capacity() * sizeof(uint32_t)
+        + m_states.capacity() * sizeof(SourceState)
+        + m_coding.GetMemoryFootprint()
+        + seenNodes.capacity() / 8
+        + seenPackets.GetMemoryFootprint();
+  }
+
+  template <class F, class D, class C>
+  void
+  FloodingApp<F, D, C>::UpdateMemoryFootprint()
+  {
+    m_memoryFootprint = GetMemoryFootprint();
+  }
+
+  template <class F, class D, class C>
+  void
+  FloodingApp<F, D, C>::ScheduleTransmit(Time dt)
+  {
+    NS_LOG_FUNCTION(this << dt);
+    m_sendEvent = Simulator::Schedule(dt, &FloodingApp::Send, this);
+  }
+
+  template <class F, class D, class C>
+  void
+  FloodingApp<F, D, C>::Send(void)
+  {
+    NS_LOG_FUNCTION(this);
+
+    NS_ASSERT(m_sendEvent.IsExpired());
+
+    uint32_t nodeId = GetNode()->GetId();
+    Vector nodePos = PositionSnapshot::GetPosition(nodeId);
+
+    FloodingUpdate update;
+    update.seq = this->seqNo++;
+    update.src = nodeId;
+    update.lastHop = nodeId;
+    update.ts = Simulator::Now();
+    update.startPos = nodePos;
+    update.lastPos = nodePos;
+
+    Ptr<Packet> p = m_coding.MakeOriginal(*this, update);
+    m_coding.TraceTx(*this, p);
+    numSent++;
+    if (m_counters)
+    {
+      m_counters->sent++;
+    }
+    m_socket->Send(p);
+    ScheduleTransmit(m_sendInterval);
+
+    seenPackets.MarkSeen(nodeId, update.seq);
+  }
+
+  template <class F, class D, class C>
+  void
+  FloodingApp<F, D, C>::HandleRead(Ptr<Socket> socket)
+  {
+    NS_LOG_FUNCTION(this << socket);
+    Ptr<Packet> packet;
+    Address from;
+    Address localAddress;
+    socket->GetSockName(localAddress);
+
+    while ((packet = socket->RecvFrom(from)))
+    {
+      m_coding.Decode(*this, packet, from, localAddress);
+    }
+  }
+
+  template <class F, class D, class C>
+  void
+  FloodingApp<F, D, C>::OnReceive(Ptr<Packet> packet, const FloodingUpdate &update, const Address &from,
+                                  const Address &localAddress, bool isEncodedPacket)
+  {
+    uint32_t src = update.src;
+    uint32_t seq = update.seq;
+    Vector nodePos = PositionSnapshot::GetPosition(GetNode()->GetId());
+    double dist_sender = CalculateDistance(update.startPos, nodePos);
+    double dist_sender_lastHop = CalculateDistance(update.startPos, update.lastPos);
+    double advance = dist_sender - dist_sender_lastHop;
+
+    if (seenPackets.IsSeen(src, seq))
+    {
+      if (m_forward.OnDuplicate(*this, update, isEncodedPacket))
+      {
+        CancelForward(src, seq);
+      }
+      return;
+    }
+
+    if (src >= seenNodes.size())
+    {
+      seenNodes.resize(src + 1, false);
+    }
+    if (!seenNodes[src])
+    {
+      seenNodes[src] = true;
+      numSeenNodes++;
+      if (m_counters)
+      {
+        m_counters->seenPairs++;
+      }
+    }
+    SourceState &state = GetState(src);
+    state.lastActivity = Simulator::Now();
+    if (state.hasLastReceived)
+    {
+      // Age of the previous update of the source, when replaced
+      Time aoi = Simulator::Now() - state.lastReceived;
+      m_aoiHistogram.Record(dist_sender, update.numHops, aoi);
+      m_aoiTrace(src, dist_sender, update.numHops, aoi);
+      if (dist_sender <= m_maxDistance)
+      {
+        if (aoi > m_aoiThreshold)
+        {
+          numUpdatesReceivedLate++;
+          if (m_counters)
+          {
+            m_counters->receivedLate++;
+          }
+        }
+        else
+        {
+          numUpdatesReceivedInTime++;
+          if (m_counters)
+          {
+            m_counters->receivedInTime++;
+          }
+        }
+      }
+    }
+
+    m_coding.OnReceived(*this, state, update);
+
+    state.lastReceived = update.ts;
+    state.hasLastReceived = true;
+
+    if (!m_rxTrace.IsEmpty() || !m_rxTraceWithAddresses.IsEmpty())
+    {
+      Ptr<Packet> rxPacket = m_coding.GetRxPacket(*this, packet, update);
+      m_rxTrace(rxPacket, GetNode()->GetId());
+      m_rxTraceWithAddresses(rxPacket, from, localAddress);
+    }
+    numReceived++;
+    if (m_counters)
+    {
+      m_counters->received++;
+    }
+
+    FloodingUpdate forwarded = update;
+    forwarded.numHops = update.numHops + 1;
+
+    bool schedule = m_forward.ShouldSchedule(*this, forwarded, advance);
+    Time delay;
+    if (schedule)
+    {
+      delay = m_delay.GetDelay(*this, state, update, advance, isEncodedPacket);
+    }
+    Ptr<Packet> packetToForward = m_coding.Enqueue(*this, state, packet, forwarded);
+    if (schedule)
+    {
+      // A timer still pending for an older update of the source is left
+      // to expire, only the latest one can be suppressed
+      state.forwardEvent = Simulator::Schedule(delay, &FloodingApp::Forward, this, src, seq, packetToForward);
+      state.forwardSeq = seq;
+    }
+    seenPackets.MarkSeen(src, seq);
+    m_delay.OnReceived(*this, state, update);
+    UpdateMemoryFootprint();
+  }
+
+  template <class F, class D, class C>
+  void
+  FloodingApp<F, D, C>::Forward(uint32_t src, uint32_t seq, Ptr<Packet> packet)
+  {
+    numForwardTimersFired++;
+    if (m_forward.ShouldSend(*this, src, seq) && m_coding.Transmit(*this, src, seq, packet))
+    {
+      numForwarded++;
+      if (m_counters)
+      {
+        m_counters->forwarded++;
+      }
+    }
+    m_coding.Release(*this, src);
+    UpdateMemoryFootprint();
+  }
+
+  template <class F, class D, class C>
+  void
+  FloodingApp<F, D, C>::CancelForward(uint32_t src, uint32_t seq)
+  {
+    SourceState *state = FindState(src);
+    if (state == nullptr || state->forwardSeq != seq || !state->forwardEvent.IsRunning())
+    {
+      return;
+    }
+    NS_LOG_LOGIC("Suppressing the forwarding of " << src << ":" << seq);
+    // Remove rather than Cancel, so that the event and the packet it holds
+    // do not stay in the queue until the timer would have expired
+    Simulator::Remove(state->forwardEvent);
+    numForwardTimersCancelled++;
+    m_coding.Release(*this, src);
+    UpdateMemoryFootprint();
+  }
+
+  template <class F, class D, class C>
+  int FloodingApp<F, D, C>::GetNumUpdatesReceivedInTime()
+  {
+    return numUpdatesReceivedInTime;
+  }
+
+  template <class F, class D, class C>
+  int FloodingApp<F, D, C>::GetNumUpdatesReceivedLate()
+  {
+    return numUpdatesReceivedLate;
+  }
+
+  template <class F, class D, class C>
+  int FloodingApp<F, D, C>::GetNumSeenNodes()
+  {
+    return numSeenNodes;
+  }
+
+  template <class F, class D, class C>
+  int FloodingApp<F, D, C>::GetNumSent()
+  {
+    return numSent;
+  }
+
+  template <class F, class D, class C>
+  int FloodingApp<F, D, C>::GetNumFwd()
+  {
+    return numForwarded;
+  }
+
+  template <class F, class D, class C>
+  int FloodingApp<F, D, C>::GetNumRcvd()
+  {
+    return numReceived;
+  }
+
+  template <class F, class D, class C>
+  uint64_t FloodingApp<F, D, C>::GetNumForwardTimersFired()
+  {
+    return numForwardTimersFired;
+  }
+
+  template <class F, class D, class C>
+  uint64_t FloodingApp<F, D, C>::GetNumForwardTimersCancelled()
+  {
+    return numForwardTimersCancelled;
+  }
+
+  template <class F, class D, class C>
+  void FloodingApp<F, D, C>::SetCounters(Ptr<FloodingCounters> counters)
+  {
+    m_counters = counters;
+  }
+
+  template <class F, class D, class C>
+  int64_t FloodingApp<F, D, C>::AssignStreams(int64_t stream)
+  {
+    NS_LOG_FUNCTION(this << stream);
+    int64_t currentStream = stream;
+    currentStream += m_forward.AssignStreams(currentStream);
+    currentStream += m_delay.AssignStreams(currentStream);
+    currentStream += m_coding.AssignStreams(currentStream);
+    return currentStream - stream;
+  }
+
+  template <class F, class D, class C>
+  void FloodingApp<F, D, C>::ResetStats()
+  {
+    numUpdatesReceivedInTime = 0;
+    numUpdatesReceivedLate = 0;
+    seenNodes.assign(seenNodes.size(), false);
+    numSeenNodes = 0;
+    numSent = 0;
+    numReceived = 0;
+    numForwarded = 0;
+    numForwardTimersFired = 0;
+    numForwardTimersCancelled = 0;
+    m_aoiHistogram.Clear();
+    m_coding.ResetStats();
+  }
+
+} // namespace ns3
+
+#endif /* FLOODING_APP_H */
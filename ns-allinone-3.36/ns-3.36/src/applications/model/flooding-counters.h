@@ -0,0 +1,60 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FLOODING_COUNTERS_H
+#define FLOODING_COUNTERS_H
+
+#include <stdint.h>
+#include "ns3/simple-ref-count.h"
+
+namespace ns3
+{
+
+  /**
+   * Metrics of a set of flooding applications, summed as they happen.
+   *
+   * Every application given the same counters with SetCounters increments
+   * them next to its own metrics, so the totals over all the nodes are
+   * known at any time without visiting the applications. The counters are
+   * not reset by the ResetStats of the applications: Reset them at the same
+   * time, e.g. at the end of the warm-up.
+   */
+  class FloodingCounters : public SimpleRefCount<FloodingCounters>
+  {
+  public:
+    uint64_t seenPairs = 0;          //!< (node, source) pairs with an update received, see GetNumSeenNodes
+    uint64_t receivedInTime = 0;     //!< updates received within the AoI threshold, see GetNumUpdatesReceivedInTime
+    uint64_t receivedLate = 0;       //!< updates received after the AoI threshold, see GetNumUpdatesReceivedLate
+    uint64_t sent = 0;               //!< updates originated
+    uint64_t sentCoded = 0;          //!< network coded frames sent
+    uint64_t received = 0;           //!< new updates received
+    uint64_t forwarded = 0;          //!< updates forwarded
+
+    void Reset()
+    {
+      seenPairs = 0;
+      receivedInTime = 0;
+      receivedLate = 0;
+      sent = 0;
+      sentCoded = 0;
+      received = 0;
+      forwarded = 0;
+    }
+  };
+
+} // namespace ns3
+
+#endif /* FLOODING_COUNTERS_H */
@@ -0,0 +1,157 @@
+#ifndef FLOODING_HEADER_CODEC_H
+#define FLOODING_HEADER_CODEC_H
+
+#include <math.h>
+#include <stdint.h>
+#include "ns3/buffer.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/vector.h"
+
+namespace ns3
+{
+    /**
+     * Field encodings shared by the flooding headers.
+     *
+     * Every header starts with a version byte. FIXED writes fixed width
+     * fields, COMPACT writes integers as LEB128 varints, timestamps as 32 bit
+     * microseconds and positions as varints of POSITION_RESOLUTION steps.
+     *
+     * After its version byte, FIXED has the field layout of the headers
+     * without version byte (32 bit integers, 64 bit timestamp steps and
+     * positions truncated to whole meters). It is thus one byte longer than
+     * those headers and cannot be read by, or read the frames of, builds
+     * that predate the version byte.
+     *
+     * COMPACT timestamps only keep their low bits, see ReadTimestamp: the
+     * headers carrying them can only be deserialized during the simulation,
+     * by the receivers, not from stored frames afterwards.
+     */
+    namespace FloodingHeaderCodec
+    {
+        enum Format
+        {
+            FIXED = 1,
+            COMPACT = 2
+        };
+
+        /// Flag of the version byte of the frames carrying several updates
+        const uint8_t AGGREGATE = 0x80;
+
+        /// Position quantization step of the COMPACT format, in meters
+        const double POSITION_RESOLUTION = 0.1;
+
+        inline uint32_t GetVarintSize(uint64_t value)
+        {
+            uint32_t size = 1;
+            while (value >= 0x80) {
+                value >>= 7;
+                size++;
+            }
+            return size;
+        }
+
+        inline void WriteVarint(Buffer::Iterator &i, uint64_t value)
+        {
+            while (value >= 0x80) {
+                i.WriteU8(static_cast<uint8_t>(value) | 0x80);
+                value >>= 7;
+            }
+            i.WriteU8(static_cast<uint8_t>(value));
+        }
+
+        inline uint64_t ReadVarint(Buffer::Iterator &i)
+        {
+            uint64_t value = 0;
+            for (uint32_t shift = 0; shift < 64; shift += 7) {
+                uint8_t byte = i.ReadU8();
+                value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0) {
+                    break;
+                }
+            }
+            return value;
+        }
+
+        /// Zigzag mapping, so that small negative values stay short
+        inline uint64_t ZigZag(int64_t value)
+        {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        inline int64_t UnZigZag(uint64_t value)
+        {
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        struct QuantizedPosition
+        {
+            int64_t x;
+            int64_t y;
+            int64_t z;
+        };
+
+        inline QuantizedPosition Quantize(const Vector &pos)
+        {
+            return {llround(pos.x / POSITION_RESOLUTION),
+                    llround(pos.y / POSITION_RESOLUTION),
+                    llround(pos.z / POSITION_RESOLUTION)};
+        }
+
+        inline Vector Dequantize(const QuantizedPosition &q)
+        {
+            return Vector(q.x * POSITION_RESOLUTION, q.y * POSITION_RESOLUTION, q.z * POSITION_RESOLUTION);
+        }
+
+        /// Position, or delta to base if given, as three zigzag varints
+        inline uint32_t GetPositionSize(const QuantizedPosition &q, const QuantizedPosition &base = {0, 0, 0})
+        {
+            return GetVarintSize(ZigZag(q.x - base.x))
+                   + GetVarintSize(ZigZag(q.y - base.y))
+                   + GetVarintSize(ZigZag(q.z - base.z));
+        }
+
+        inline void WritePosition(Buffer::Iterator &i, const QuantizedPosition &q, const QuantizedPosition &base = {0, 0, 0})
+        {
+            WriteVarint(i, ZigZag(q.x - base.x));
+            WriteVarint(i, ZigZag(q.y - base.y));
+            WriteVarint(i, ZigZag(q.z - base.z));
+        }
+
+        inline QuantizedPosition ReadPosition(Buffer::Iterator &i, const QuantizedPosition &base = {0, 0, 0})
+        {
+            QuantizedPosition q;
+            q.x = base.x + UnZigZag(ReadVarint(i));
+            q.y = base.y + UnZigZag(ReadVarint(i));
+            q.z = base.z + UnZigZag(ReadVarint(i));
+            return q;
+        }
+
+        /// Low 32 bits of the timestamp in microseconds
+        inline void WriteTimestamp(Buffer::Iterator &i, uint64_t ts)
+        {
+            i.WriteHtonU32(static_cast<uint32_t>(TimeStep(ts).GetMicroSeconds()));
+        }
+
+        /**
+         * The timestamp is taken as the latest time not after
+         * Simulator::Now() with these low bits, which is exact for packets
+         * less than about 71 minutes old (rounded down to the microsecond).
+         * The simulation time thus acts as the epoch of the timestamps: a
+         * header read after the simulator was destroyed, or more than 71
+         * minutes after it was sent, gets a wrong timestamp.
+         */
+        inline uint64_t ReadTimestamp(Buffer::Iterator &i)
+        {
+            uint32_t low = i.ReadNtohU32();
+            uint64_t now = Simulator::Now().GetMicroSeconds();
+            uint32_t age = static_cast<uint32_t>(now) - low;
+            uint64_t us = age <= now ? now - age : low;
+            return MicroSeconds(us).GetTimeStep();
+        }
+
+    } // namespace FloodingHeaderCodec
+
+} // namespace ns3
+
+#endif /* FLOODING_HEADER_CODEC_H */
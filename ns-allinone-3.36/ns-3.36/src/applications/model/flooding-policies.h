@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FLOODING_POLICIES_H
+#define FLOODING_POLICIES_H
+
+#include <math.h>
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/flooding-app.h"
+
+namespace ns3
+{
+
+  /**
+   * Forward every update up to a hop limit, with a given probability.
+   */
+  struct ProbabilisticForwardPolicy : public FloodingPolicy
+  {
+    uint16_t m_ttl = 999;
+    double m_probability = 1.0;
+    Ptr<UniformRandomVariable> m_random;    //!< in [0, 1]
+
+    ProbabilisticForwardPolicy()
+    {
+      m_random = CreateObject<UniformRandomVariable>();
+    }
+
+    template <class App>
+    bool ShouldSchedule(App &app, const FloodingUpdate &forwarded, double advance)
+    {
+      return forwarded.numHops < m_ttl;
+    }
+
+    template <class App>
+    bool ShouldSend(App &app, uint32_t src, uint32_t seq)
+    {
+      return m_random->GetValue() <= m_probability;
+    }
+
+    int64_t AssignStreams(int64_t stream)
+    {
+      m_random->SetStream(stream);
+      return 1;
+    }
+  };
+
+  /**
+   * Forward an update unless it was heard again while waiting. With
+   * ProgressOnly, only the updates brought closer to the edge of the
+   * coverage of their source are forwarded.
+   */
+  template <bool ProgressOnly>
+  struct ContentionForwardPolicy : public FloodingPolicy
+  {
+    template <class App>
+    bool ShouldSchedule(App &app, const FloodingUpdate &forwarded, double advance)
+    {
+      return !ProgressOnly || advance > 0;
+    }
+
+    template <class App>
+    bool ShouldSend(App &app, uint32_t src, uint32_t seq)
+    {
+      return !app.seenPackets.IsSeenTwice(src, seq);
+    }
+
+    /// Updates decoded from a coded frame do not suppress the forwarding
+    template <class App>
+    bool OnDuplicate(App &app, const FloodingUpdate &update, bool isEncodedPacket)
+    {
+      if (isEncodedPacket)
+      {
+        return false;
+      }
+      app.seenPackets.MarkSeenTwice(update.src, update.seq);
+      return true;
+    }
+  };
+
+  typedef ContentionForwardPolicy<false> ContentionOnlyForwardPolicy;
+  typedef ContentionForwardPolicy<true> ProgressForwardPolicy;
+
+  /**
+   * Uniform delay in [0, 0.1] s.
+   */
+  struct UniformJitterDelayPolicy : public FloodingPolicy
+  {
+    Ptr<UniformRandomVariable> jitter;
+
+    UniformJitterDelayPolicy()
+    {
+      // Set up before the ForwardingJitter attribute, whose value is
+      // therefore not used
+      jitter = CreateObject<UniformRandomVariable>();
+      jitter->SetAttribute("Min", DoubleValue(0));
+      jitter->SetAttribute("Max", DoubleValue(Seconds(0.1).GetSeconds()));
+    }
+
+    template <class App>
+    Time GetDelay(App &app, typename App::SourceState &state, const FloodingUpdate &received,
+                  double advance, bool isEncodedPacket)
+    {
+      return Seconds(jitter->GetValue());
+    }
+
+    int64_t AssignStreams(int64_t stream)
+    {
+      jitter->SetStream(stream);
+      return 1;
+    }
+  };
+
+  /**
+   * Delay decreasing with the advance of the receiver over the last hop:
+   * ForwardingJitter * (1 - advance / MaxDistance).
+   */
+  struct ContentionDelayPolicy : public FloodingPolicy
+  {
+    template <class App>
+    Time GetDelay(App &app, typename App::SourceState &state, const FloodingUpdate &received,
+                  double advance, bool isEncodedPacket)
+    {
+      double scale = (1.0 - (advance / app.m_maxDistance));
+
+      if (scale < 0)
+      {
+        scale = 1.0;
+      }
+
+      return app.m_forwardingJitter * scale;
+    }
+  };
+
+  /**
+   * Contention delay, after which the forwarding of a source is spaced by
+   * SendInterval * (numHops + 1)^DecayFactor.
+   */
+  struct RateDecayDelayPolicy : public FloodingPolicy
+  {
+    struct SourceData
+    {
+      Time lastForwarded;
+      bool hasLastForwarded = false;
+    };
+
+    double m_decayFactor = 1.0;
+
+    template <class App>
+    Time GetDelay(App &app, typename App::SourceState &state, const FloodingUpdate &received,
+                  double advance, bool isEncodedPacket)
+    {
+      double scale = (1.0 - (advance / app.m_maxDistance));
+
+      if (scale < 0.0)
+      {
+        scale = 0.0;
+      }
+
+      Time cbfDelay = app.m_forwardingJitter * scale;
+      if (isEncodedPacket)
+      {
+        cbfDelay = cbfDelay + app.m_forwardingJitter; // Add additional delay for encoded pkts
+      }
+
+      Time delay = cbfDelay + GetRateDelay(app, state.delay, received.numHops);
+      if (isEncodedPacket)
+      {
+        delay += app.m_sendInterval * pow(received.numHops, m_decayFactor); // adding the rdf delay of the previous hop that might have been skipped
+      }
+      return delay;
+    }
+
+    template <class App>
+    void OnReceived(App &app, typename App::SourceState &state, const FloodingUpdate &update)
+    {
+      state.delay.lastForwarded = Simulator::Now() + GetRateDelay(app, state.delay, update.numHops);
+      state.delay.hasLastForwarded = true;
+    }
+
+    bool IsActive(const SourceData &data, Time horizon) const
+    {
+      return data.hasLastForwarded && data.lastForwarded >= horizon;
+    }
+
+  private:
+    template <class App>
+    Time GetRateDelay(App &app, const SourceData &data, uint32_t numHops) const
+    {
+      Time rdfDelay = Seconds(0);
+      if (data.hasLastForwarded)
+      {
+        rdfDelay = data.lastForwarded + app.m_sendInterval * pow(numHops + 1, m_decayFactor) - Simulator::Now();
+        if (rdfDelay < Seconds(0))
+        {
+          rdfDelay = Seconds(0);
+        }
+      }
+      return rdfDelay;
+    }
+  };
+
+} // namespace ns3
+
+#endif /* FLOODING_POLICIES_H */
@@ -0,0 +1,83 @@
+#include "lens-area-table.h"
+#include "ns3/assert.h"
+#include <math.h>
+
+namespace ns3
+{
+    LensAreaTable::LensAreaTable(double radius, uint32_t nIntervals)
+        : m_radius(-1.0),
+          m_nIntervals(nIntervals),
+          m_scale(0.0),
+          m_errorBound(0.0)
+    {
+        NS_ASSERT(nIntervals > 0);
+        SetRadius(radius);
+    }
+
+    void LensAreaTable::SetRadius(double radius)
+    {
+        NS_ASSERT(radius >= 0.0);
+        if (radius == m_radius)
+        {
+            return;
+        }
+        m_radius = radius;
+        m_values.assign(m_nIntervals + 1, 0.0);
+        m_errorBound = 0.0;
+        if (radius == 0.0)
+        {
+            // Empty circles: the table only holds zeros
+            m_scale = 0.0;
+            return;
+        }
+        m_scale = m_nIntervals / (2 * radius);
+
+        // The slope of the area is minus the chord length, 2R sqrt(1 - u^2)
+        // with u = d / 2R
+        double h = 2 * radius / m_nIntervals;
+        double chordPrev = 2 * radius;
+        for (uint32_t i = 0; i <= m_nIntervals; i++)
+        {
+            double d = i * h;
+            m_values[i] = ComputeOverlap(d, radius);
+            if (i > 0)
+            {
+                double u = static_cast<double>(i) / m_nIntervals;
+                double chord = 2 * radius * sqrt(fmax(0.0, 1 - u * u));
+                double bound = h * (chordPrev - chord) / 4;
+                m_errorBound = fmax(m_errorBound, bound);
+                chordPrev = chord;
+            }
+        }
+        m_values[m_nIntervals] = 0.0;
+    }
+
+    double LensAreaTable::GetRadius() const
+    {
+        return m_radius;
+    }
+
+    void LensAreaTable::GetOverlaps(const double *d, double *overlap, size_t n) const
+    {
+        for (size_t k = 0; k < n; k++)
+        {
+            overlap[k] = GetOverlap(d[k]);
+        }
+    }
+
+    double LensAreaTable::GetErrorBound() const
+    {
+        return m_errorBound;
+    }
+
+    double LensAreaTable::ComputeOverlap(double d, double radius)
+    {
+        if (d >= 2 * radius)
+        {
+            return 0.0;
+        }
+        double alpha = acos(d / (2 * radius));
+        return 2 * alpha * pow(radius, 2) - d * radius * sin(alpha);
+    }
+
+} // namespace ns3
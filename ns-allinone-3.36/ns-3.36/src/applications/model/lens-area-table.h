@@ -0,0 +1,79 @@
+#ifndef LENS_AREA_TABLE_H
+#define LENS_AREA_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+    /**
+     * Area of the lens in which two circles of radius R overlap, as a
+     * function of the distance d between their centers.
+     *
+     * The area only depends on d / R, so it is tabulated once at uniformly
+     * spaced points of d / 2R in [0, 1] and linearly interpolated. The
+     * area is convex in d, so the interpolation error on an interval is at
+     * most h * (slope at its end - slope at its start) / 4; the largest of
+     * these per-interval bounds is returned by GetErrorBound.
+     */
+    class LensAreaTable
+    {
+    public:
+        /**
+         * \param radius radius R of the two circles
+         * \param nIntervals number of interpolation intervals
+         */
+        explicit LensAreaTable(double radius = 0.0, uint32_t nIntervals = 4096);
+
+        /**
+         * Rebuild the table for another radius. Does nothing if the radius
+         * did not change.
+         */
+        void SetRadius(double radius);
+        double GetRadius() const;
+
+        /**
+         * \param d distance between the centers
+         * \returns the overlap area, 0 if d >= 2R
+         */
+        double GetOverlap(double d) const
+        {
+            double x = d * m_scale;
+            if (!(x < m_nIntervals))
+            {
+                return 0.0;
+            }
+            uint32_t i = static_cast<uint32_t>(x);
+            double frac = x - i;
+            return m_values[i] + frac * (m_values[i + 1] - m_values[i]);
+        }
+
+        /**
+         * Batched GetOverlap: overlap[i] = GetOverlap(d[i]).
+         */
+        void GetOverlaps(const double *d, double *overlap, size_t n) const;
+
+        /**
+         * \returns the largest absolute error of GetOverlap with respect to
+         *          ComputeOverlap, in units of area
+         */
+        double GetErrorBound() const;
+
+        /**
+         * Closed form of the overlap area.
+         * \returns the overlap area, 0 if d >= 2R
+         */
+        static double ComputeOverlap(double d, double radius);
+
+    private:
+        double m_radius;
+        uint32_t m_nIntervals;
+        double m_scale;                 //!< nIntervals / 2R
+        double m_errorBound;
+        std::vector<double> m_values;   //!< overlap at d = 2R * i / nIntervals
+    };
+
+} // namespace ns3
+
+#endif /* LENS_AREA_TABLE_H */
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "network-coding-policy.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+namespace ns3
+{
+
+    NetworkCodingPolicy::NetworkCodingPolicy()
+    {
+    }
+
+    NetworkCodingPolicy::~NetworkCodingPolicy()
+    {
+        delete lossEstimator;
+    }
+
+    void NetworkCodingPolicy::GetNcGains(double maxDistance, Vector e, Vector f, const Vector *o, double *gains, size_t n) {
+        double p_e = m_lossRate;
+        double p_s = 1 -p_e;
+        double rho = 12 / 1e6;
+
+        double R = maxDistance;
+        double A = M_PI * pow(R,2);
+        m_lensTable.SetRadius(R);
+
+        // Beyond 2R the closed form had no lens (acos out of its domain) and
+        // gave a NaN gain, so such a partner was never chosen. Keep it so.
+        double d_FE = CalculateDistance(e,f);
+        double overlap_FE = m_lensTable.GetOverlap(d_FE);
+        bool validFE = d_FE <= 2 * R;
+
+        for (size_t i = 0; i < n; i++) {
+            double d_FO = CalculateDistance(o[i],f);
+            double d_EO = CalculateDistance(o[i],e);
+            if (!validFE || d_FO > 2 * R || d_EO > 2 * R) {
+                gains[i] = std::numeric_limits<double>::quiet_NaN();
+                continue;
+            }
+
+            double overlap_FO = m_lensTable.GetOverlap(d_FO);
+            double overlap_EO = m_lensTable.GetOverlap(d_EO);
+
+            double A_0 = A - overlap_FE;
+            double A_1 = overlap_FE - overlap_FO;
+            double A_2 = overlap_EO - overlap_FO;
+            double A_3 = overlap_FO;
+
+            double xR = p_s * rho * (A_0 + (A_1 + A_3) * p_e);
+            double xR_NC = p_s * rho * ((A_1 + A_2) * p_s + A_3 * 2 * p_e * p_s);
+
+            gains[i] = xR_NC - xR;
+        }
+    }
+
+    uint64_t NetworkCodingPolicy::GetMemoryFootprint() const
+    {
+        return m_pendingSources.capacity() * sizeof(uint32_t)
+            + m_pendingSources.size() * sizeof(Packet) + m_pendingBytes;
+    }
+
+    void NetworkCodingPolicy::ResetStats()
+    {
+        numSentCoded = 0;
+        numSentAggregated = 0;
+        numUpdatesAggregated = 0;
+    }
+
+    void NetworkCodingPolicy::SetLossRate(double lossRate) {
+        m_lossRate = lossRate;
+        if (!m_started) {
+            // Start begins the estimation
+            return;
+        }
+        if (m_lossRate <= 1.0) {
+            m_lossUpdateEvent.Cancel();
+        }
+        else if (!m_lossUpdateEvent.IsRunning()) {
+            StartLossEstimation();
+        }
+    }
+
+    void NetworkCodingPolicy::SetLossEstimatorMode(BayesianPacketLossEstimator::Mode mode) {
+        m_lossEstimatorMode = mode;
+        if (lossEstimator != nullptr && lossEstimator->getMode() != mode) {
+            delete lossEstimator;
+            lossEstimator = new BayesianPacketLossEstimator(mode);
+        }
+    }
+
+    void NetworkCodingPolicy::StartLossEstimation() {
+        // Created here, once the LossEstimator attribute is known
+        if (lossEstimator == nullptr) {
+            lossEstimator = new BayesianPacketLossEstimator(m_lossEstimatorMode);
+        }
+        // Only the receptions from now on
+        numRxSuccess = 0;
+        numRxFailures = 0;
+        m_lossUpdateEvent.Cancel();
+        ScheduleLossUpdate(Seconds(0.5));
+    }
+
+    void NetworkCodingPolicy::ScheduleLossUpdate(Time dt) {
+        if (numRxFailures + numRxSuccess > 0) {
+            lossEstimator->reportObservation(numRxSuccess, numRxFailures);
+
+            numRxFailures = 0;
+            numRxSuccess = 0;
+
+            m_lossRate = lossEstimator->getExpectedLoss();
+        }
+
+        m_lossUpdateEvent = Simulator::Schedule(dt, &NetworkCodingPolicy::ScheduleLossUpdate, this, dt);
+    }
+
+    Ptr<Packet> NetworkCodingPolicy::MakePacket(const ContentionBasedFloodingHeader &header, uint32_t dataSize) {
+        Ptr<Packet> packet = Create<Packet>(dataSize);
+        packet->AddHeader(header);
+        return packet;
+    }
+
+    ContentionBasedFloodingHeader NetworkCodingPolicy::MakeHeader(const FloodingUpdate &update) {
+        ContentionBasedFloodingHeader header;
+        header.SetSeq(update.seq);
+        header.SetSrc(update.src);
+        header.SetLastHop(update.lastHop);
+        header.SetStartPos(update.startPos);
+        header.SetNumHops(update.numHops);
+        header.SetTs(update.ts);
+        header.SetLastPos(update.lastPos);
+        return header;
+    }
+
+    void NetworkCodingPolicy::SetPacketToForward(SourceData &data, uint32_t src, Ptr<Packet> packet, const ContentionBasedFloodingHeader &header)
+    {
+        if (data.packetToForward != nullptr) {
+            m_pendingBytes -= data.packetToForward->GetSize();
+        } else {
+            m_pendingSources.insert(std::lower_bound(m_pendingSources.begin(), m_pendingSources.end(), src), src);
+        }
+        data.packetToForward = packet;
+        data.pendingHeader = header;
+        m_pendingBytes += packet->GetSize();
+    }
+
+    void NetworkCodingPolicy::ClearPacketToForward(SourceData &data, uint32_t src)
+    {
+        if (data.packetToForward == nullptr) {
+            return;
+        }
+        m_pendingBytes -= data.packetToForward->GetSize();
+        data.packetToForward = nullptr;
+        m_pendingSources.erase(std::lower_bound(m_pendingSources.begin(), m_pendingSources.end(), src));
+    }
+
+} // Namespace ns3
@@ -0,0 +1,508 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NETWORK_CODING_POLICY_H
+#define NETWORK_CODING_POLICY_H
+
+#include <math.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "ns3/contention-based-flooding-header.h"
+#include "ns3/rate-decay-flooding-nc-header.h"
+#include "ns3/rate-decay-flooding-agg-header.h"
+#include "ns3/lens-area-table.h"
+#include "ns3/flooding-app.h"
+#include "bayesian-packet-loss-estimator.h"
+
+namespace ns3
+{
+
+  /**
+   * CodingPolicy of NC-RDF: the frames are RateDecayFloodingNcHeader, which
+   * carry one update, or the XOR of two updates when one of the nodes in
+   * range is expected to miss the second one.
+   *
+   * A single packet is pending per source: a newer update replaces the one
+   * waiting for its forwarding timer. When the timer fires, the pending
+   * update of another source giving the largest coding gain, if any above
+   * MinGain, is combined with it.
+   *
+   * With a positive AggregationWindow, the pending updates of the other
+   * sources whose timer expires within the window are rather sent along,
+   * up to MaxAggregatedUpdates in total, in one RateDecayFloodingAggHeader
+   * frame. Coding is only tried when there is none to aggregate.
+   */
+  class NetworkCodingPolicy : public FloodingPolicy
+  {
+  public:
+    typedef TracedCallback<Ptr<const Packet>, uint32_t, double> TxTracedCallback;
+    typedef TracedCallback<Ptr<const Packet>, uint32_t, std::vector<Ptr<Packet>>, Vector, double> FwdTracedCallback;
+
+    struct SourceData
+    {
+      Time lastDirectlyReceived;
+      Vector lastReceivedPosition;
+      Ptr<Packet> packetToForward;
+      ContentionBasedFloodingHeader pendingHeader;    //!< decoded header of packetToForward
+      bool hasLastDirectlyReceived = false;
+      bool hasLastReceivedPosition = false;
+    };
+
+    NetworkCodingPolicy();
+    ~NetworkCodingPolicy();
+
+    /**
+     * Batched coding gain: gains[i] is the gain of combining, at position e,
+     * the update last forwarded from f with the one last forwarded from o[i],
+     * for the given communication range.
+     */
+    void GetNcGains(double maxDistance, Vector e, Vector f, const Vector *o, double *gains, size_t n);
+
+    uint64_t GetMemoryFootprint() const;
+
+    void ResetStats();
+
+    /**
+     * Set the loss rate used in the coding gains. Above 1, the loss rate is
+     * estimated from the receptions instead. On a running application, the
+     * estimation starts or stops at once, e.g. for a variant forked after
+     * the warm-up.
+     */
+    void SetLossRate(double lossRate);
+
+    /**
+     * Set the posterior of the loss estimation. A running estimation starts
+     * over with the new posterior.
+     */
+    void SetLossEstimatorMode(BayesianPacketLossEstimator::Mode mode);
+
+    template <class App>
+    void Start(App &app);
+
+    template <class App>
+    void Dispose(App &app);
+
+    template <class App>
+    void Decode(App &app, Ptr<Packet> packet, const Address &from, const Address &localAddress);
+
+    template <class App>
+    Ptr<Packet> MakeOriginal(App &app, const FloodingUpdate &update);
+
+    template <class App>
+    void TraceTx(App &app, Ptr<Packet> packet);
+
+    template <class App>
+    void OnReceived(App &app, typename App::SourceState &state, const FloodingUpdate &update);
+
+    template <class App>
+    Ptr<Packet> GetRxPacket(App &app, Ptr<Packet> received, const FloodingUpdate &update);
+
+    /**
+     * Make the update the packet to forward of its source.
+     * \returns nullptr, Transmit takes the pending packet of the source
+     */
+    template <class App>
+    Ptr<Packet> Enqueue(App &app, typename App::SourceState &state, Ptr<Packet> received, const FloodingUpdate &update);
+
+    template <class App>
+    bool Transmit(App &app, uint32_t src, uint32_t seq, Ptr<Packet> packet);
+
+    template <class App>
+    void Release(App &app, uint32_t src);
+
+    BayesianPacketLossEstimator* lossEstimator = nullptr;
+    BayesianPacketLossEstimator::Mode m_lossEstimatorMode = BayesianPacketLossEstimator::GRID;
+
+    double m_minGain = 0;
+    double m_lossRate = 0;
+
+    int numSentCoded = 0;
+
+    Time m_aggregationWindow = Seconds(0);      //!< zero disables the aggregation
+    uint32_t m_maxAggregated = 8;
+
+    int numSentAggregated = 0;                  //!< aggregated frames sent
+    int numUpdatesAggregated = 0;               //!< updates sent in aggregated frames
+
+  private:
+    /// Create the estimator if needed and schedule the loss updates
+    void StartLossEstimation();
+
+    void ScheduleLossUpdate(Time dt);
+
+    template <class App>
+    void DecodeAggregate(App &app, Ptr<Packet> packet, const Address &from, const Address &localAddress);
+
+    /**
+     * Send the pending update of src along with those of the other sources
+     * due within the aggregation window.
+     *
+     * \returns false, without sending anything, if none is due
+     */
+    template <class App>
+    bool TransmitAggregate(App &app, typename App::SourceState &state);
+
+    template <class App>
+    void RecordLossEvents(App &app, const SourceData &data, Vector newPosition, uint32_t numHops);
+
+    /// \returns a packet of dataSize bytes carrying the header
+    static Ptr<Packet> MakePacket(const ContentionBasedFloodingHeader &header, uint32_t dataSize);
+    static ContentionBasedFloodingHeader MakeHeader(const FloodingUpdate &update);
+
+    void SetPacketToForward(SourceData &data, uint32_t src, Ptr<Packet> packet, const ContentionBasedFloodingHeader &header);
+    void ClearPacketToForward(SourceData &data, uint32_t src);
+
+    LensAreaTable m_lensTable;                  //!< overlap areas for the communication range
+    EventId m_lossUpdateEvent;
+    bool m_started = false;                     //!< whether Start was called
+
+    std::vector<uint32_t> m_pendingSources;     //!< sorted ids of the sources with a packet to forward
+    uint64_t m_pendingBytes = 0;                //!< size of the packets to forward
+
+    // Scratch space of Transmit, kept to reuse its capacity
+    std::vector<SourceData *> m_candidates;
+    std::vector<Vector> m_candidatePos;
+    std::vector<double> m_candidateGains;
+    std::vector<std::pair<Time, uint32_t>> m_dueSources;
+
+    int numRxSuccess = 0;
+    int numRxFailures = 0;
+  };
+
+  template <class App>
+  void NetworkCodingPolicy::Start(App &app)
+  {
+    m_started = true;
+    if (m_lossRate > 1.0) {
+      StartLossEstimation();
+    }
+  }
+
+  template <class App>
+  void NetworkCodingPolicy::Dispose(App &app)
+  {
+    m_lossUpdateEvent.Cancel();
+    m_started = false;
+    delete lossEstimator;
+    lossEstimator = nullptr;
+  }
+
+  template <class App>
+  void NetworkCodingPolicy::Decode(App &app, Ptr<Packet> ncPacket, const Address &from, const Address &localAddress)
+  {
+    uint8_t version;
+    ncPacket->CopyData(&version, 1);
+    if (version & FloodingHeaderCodec::AGGREGATE) {
+      DecodeAggregate(app, ncPacket, from, localAddress);
+      return;
+    }
+
+    RateDecayFloodingNcHeader ncHeader;
+    ncPacket->PeekHeader(ncHeader);
+
+    bool isEncodedPacket = ncHeader.GetSrcRight() != 0;
+
+    FloodingUpdate left;
+    left.seq = ncHeader.GetSeqLeft();
+    left.src = ncHeader.GetSrcLeft();
+    left.lastHop = ncHeader.GetLastHop();
+    left.startPos = ncHeader.GetStartPosLeft();
+    left.numHops = ncHeader.GetNumHopsLeft();
+    left.ts = ncHeader.GetTsLeft();
+    left.lastPos = ncHeader.GetLastPos();
+
+    if(!isEncodedPacket) {
+      app.OnReceive(ncPacket, left, from, localAddress, false);
+      return;
+    }
+
+    FloodingUpdate right;
+    right.seq = ncHeader.GetSeqRight();
+    right.src = ncHeader.GetSrcRight();
+    right.lastHop = ncHeader.GetLastHop();
+    right.startPos = ncHeader.GetStartPosRight();
+    right.numHops = ncHeader.GetNumHopsRight();
+    right.ts = ncHeader.GetTsLeft();
+    right.lastPos = ncHeader.GetLastPos();
+
+    if(app.seenPackets.IsSeen(left.src, left.seq)) {
+      // leftPacket was seen already, we can decode the right packet
+      app.OnReceive(ncPacket, right, from, localAddress, true);
+    }
+    if(app.seenPackets.IsSeen(right.src, right.seq)) {
+      // rightPacket was seen already, we can decode the left packet
+      app.OnReceive(ncPacket, left, from, localAddress, false);
+    }
+  }
+
+  template <class App>
+  void NetworkCodingPolicy::DecodeAggregate(App &app, Ptr<Packet> packet, const Address &from, const Address &localAddress)
+  {
+    RateDecayFloodingAggHeader aggHeader;
+    packet->PeekHeader(aggHeader);
+
+    FloodingUpdate update;
+    update.lastHop = aggHeader.GetLastHop();
+    update.lastPos = aggHeader.GetLastPos();
+    for (uint32_t i = 0; i < aggHeader.GetNRecords(); i++) {
+      const RateDecayFloodingAggHeader::Record &record = aggHeader.GetRecord(i);
+      update.src = record.src;
+      update.seq = record.seq;
+      update.numHops = record.numHops;
+      update.ts = aggHeader.GetTs(i);
+      update.startPos = record.startPos;
+      app.OnReceive(packet, update, from, localAddress, false);
+    }
+  }
+
+  template <class App>
+  Ptr<Packet> NetworkCodingPolicy::MakeOriginal(App &app, const FloodingUpdate &update)
+  {
+    Ptr<Packet> p = Create<Packet>(app.m_dataSize);
+    RateDecayFloodingNcHeader header;
+    header.SetFormat(app.m_headerFormat);
+    header.SetSeqLeft(update.seq);
+    header.SetSrcLeft(update.src);
+    header.SetTsLeft(update.ts);
+    header.SetLastHop(update.lastHop);
+    header.SetLastPos(update.lastPos);
+    header.SetStartPosLeft(update.startPos);
+    p->AddHeader(header);
+    return p;
+  }
+
+  template <class App>
+  void NetworkCodingPolicy::TraceTx(App &app, Ptr<Packet> packet)
+  {
+    app.m_txTrace(packet, app.GetNode()->GetId(), m_lossRate);
+  }
+
+  template <class App>
+  void NetworkCodingPolicy::OnReceived(App &app, typename App::SourceState &state, const FloodingUpdate &update)
+  {
+    RecordLossEvents(app, state.coding, update.startPos, update.numHops);
+
+    if (update.numHops == 0) {
+      state.coding.lastDirectlyReceived = update.ts;
+      state.coding.hasLastDirectlyReceived = true;
+    }
+    state.coding.lastReceivedPosition = update.startPos;
+    state.coding.hasLastReceivedPosition = true;
+  }
+
+  template <class App>
+  void NetworkCodingPolicy::RecordLossEvents(App &app, const SourceData &data, Vector newPosition, uint32_t numHops)
+  {
+    if (!data.hasLastReceivedPosition || !data.hasLastDirectlyReceived) {
+      return;
+    }
+
+    Vector nodePos = PositionSnapshot::GetPosition(app.GetNode()->GetId());
+
+    double oldDist = CalculateDistance(data.lastReceivedPosition, nodePos);
+    double newDist = CalculateDistance(newPosition, nodePos);
+
+    if (newDist <= app.m_maxDistance && numHops > 0) {
+      // This is a packet on detour
+      return;
+    }
+
+    if(oldDist >= app.m_maxDistance) {
+      return;
+    }
+
+    Time timeSinceLastReception = Simulator::Now() - data.lastDirectlyReceived;
+
+    int losses = floor(timeSinceLastReception.GetMilliSeconds() / app.m_sendInterval.GetMilliSeconds()) -1;
+
+    numRxSuccess += 1;
+    numRxFailures += losses;
+  }
+
+  template <class App>
+  Ptr<Packet> NetworkCodingPolicy::GetRxPacket(App &app, Ptr<Packet> received, const FloodingUpdate &update)
+  {
+    // The update, as it was received
+    return MakePacket(MakeHeader(update), app.m_dataSize);
+  }
+
+  template <class App>
+  Ptr<Packet> NetworkCodingPolicy::Enqueue(App &app, typename App::SourceState &state, Ptr<Packet> received, const FloodingUpdate &update)
+  {
+    ContentionBasedFloodingHeader header = MakeHeader(update);
+    SetPacketToForward(state.coding, state.src, MakePacket(header, app.m_dataSize), header);
+    return nullptr;
+  }
+
+  template <class App>
+  bool NetworkCodingPolicy::Transmit(App &app, uint32_t src, uint32_t seq, Ptr<Packet>)
+  {
+    typename App::SourceState *state = app.FindState(src);
+    if (state == nullptr || state->coding.packetToForward == nullptr) {
+      return false;
+    }
+    if (m_aggregationWindow.IsStrictlyPositive() && TransmitAggregate(app, *state)) {
+      return true;
+    }
+    Ptr<Packet> packet = state->coding.packetToForward;
+    ContentionBasedFloodingHeader &header = state->coding.pendingHeader;
+    Vector currentLastPos = header.GetLastPos();
+    SourceData *encoded = nullptr;
+    double largestGain = 0.0;
+    // Only build the forwarding buffer if someone listens to the trace
+    bool traceBuffer = !app.m_fwdTrace.IsEmpty();
+    std::vector<Ptr<Packet>> forwardingBuffer;
+    Vector nodePos = PositionSnapshot::GetPosition(app.GetNode()->GetId());
+
+    // The candidates are scanned through their decoded headers only,
+    // then scored all at once
+    m_candidates.clear();
+    m_candidatePos.clear();
+    for(uint32_t pendingSrc : m_pendingSources) {
+      SourceData &candidate = app.FindState(pendingSrc)->coding;
+      if ((src != pendingSrc) && !app.seenPackets.IsSeenTwice(pendingSrc, candidate.pendingHeader.GetSeq()))
+      {
+        if (traceBuffer) {
+          forwardingBuffer.push_back(candidate.packetToForward->Copy());
+        }
+        m_candidates.push_back(&candidate);
+        m_candidatePos.push_back(candidate.pendingHeader.GetLastPos());
+      }
+    }
+    m_candidateGains.resize(m_candidates.size());
+    GetNcGains(app.m_maxDistance, nodePos, currentLastPos, m_candidatePos.data(), m_candidateGains.data(), m_candidates.size());
+    for (size_t i = 0; i < m_candidates.size(); i++) {
+      double gain = m_candidateGains[i];
+      if(gain > m_minGain && gain > largestGain) {
+        largestGain = gain;
+        encoded = m_candidates[i];
+      }
+    }
+
+    app.m_fwdTrace(packet, app.GetNode()->GetId(), forwardingBuffer, nodePos, m_lossRate);
+
+    RateDecayFloodingNcHeader ncHeader;
+    ncHeader.SetFormat(app.m_headerFormat);
+
+    ncHeader.SetSeqLeft(header.GetSeq());
+    ncHeader.SetSrcLeft(header.GetSrc());
+    ncHeader.SetStartPosLeft(header.GetStartPos());
+    ncHeader.SetNumHopsLeft(header.GetNumHops());
+    ncHeader.SetTsLeft(header.GetTs());
+
+    ncHeader.SetLastHop(app.GetNode()->GetId());
+    ncHeader.SetLastPos(nodePos);
+
+    if(encoded != nullptr) {
+      ContentionBasedFloodingHeader &right = encoded->pendingHeader;
+      uint32_t rightSrc = right.GetSrc();
+      ncHeader.SetSeqRight(right.GetSeq());
+      ncHeader.SetSrcRight(rightSrc);
+      ncHeader.SetStartPosRight(right.GetStartPos());
+      ncHeader.SetNumHopsRight(right.GetNumHops());
+      ncHeader.SetTsRight(right.GetTs());
+      ClearPacketToForward(*encoded, rightSrc);
+
+      numSentCoded++;
+      if (app.m_counters)
+      {
+        app.m_counters->sentCoded++;
+      }
+    }
+
+    // Same payload as the pending packet, under the coded header
+    Ptr<Packet> frame = Create<Packet>(app.m_dataSize);
+    frame->AddHeader(ncHeader);
+
+    app.m_socket->Send(frame);
+    return true;
+  }
+
+  template <class App>
+  bool NetworkCodingPolicy::TransmitAggregate(App &app, typename App::SourceState &state)
+  {
+    uint32_t src = state.src;
+    m_dueSources.clear();
+    for(uint32_t pendingSrc : m_pendingSources) {
+      if (pendingSrc == src) {
+        continue;
+      }
+      typename App::SourceState &candidate = *app.FindState(pendingSrc);
+      // Without a running timer, the pending update is not going to be sent
+      if (!candidate.forwardEvent.IsRunning()
+          || app.seenPackets.IsSeenTwice(pendingSrc, candidate.coding.pendingHeader.GetSeq())) {
+        continue;
+      }
+      Time left = Simulator::GetDelayLeft(candidate.forwardEvent);
+      if (left <= m_aggregationWindow) {
+        m_dueSources.push_back(std::make_pair(left, pendingSrc));
+      }
+    }
+    if (m_dueSources.empty()) {
+      return false;
+    }
+    // The earliest due go first
+    size_t n = std::min<size_t>(m_dueSources.size(), m_maxAggregated - 1);
+    std::partial_sort(m_dueSources.begin(), m_dueSources.begin() + n, m_dueSources.end());
+
+    uint32_t nodeId = app.GetNode()->GetId();
+    Vector nodePos = PositionSnapshot::GetPosition(nodeId);
+    bool traceBuffer = !app.m_fwdTrace.IsEmpty();
+    std::vector<Ptr<Packet>> aggregated;
+
+    RateDecayFloodingAggHeader aggHeader;
+    aggHeader.SetFormat(app.m_headerFormat);
+    aggHeader.SetLastHop(nodeId);
+    aggHeader.SetLastPos(nodePos);
+    ContentionBasedFloodingHeader &own = state.coding.pendingHeader;
+    aggHeader.AddRecord(own.GetSrc(), own.GetSeq(), own.GetNumHops(), own.GetTs(), own.GetStartPos());
+    for (size_t i = 0; i < n; i++) {
+      uint32_t dueSrc = m_dueSources[i].second;
+      SourceData &due = app.FindState(dueSrc)->coding;
+      ContentionBasedFloodingHeader &header = due.pendingHeader;
+      aggHeader.AddRecord(header.GetSrc(), header.GetSeq(), header.GetNumHops(), header.GetTs(), header.GetStartPos());
+      if (traceBuffer) {
+        aggregated.push_back(due.packetToForward->Copy());
+      }
+      // Its timer finds nothing left to send
+      ClearPacketToForward(due, dueSrc);
+    }
+
+    app.m_fwdTrace(state.coding.packetToForward, nodeId, aggregated, nodePos, m_lossRate);
+
+    // The payload of every update, under a single header
+    Ptr<Packet> frame = Create<Packet>(app.m_dataSize * aggHeader.GetNRecords());
+    frame->AddHeader(aggHeader);
+    app.m_socket->Send(frame);
+
+    numSentAggregated++;
+    numUpdatesAggregated += aggHeader.GetNRecords();
+    return true;
+  }
+
+  template <class App>
+  void NetworkCodingPolicy::Release(App &app, uint32_t src)
+  {
+    typename App::SourceState *state = app.FindState(src);
+    if (state != nullptr) {
+      ClearPacketToForward(state->coding, src);
+    }
+  }
+
+} // namespace ns3
+
+#endif /* NETWORK_CODING_POLICY_H */
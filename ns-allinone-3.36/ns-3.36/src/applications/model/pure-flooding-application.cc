@@ -17,18 +17,10 @@
  */
 
 #include "ns3/log.h"
-#include "ns3/ipv4-address.h"
-#include "ns3/ipv6-address.h"
-#include "ns3/address-utils.h"
 #include "ns3/nstime.h"
-#include "ns3/inet-socket-address.h"
-#include "ns3/inet6-socket-address.h"
-#include "ns3/socket.h"
-#include "ns3/udp-socket.h"
-#include "ns3/simulator.h"
-#include "ns3/socket-factory.h"
-#include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
 
 #include "pure-flooding-application.h"
 
@@ -44,7 +36,7 @@ namespace ns3
   TypeId
   PureFloodingApp::GetTypeId(void)
   {
-    static TypeId tid = TypeId("ns3::PureFloodingApp")
+    static TypeId tid = AddAoiAttributes(TypeId("ns3::PureFloodingApp")
                             .SetParent<Application>()
                             .SetGroupName("Applications")
                             .AddConstructor<PureFloodingApp>()
@@ -66,12 +58,21 @@ namespace ns3
                                           MakeUintegerChecker<uint32_t>(1))
                             .AddAttribute("TTL", "Max Hop count of a packet",
                                           UintegerValue(9999),
-                                          MakeUintegerAccessor(&PureFloodingApp::m_ttl),
+                                          MakeUintegerAccessor(&PureFloodingApp::SetTtl,
+                                                               &PureFloodingApp::GetTtl),
                                           MakeUintegerChecker<uint32_t>(0))
                             .AddAttribute("ForwardingProbability", "The probability to forward a packet",
                                           DoubleValue(1.0),
-                                          MakeDoubleAccessor(&PureFloodingApp::m_forwardingProbability),
+                                          MakeDoubleAccessor(&PureFloodingApp::SetForwardingProbability,
+                                                              &PureFloodingApp::GetForwardingProbability),
                                           MakeDoubleChecker<double>(0.0))
+                            .AddAttribute("Transport",
+                                          "Udp broadcasts over IPv4, or Packet to send the frames straight on the link layer "
+                                          "of the first non-loopback device, with a dedicated EtherType",
+                                          EnumValue(UDP_TRANSPORT),
+                                          MakeEnumAccessor(&PureFloodingApp::m_transport),
+                                          MakeEnumChecker(UDP_TRANSPORT, "Udp",
+                                                          PACKET_TRANSPORT, "Packet"))
                             .AddTraceSource("Rx", "A packet has been received",
                                             MakeTraceSourceAccessor(&PureFloodingApp::m_rxTrace),
                                             "ns3::Packet::TracedCallback")
@@ -83,225 +84,39 @@ namespace ns3
                                             "ns3::Packet::TracedCallback")
                             .AddTraceSource("Fwd", "A packet has been Forwarded",
                                             MakeTraceSourceAccessor(&PureFloodingApp::m_fwdTrace),
-                                            "ns3::Packet::TracedCallback");
+                                            "ns3::Packet::TracedCallback"));
     return tid;
   }
 
   PureFloodingApp::PureFloodingApp()
+      : FloodingApp("PureFloodingApp")
   {
     NS_LOG_FUNCTION(this);
-    m_socket = 0;
-    jitter = CreateObject<UniformRandomVariable>();
-    jitter->SetAttribute("Min", DoubleValue(0));
-    jitter->SetAttribute("Max", DoubleValue(m_forwardingJitter.GetSeconds()));
   }
 
   PureFloodingApp::~PureFloodingApp()
   {
     NS_LOG_FUNCTION(this);
-    m_socket = 0;
   }
 
-  void
-  PureFloodingApp::DoDispose(void)
+  void PureFloodingApp::SetTtl(uint16_t ttl)
   {
-    NS_LOG_FUNCTION(this);
-    Application::DoDispose();
-  }
-
-  void
-  PureFloodingApp::StartApplication(void)
-  {
-    NS_LOG_FUNCTION(this);
-
-    if (m_socket == 0)
-    {
-      TypeId tid = TypeId::LookupByName("ns3::UdpSocketFactory");
-      m_socket = Socket::CreateSocket(GetNode(), tid);
-      InetSocketAddress local = InetSocketAddress(Ipv4Address::GetAny(), m_port);
-      if (m_socket->Bind(local) == -1)
-      {
-        NS_FATAL_ERROR("Failed to bind socket");
-      }
-      if (addressUtils::IsMulticast(m_local))
-      {
-        Ptr<UdpSocket> udpSocket = DynamicCast<UdpSocket>(m_socket);
-        if (udpSocket)
-        {
-          // equivalent to setsockopt (MCAST_JOIN_GROUP)
-          udpSocket->MulticastJoinGroup(0, m_local);
-        }
-        else
-        {
-          NS_FATAL_ERROR("Error: Failed to join multicast group");
-        }
-      }
-
-      InetSocketAddress remote = InetSocketAddress(Ipv4Address("255.255.255.255"), 3000);
-      m_socket->SetAllowBroadcast(true);
-      m_socket->Connect(remote);
-      ScheduleTransmit(m_sendInterval);
-    }
-
-    m_socket->SetRecvCallback(MakeCallback(&PureFloodingApp::HandleRead, this));
-  }
-
-  void
-  PureFloodingApp::StopApplication()
-  {
-    NS_LOG_FUNCTION(this);
-
-    if (m_socket != 0)
-    {
-      m_socket->Close();
-      m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
-    }
-  }
-
-  void
-  PureFloodingApp::ScheduleTransmit(Time dt)
-  {
-    NS_LOG_FUNCTION(this << dt);
-    m_sendEvent = Simulator::Schedule(dt, &PureFloodingApp::Send, this);
-  }
-
-  void PureFloodingApp::Forward(Ptr<Packet> packet)
-  {
-    auto p = CreateObject<UniformRandomVariable>();
-    p->SetAttribute("Min", DoubleValue(0));
-    p->SetAttribute("Max", DoubleValue(1.0));
-
-    if (p->GetValue() <= m_forwardingProbability)
-    {
-      m_socket->Send(packet);
-      m_fwdTrace(packet, GetNode()->GetId());
-      numForwarded++;
-    }
-  }
-
-  void
-  PureFloodingApp::Send(void)
-  {
-    NS_LOG_FUNCTION(this);
-
-    NS_ASSERT(m_sendEvent.IsExpired());
-    Address localAddress;
-    m_socket->GetSockName(localAddress);
-
-    Ptr<Packet> p = Create<Packet>(m_dataSize);
-    uint32_t nodeId = GetNode()->GetId();
-
-    Vector nodePos = GetNode()->GetObject<MobilityModel>()->GetPosition();
-
-    PureFloodingHeader header;
-    header.SetSeq(this->seqNo++);
-    header.SetSrc(nodeId);
-    header.SetLastHop(nodeId);
-    header.SetStartPos(nodePos);
-    p->AddHeader(header);
-    m_txTrace(p, GetNode()->GetId());
-    numSent++;
-    m_socket->Send(p);
-    ScheduleTransmit(m_sendInterval);
-
-    string pkt_id = to_string(GetNode()->GetId()) + "-" + to_string(header.GetSeq());
-    seenSeqNos.push_back(pkt_id);
-  }
-
-  void
-  PureFloodingApp::HandleRead(Ptr<Socket> socket)
-  {
-    NS_LOG_FUNCTION(this << socket);
-
-    Ptr<Packet> packet;
-    Address from;
-    Address localAddress;
-    while ((packet = socket->RecvFrom(from)))
-    {
-      socket->GetSockName(localAddress);
-      Ptr<Packet> packetCopy = packet->Copy();
-      packetCopy->RemoveAllPacketTags();
-      packetCopy->RemoveAllByteTags();
-      PureFloodingHeader header;
-      packetCopy->RemoveHeader(header);
-
-      uint32_t src = header.GetSrc();
-      Vector nodePos = GetNode()->GetObject<MobilityModel>()->GetPosition();
-      double dist_sender = CalculateDistance(header.GetStartPos(), nodePos);
-
-      header.SetNumHops(header.GetNumHops() + 1);
-      header.SetLastHop(GetNode()->GetId());
-
-      packetCopy->AddHeader(header);
-
-      string pkt_id = to_string(header.GetSrc()) + "-" + to_string(header.GetSeq());
-
-      if (std::find(seenSeqNos.begin(), seenSeqNos.end(), pkt_id) == seenSeqNos.end())
-      {
-        seenNodes.insert(src);
-        if (lastReceived.count(src) > 0 && dist_sender <= 509.003)
-        {
-          Time aoi = Simulator::Now() - lastReceived[src];
-          if (aoi > m_aoiThreshold)
-          {
-            numUpdatesReceivedLate++;
-          }
-          else
-          {
-            numUpdatesReceivedInTime++;
-          }
-        }
-        lastReceived[src] = header.GetTs();
-        m_rxTrace(packet, GetNode()->GetId());
-        m_rxTraceWithAddresses(packet, from, localAddress);
-        numReceived++;
-        if (header.GetNumHops() < m_ttl)
-        {
-          Simulator::Schedule(Seconds(jitter->GetValue()), &PureFloodingApp::Forward, this, packetCopy);
-        }
-        seenSeqNos.push_back(pkt_id);
-      }
-    }
-  }
-
-  int PureFloodingApp::GetNumUpdatesReceivedInTime()
-  {
-    return numUpdatesReceivedInTime;
-  }
-
-  int PureFloodingApp::GetNumUpdatesReceivedLate()
-  {
-    return numUpdatesReceivedLate;
-  }
-
-  int PureFloodingApp::GetNumSeenNodes()
-  {
-    return seenNodes.size();
-  }
-
-  int PureFloodingApp::GetNumSent()
-  {
-    return numSent;
+    m_forward.m_ttl = ttl;
   }
 
-  int PureFloodingApp::GetNumFwd()
+  uint16_t PureFloodingApp::GetTtl() const
   {
-    return numForwarded;
+    return m_forward.m_ttl;
   }
 
-  int PureFloodingApp::GetNumRcvd()
+  void PureFloodingApp::SetForwardingProbability(double probability)
   {
-    return numReceived;
+    m_forward.m_probability = probability;
   }
 
-  void PureFloodingApp::ResetStats()
+  double PureFloodingApp::GetForwardingProbability() const
   {
-        numUpdatesReceivedInTime = 0;
-        numUpdatesReceivedLate = 0;
-        seenNodes.clear();
-        numSent = 0;
-        numReceived = 0;
-        numForwarded = 0;
+    return m_forward.m_probability;
   }
 
 } // Namespace ns3
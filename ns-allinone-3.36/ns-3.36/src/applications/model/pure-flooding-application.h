@@ -19,101 +19,65 @@
 #ifndef PURE_FLOODING_APP_H
 #define PURE_FLOODING_APP_H
 
-#include <algorithm>
-#include "ns3/application.h"
-#include "ns3/event-id.h"
-#include "ns3/ptr.h"
-#include "ns3/address.h"
-#include "ns3/seq-ts-header.h"
-#include "ns3/traced-callback.h"
 #include "ns3/pure-flooding-header.h"
+#include "ns3/flooding-app.h"
+#include "ns3/flooding-policies.h"
 #include "ns3/core-module.h"
 
 namespace ns3
 {
 
-  class Socket;
-  class Packet;
+  template <>
+  struct FloodingHeaderTraits<PureFloodingHeader>
+  {
+    static FloodingUpdate Read(PureFloodingHeader &header)
+    {
+      FloodingUpdate update;
+      update.src = header.GetSrc();
+      update.seq = header.GetSeq();
+      update.lastHop = header.GetLastHop();
+      update.numHops = header.GetNumHops();
+      update.ts = header.GetTs();
+      update.startPos = header.GetStartPos();
+      update.lastPos = update.startPos;
+      return update;
+    }
+
+    /// The timestamp is the creation time of the header
+    static void Write(PureFloodingHeader &header, const FloodingUpdate &update, FloodingHeaderCodec::Format format)
+    {
+      header.SetSeq(update.seq);
+      header.SetSrc(update.src);
+      header.SetLastHop(update.lastHop);
+      header.SetStartPos(update.startPos);
+    }
+
+    static void SetForwarder(PureFloodingHeader &header, uint32_t numHops, uint32_t nodeId, Vector nodePos)
+    {
+      header.SetNumHops(numHops);
+      header.SetLastHop(nodeId);
+    }
+  };
 
-  class PureFloodingApp : public Application
+  /**
+   * Pure flooding, or stochastic flooding with a ForwardingProbability
+   * below 1: every node forwards every new update after a random jitter,
+   * up to TTL hops.
+   */
+  class PureFloodingApp : public FloodingApp<ProbabilisticForwardPolicy,
+                                             UniformJitterDelayPolicy,
+                                             PlainCodingPolicy<PureFloodingHeader>>
   {
   public:
     static TypeId GetTypeId(void);
     PureFloodingApp();
     virtual ~PureFloodingApp();
 
-    void LogPerformance() {
-      NS_LOG_UNCOND("PERFORMANCE: " << seenNodes.size() << " " << numUpdatesReceivedInTime << " " << numUpdatesReceivedLate);
-    };
-
-    int GetNumUpdatesReceivedInTime();
-
-    int GetNumUpdatesReceivedLate();
-
-    int GetNumSeenNodes();
-
-    int GetNumSent();
-    int GetNumFwd();
-    int GetNumRcvd();
-
-    void ResetStats();
-
-  protected:
-    virtual void DoDispose(void);
-
   private:
-    virtual void StartApplication(void);
-    virtual void StopApplication(void);
-
-    void ScheduleTransmit(Time dt);
-
-    void Send(void);
-
-    void Forward(Ptr<Packet> packet);
-
-    void HandleRead(Ptr<Socket> socket);
-
-    Ptr<UniformRandomVariable> jitter;
-
-    int seqNo = 0;
-
-    double m_forwardingProbability = 1.0;
-
-    Time m_aoiThreshold = Seconds(0.73573573573);
-
-    Time m_sendInterval = Seconds(1);
-    Time m_forwardingJitter = Seconds(0.1);
-
-    uint16_t m_ttl = 999;
-    uint32_t m_dataSize = 100;                              //!< packet payload size (must be equal to m_size)
-    uint16_t m_port;                                        //!< Port on which we listen for incoming packets.
-    Ptr<Socket> m_socket;                                   //!< IPv4 Socket
-    Address m_local;                                        //!< local multicast address
-    EventId m_sendEvent;                                    //!< Event to send the next packet
-    Address m_peerAddress = Ipv4Address("255.255.255.255"); //!< Remote peer address
-    uint16_t m_peerPort = 300;                              //!< Remote peer port
-    std::vector<std::string> seenSeqNos;
-    std::map<uint32_t, Time> lastReceived;
-
-    // Metrics
-    std::set<uint32_t> seenNodes;
-    int numUpdatesReceivedInTime = 0;
-    int numUpdatesReceivedLate = 0;
-    int numSent = 0;
-    int numReceived = 0;
-    int numForwarded = 0;
-
-    /// Callbacks for tracing the packet Rx events
-    TracedCallback<Ptr<const Packet>, uint32_t> m_rxTrace;
-
-    /// Callbacks for tracing the packet Tx events
-    TracedCallback<Ptr<const Packet>, uint32_t> m_txTrace;
-
-    /// Callbacks for tracing the packet Fwd events
-    TracedCallback<Ptr<const Packet>, uint32_t> m_fwdTrace;
-
-    /// Callbacks for tracing the packet Rx events, includes source and destination addresses
-    TracedCallback<Ptr<const Packet>, const Address &, const Address &> m_rxTraceWithAddresses;
+    void SetTtl(uint16_t ttl);
+    uint16_t GetTtl() const;
+    void SetForwardingProbability(double probability);
+    double GetForwardingProbability() const;
   };
 
 } // namespace ns3
@@ -0,0 +1,206 @@
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/header.h"
+#include "ns3/simulator.h"
+#include "rate-decay-flooding-agg-header.h"
+
+namespace ns3
+{
+
+    NS_LOG_COMPONENT_DEFINE("RateDecayFloodingAggHeader");
+
+    NS_OBJECT_ENSURE_REGISTERED(RateDecayFloodingAggHeader);
+
+    RateDecayFloodingAggHeader::RateDecayFloodingAggHeader()
+    {
+        NS_LOG_FUNCTION(this);
+    }
+
+    void RateDecayFloodingAggHeader::SetLastHop(uint32_t lastHop)
+    {
+        this->lastHop = lastHop;
+    }
+
+    uint32_t RateDecayFloodingAggHeader::GetLastHop() const
+    {
+        return lastHop;
+    }
+
+    void RateDecayFloodingAggHeader::SetLastPos(Vector pos)
+    {
+        this->lastPos = pos;
+    }
+
+    Vector RateDecayFloodingAggHeader::GetLastPos() const
+    {
+        return lastPos;
+    }
+
+    void RateDecayFloodingAggHeader::AddRecord(uint32_t src, uint32_t seq, uint32_t numHops, Time ts, Vector startPos)
+    {
+        Record record;
+        record.src = src;
+        record.seq = seq;
+        record.numHops = numHops;
+        record.ts = ts.GetTimeStep();
+        record.startPos = startPos;
+        records.push_back(record);
+    }
+
+    uint32_t RateDecayFloodingAggHeader::GetNRecords() const
+    {
+        return records.size();
+    }
+
+    const RateDecayFloodingAggHeader::Record &RateDecayFloodingAggHeader::GetRecord(uint32_t i) const
+    {
+        NS_ASSERT(i < records.size());
+        return records[i];
+    }
+
+    Time RateDecayFloodingAggHeader::GetTs(uint32_t i) const
+    {
+        return TimeStep(GetRecord(i).ts);
+    }
+
+    void RateDecayFloodingAggHeader::SetFormat(FloodingHeaderCodec::Format format)
+    {
+        this->format = format;
+    }
+
+    FloodingHeaderCodec::Format RateDecayFloodingAggHeader::GetFormat(void) const
+    {
+        return format;
+    }
+
+    TypeId RateDecayFloodingAggHeader::GetTypeId(void)
+    {
+        static TypeId tid = TypeId("ns3::RateDecayFloodingAggHeader")
+                                .SetParent<Header>()
+                                .SetGroupName("Applications")
+                                .AddConstructor<RateDecayFloodingAggHeader>();
+        return tid;
+    }
+
+    TypeId RateDecayFloodingAggHeader::GetInstanceTypeId(void) const
+    {
+        return GetTypeId();
+    }
+
+    void RateDecayFloodingAggHeader::Print(std::ostream &os) const
+    {
+        os << "(lastHop=" << lastHop << " records=" << records.size() << ")";
+    }
+
+    uint32_t RateDecayFloodingAggHeader::GetSerializedSize(void) const
+    {
+        NS_LOG_FUNCTION(this);
+        using namespace FloodingHeaderCodec;
+        if (format == FIXED) {
+            return 1 // version
+                   + 4 // lastHop
+                   + 3 * 4 // lastPos
+                   + 4 // number of records
+                   + (4 // src
+                   + 4 // seq
+                   + 4 // numHops
+                   + 8 // ts
+                   + 3 * 4) // startPos
+                   * records.size();
+        }
+        QuantizedPosition lastQ = Quantize(lastPos);
+        uint32_t size = 1 // version
+                        + GetVarintSize(lastHop)
+                        + GetPositionSize(lastQ)
+                        + GetVarintSize(records.size());
+        for (const Record &record : records) {
+            size += GetVarintSize(record.src)
+                    + GetVarintSize(record.seq)
+                    + GetVarintSize(record.numHops)
+                    + 4 // ts
+                    + GetPositionSize(Quantize(record.startPos), lastQ);
+        }
+        return size;
+    }
+
+    void RateDecayFloodingAggHeader::Serialize(Buffer::Iterator start) const
+    {
+        NS_LOG_FUNCTION(this << &start);
+        using namespace FloodingHeaderCodec;
+        Buffer::Iterator i = start;
+        i.WriteU8(format | AGGREGATE);
+        if (format == COMPACT) {
+            QuantizedPosition lastQ = Quantize(lastPos);
+            WriteVarint(i, lastHop);
+            WritePosition(i, lastQ);
+            WriteVarint(i, records.size());
+            for (const Record &record : records) {
+                WriteVarint(i, record.src);
+                WriteVarint(i, record.seq);
+                WriteVarint(i, record.numHops);
+                WriteTimestamp(i, record.ts);
+                WritePosition(i, Quantize(record.startPos), lastQ);
+            }
+            return;
+        }
+        i.WriteHtonU32(lastHop);
+        i.WriteHtonU32((uint32_t)lastPos.x);
+        i.WriteHtonU32((uint32_t)lastPos.y);
+        i.WriteHtonU32((uint32_t)lastPos.z);
+        i.WriteHtonU32(records.size());
+        for (const Record &record : records) {
+            i.WriteHtonU32(record.src);
+            i.WriteHtonU32(record.seq);
+            i.WriteHtonU32(record.numHops);
+            i.WriteHtonU64(record.ts);
+            i.WriteHtonU32((uint32_t)record.startPos.x);
+            i.WriteHtonU32((uint32_t)record.startPos.y);
+            i.WriteHtonU32((uint32_t)record.startPos.z);
+        }
+    }
+
+    uint32_t RateDecayFloodingAggHeader::Deserialize(Buffer::Iterator start)
+    {
+        NS_LOG_FUNCTION(this << &start);
+        using namespace FloodingHeaderCodec;
+        Buffer::Iterator i = start;
+        uint8_t version = i.ReadU8();
+        NS_ASSERT_MSG(version == (FIXED | AGGREGATE) || version == (COMPACT | AGGREGATE),
+                      "Unknown aggregate header version " << +version);
+        format = static_cast<Format>(version & ~AGGREGATE);
+        records.clear();
+        if (format == COMPACT) {
+            lastHop = ReadVarint(i);
+            QuantizedPosition lastQ = ReadPosition(i);
+            lastPos = Dequantize(lastQ);
+            uint64_t n = ReadVarint(i);
+            records.resize(n);
+            for (Record &record : records) {
+                record.src = ReadVarint(i);
+                record.seq = ReadVarint(i);
+                record.numHops = ReadVarint(i);
+                record.ts = ReadTimestamp(i);
+                record.startPos = Dequantize(ReadPosition(i, lastQ));
+            }
+            return i.GetDistanceFrom(start);
+        }
+        lastHop = i.ReadNtohU32();
+        uint32_t lastPosX = i.ReadNtohU32();
+        uint32_t lastPosY = i.ReadNtohU32();
+        uint32_t lastPosZ = i.ReadNtohU32();
+        lastPos = Vector(lastPosX, lastPosY, lastPosZ);
+        records.resize(i.ReadNtohU32());
+        for (Record &record : records) {
+            record.src = i.ReadNtohU32();
+            record.seq = i.ReadNtohU32();
+            record.numHops = i.ReadNtohU32();
+            record.ts = i.ReadNtohU64();
+            uint32_t startPosX = i.ReadNtohU32();
+            uint32_t startPosY = i.ReadNtohU32();
+            uint32_t startPosZ = i.ReadNtohU32();
+            record.startPos = Vector(startPosX, startPosY, startPosZ);
+        }
+        return i.GetDistanceFrom(start);
+    }
+
+} // namespace ns3
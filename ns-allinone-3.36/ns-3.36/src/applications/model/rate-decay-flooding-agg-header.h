@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RATE_DECAY_FLOODING_AGG_HEADER_H
+#define RATE_DECAY_FLOODING_AGG_HEADER_H
+
+#include <vector>
+#include "ns3/header.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+#include "flooding-header-codec.h"
+
+namespace ns3
+{
+    /**
+     * Header of a frame carrying the updates of several sources, forwarded
+     * at once by the same node. The forwarder (LastHop, LastPos) is shared,
+     * every record holds the fields of one update.
+     *
+     * The version byte has FloodingHeaderCodec::AGGREGATE set, which tells
+     * the frame apart from a RateDecayFloodingNcHeader.
+     */
+    class RateDecayFloodingAggHeader : public Header
+    {
+    public:
+        struct Record
+        {
+            uint32_t src = 0;
+            uint32_t seq = 0;
+            uint32_t numHops = 0;
+            uint64_t ts = 0;
+            Vector startPos = Vector(0, 0, 0);
+        };
+
+        RateDecayFloodingAggHeader();
+
+        void SetLastHop(uint32_t lastHop);
+        uint32_t GetLastHop() const;
+
+        void SetLastPos(Vector pos);
+        Vector GetLastPos() const;
+
+        void AddRecord(uint32_t src, uint32_t seq, uint32_t numHops, Time ts, Vector startPos);
+        uint32_t GetNRecords() const;
+        const Record &GetRecord(uint32_t i) const;
+        Time GetTs(uint32_t i) const;
+
+        /**
+         * Select the wire format written by Serialize. Deserialize reads the
+         * format from the version byte. In the COMPACT format the start
+         * positions are written relative to LastPos.
+         */
+        void SetFormat(FloodingHeaderCodec::Format format);
+        FloodingHeaderCodec::Format GetFormat(void) const;
+
+        static TypeId GetTypeId(void);
+
+        virtual TypeId GetInstanceTypeId(void) const;
+        virtual void Print(std::ostream &os) const;
+        virtual uint32_t GetSerializedSize(void) const;
+        virtual void Serialize(Buffer::Iterator start) const;
+        /**
+         * In the COMPACT format, the timestamps are rebuilt relative to
+         * Simulator::Now(), see FloodingHeaderCodec::ReadTimestamp: only
+         * deserialize received frames, during the simulation.
+         */
+        virtual uint32_t Deserialize(Buffer::Iterator start);
+
+    private:
+        uint32_t lastHop = 0;
+        Vector lastPos = Vector(0, 0, 0);
+        std::vector<Record> records;
+        FloodingHeaderCodec::Format format = FloodingHeaderCodec::COMPACT;
+    };
+
+} // namespace ns3
+
+#endif /* RATE_DECAY_FLOODING_AGG_HEADER_H */
@@ -141,6 +141,16 @@ namespace ns3
         return TimeStep(tsRight);
     }
 
+    void RateDecayFloodingNcHeader::SetFormat(FloodingHeaderCodec::Format format)
+    {
+        this->format = format;
+    }
+
+    FloodingHeaderCodec::Format RateDecayFloodingNcHeader::GetFormat(void) const
+    {
+        return format;
+    }
+
     TypeId RateDecayFloodingNcHeader::GetTypeId(void)
     {
         static TypeId tid = TypeId("ns3::RateDecayFloodingNcHeader")
@@ -162,20 +172,62 @@ namespace ns3
     uint32_t RateDecayFloodingNcHeader::GetSerializedSize(void) const
     {
         NS_LOG_FUNCTION(this);
-        return (4        // seq
-               + 8      // ts
-               + 8      // src
-               + 8      // numHops
-               + 3 * 8)  // startPos
-               * 2 // for Left & Right
-               + 8      // lastHop
-               + 3 * 8; // lastPos
+        using namespace FloodingHeaderCodec;
+        if (format == FIXED) {
+            return 1 // version
+                   + (4        // seq
+                   + 8      // ts
+                   + 4      // src
+                   + 4      // numHops
+                   + 3 * 4)  // startPos
+                   * 2 // for Left & Right
+                   + 4      // lastHop
+                   + 3 * 4; // lastPos
+        }
+        QuantizedPosition startQ = Quantize(startPosLeft);
+        uint32_t size = 1 // version
+                        + GetVarintSize(lastHop)
+                        + GetVarintSize(seqLeft)
+                        + GetVarintSize(srcLeft)
+                        + GetVarintSize(numHopsLeft)
+                        + 4 // tsLeft
+                        + GetPositionSize(startQ)
+                        + GetVarintSize(srcRight)
+                        + GetPositionSize(Quantize(lastPos), startQ);
+        if (srcRight != 0) {
+            size += GetVarintSize(seqRight)
+                    + GetVarintSize(numHopsRight)
+                    + 4 // tsRight
+                    + GetPositionSize(Quantize(startPosRight), startQ);
+        }
+        return size;
     }
 
     void RateDecayFloodingNcHeader::Serialize(Buffer::Iterator start) const
     {
         NS_LOG_FUNCTION(this << &start);
+        using namespace FloodingHeaderCodec;
         Buffer::Iterator i = start;
+        i.WriteU8(format);
+        if (format == COMPACT) {
+            // Positions are sent relative to the start position of the left packet
+            QuantizedPosition startQ = Quantize(startPosLeft);
+            WriteVarint(i, lastHop);
+            WriteVarint(i, seqLeft);
+            WriteVarint(i, srcLeft);
+            WriteVarint(i, numHopsLeft);
+            WriteTimestamp(i, tsLeft);
+            WritePosition(i, startQ);
+            WriteVarint(i, srcRight);
+            if (srcRight != 0) {
+                WriteVarint(i, seqRight);
+                WriteVarint(i, numHopsRight);
+                WriteTimestamp(i, tsRight);
+                WritePosition(i, Quantize(startPosRight), startQ);
+            }
+            WritePosition(i, Quantize(lastPos), startQ);
+            return;
+        }
         i.WriteHtonU32(seqLeft);
         i.WriteHtonU32(seqRight);
         i.WriteHtonU64(tsLeft);
@@ -216,7 +268,34 @@ namespace ns3
     uint32_t RateDecayFloodingNcHeader::Deserialize(Buffer::Iterator start)
     {
         NS_LOG_FUNCTION(this << &start);
+        using namespace FloodingHeaderCodec;
         Buffer::Iterator i = start;
+        uint8_t version = i.ReadU8();
+        NS_ASSERT_MSG(version == FIXED || version == COMPACT, "Unknown header version " << +version);
+        format = static_cast<Format>(version);
+        if (format == COMPACT) {
+            lastHop = ReadVarint(i);
+            seqLeft = ReadVarint(i);
+            srcLeft = ReadVarint(i);
+            numHopsLeft = ReadVarint(i);
+            tsLeft = ReadTimestamp(i);
+            QuantizedPosition startQ = ReadPosition(i);
+            startPosLeft = Dequantize(startQ);
+            srcRight = ReadVarint(i);
+            if (srcRight != 0) {
+                seqRight = ReadVarint(i);
+                numHopsRight = ReadVarint(i);
+                tsRight = ReadTimestamp(i);
+                startPosRight = Dequantize(ReadPosition(i, startQ));
+            } else {
+                seqRight = 0;
+                numHopsRight = 0;
+                tsRight = tsLeft;
+                startPosRight = Vector(0, 0, 0);
+            }
+            lastPos = Dequantize(ReadPosition(i, startQ));
+            return i.GetDistanceFrom(start);
+        }
         seqLeft = i.ReadNtohU32();
         seqRight = i.ReadNtohU32();
         tsLeft = i.ReadNtohU64();
@@ -243,7 +322,7 @@ namespace ns3
         uint32_t last_pos_z = i.ReadNtohU32();
         lastPos = Vector(last_pos_x, last_pos_y, last_pos_z);
 
-        return GetSerializedSize();
+        return i.GetDistanceFrom(start);
     }
 
 } // namespace ns3
@@ -25,6 +25,7 @@
 #include "ns3/nstime.h"
 #include "ns3/mobility-module.h"
 #include "ns3/core-module.h"
+#include "flooding-header-codec.h"
 
 namespace ns3
 {
@@ -62,12 +63,26 @@ namespace ns3
         void SetLastPos (Vector pos);
         Vector GetLastPos ();
 
+        /**
+         * Select the wire format written by Serialize. Deserialize reads the
+         * format from the version byte. In the COMPACT format the right-hand
+         * fields are only written if SrcRight is not 0; otherwise they are
+         * read back as 0, with TsRight equal to TsLeft.
+         */
+        void SetFormat (FloodingHeaderCodec::Format format);
+        FloodingHeaderCodec::Format GetFormat (void) const;
+
         static TypeId GetTypeId(void);
 
         virtual TypeId GetInstanceTypeId(void) const;
         virtual void Print(std::ostream &os) const;
         virtual uint32_t GetSerializedSize(void) const;
         virtual void Serialize(Buffer::Iterator start) const;
+        /**
+         * In the COMPACT format, the timestamps are rebuilt relative to
+         * Simulator::Now(), see FloodingHeaderCodec::ReadTimestamp: only
+         * deserialize received frames, during the simulation.
+         */
         virtual uint32_t Deserialize(Buffer::Iterator start);
 
     private:
@@ -83,6 +98,7 @@ namespace ns3
         Vector startPosLeft = Vector(0, 0, 0);
         Vector startPosRight = Vector(0, 0, 0);
         Vector lastPos = Vector(0, 0, 0);
+        FloodingHeaderCodec::Format format = FloodingHeaderCodec::COMPACT;
 
         
     };
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include "ns3/aoi-histogram.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Check the buckets, cells and percentiles of the AoI histogram.
+ */
+class AoiHistogramTestCase : public TestCase
+{
+public:
+  AoiHistogramTestCase ();
+  virtual ~AoiHistogramTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+AoiHistogramTestCase::AoiHistogramTestCase ()
+  : TestCase ("Check the log-linear AoI histogram")
+{
+}
+
+AoiHistogramTestCase::~AoiHistogramTestCase ()
+{
+}
+
+void
+AoiHistogramTestCase::DoRun (void)
+{
+  // Every value falls in a bucket holding it, at most 1/16 of its value wide
+  uint64_t values[] = {0, 1, 15, 16, 17, 31, 32, 100, 999, 1000, 123456, 1u << 20, AoiHistogram::MAX_VALUE};
+  for (uint64_t v : values)
+    {
+      uint32_t b = AoiHistogram::GetBucket (v);
+      NS_TEST_ASSERT_MSG_LT (b, AoiHistogram::N_BUCKETS, "Bucket out of range for " << v);
+      NS_TEST_ASSERT_MSG_LT_OR_EQ (AoiHistogram::GetBucketLowerBound (b), v, "Lower bound above " << v);
+      NS_TEST_ASSERT_MSG_GT (AoiHistogram::GetBucketUpperBound (b), v, "Upper bound not above " << v);
+      uint64_t width = AoiHistogram::GetBucketUpperBound (b) - AoiHistogram::GetBucketLowerBound (b);
+      NS_TEST_ASSERT_MSG_EQ ((width == 1 || width * 16 <= AoiHistogram::GetBucketLowerBound (b)), true,
+                             "Bucket too wide for " << v);
+    }
+  for (uint32_t b = 1; b < AoiHistogram::N_BUCKETS; b++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (AoiHistogram::GetBucketLowerBound (b), AoiHistogram::GetBucketUpperBound (b - 1),
+                             "Buckets not contiguous at " << b);
+    }
+  NS_TEST_ASSERT_MSG_EQ (AoiHistogram::GetBucket (AoiHistogram::MAX_VALUE + 1000), AoiHistogram::N_BUCKETS - 1,
+                         "Values above the range must fall in the last bucket");
+
+  AoiHistogram histogram (100.0, 3, 2);
+  // Ring 0, direct: 1 ms to 100 ms
+  for (uint32_t i = 1; i <= 100; i++)
+    {
+      histogram.Record (50.0, 0, MilliSeconds (i));
+    }
+  // Farther than the last ring and more hops than tracked
+  histogram.Record (1e6, 7, Seconds (2));
+  histogram.Record (250.0, 1, Seconds (1));
+
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetCount (0, 0), 100, "Wrong count in ring 0");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetCount (2, 1), 2, "Overflow ring and hops not merged in the last cell");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetCount (1, 0), 0, "Unexpected sample in ring 1");
+  NS_TEST_ASSERT_MSG_EQ_TOL (histogram.GetMean (0, 0).GetSeconds (), 0.0505, 1e-9, "Wrong mean");
+  NS_TEST_ASSERT_MSG_EQ_TOL (histogram.GetPercentile (0, 0, 0.5).GetSeconds (), 0.050, 0.050 / 16,
+                             "Wrong median");
+  NS_TEST_ASSERT_MSG_EQ_TOL (histogram.GetPercentile (0, 0, 0.99).GetSeconds (), 0.099, 0.099 / 16,
+                             "Wrong 99th percentile");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetPercentile (1, 1, 0.5), Seconds (0), "Empty cell must give zero");
+
+  AoiHistogram other (100.0, 3, 2);
+  other.Record (10.0, 0, MilliSeconds (500));
+  histogram.Merge (other);
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetCount (0, 0), 101, "Merge lost samples");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetBucketCount (0, 0, AoiHistogram::GetBucket (500000)), 1,
+                         "Merged sample not in its bucket");
+
+  std::ostringstream os;
+  histogram.Print (os);
+  NS_TEST_ASSERT_MSG_EQ ((os.str ().find ("ring,hops,lower,upper,count") == 0), true, "Missing CSV header");
+
+  histogram.Clear ();
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetCount (0, 0), 0, "Clear kept samples");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetBucketCount (0, 0, AoiHistogram::GetBucket (500000)), 0,
+                         "Clear kept bucket counts");
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief AoI histogram TestSuite
+ */
+class AoiHistogramTestSuite : public TestSuite
+{
+public:
+  AoiHistogramTestSuite ();
+};
+
+AoiHistogramTestSuite::AoiHistogramTestSuite ()
+  : TestSuite ("aoi-histogram", UNIT)
+{
+  AddTestCase (new AoiHistogramTestCase, TestCase::QUICK);
+}
+
+static AoiHistogramTestSuite aoiHistogramTestSuite; //!< Static variable for test initialization
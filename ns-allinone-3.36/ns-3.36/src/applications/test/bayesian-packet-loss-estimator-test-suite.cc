@@ -0,0 +1,245 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ns3/bayesian-packet-loss-estimator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Check the regularized incomplete beta function against closed forms.
+ */
+class IncompleteBetaTestCase : public TestCase
+{
+public:
+  IncompleteBetaTestCase ();
+  virtual ~IncompleteBetaTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \param x the upper bound of the integral
+   * \param a first integer parameter
+   * \param b second integer parameter
+   * \returns I_x(a, b) as the probability of at least a successes out of
+   *          a + b - 1 Bernoulli trials of probability x
+   */
+  static double BinomialTail (double x, int a, int b);
+};
+
+IncompleteBetaTestCase::IncompleteBetaTestCase ()
+  : TestCase ("Check the regularized incomplete beta function")
+{
+}
+
+IncompleteBetaTestCase::~IncompleteBetaTestCase ()
+{
+}
+
+double
+IncompleteBetaTestCase::BinomialTail (double x, int a, int b)
+{
+  int n = a + b - 1;
+  double sum = 0;
+  for (int j = a; j <= n; j++)
+    {
+      double logChoose = std::lgamma (n + 1.0) - std::lgamma (j + 1.0) - std::lgamma (n - j + 1.0);
+      sum += std::exp (logChoose + j * std::log (x) + (n - j) * std::log1p (-x));
+    }
+  return sum;
+}
+
+void
+IncompleteBetaTestCase::DoRun (void)
+{
+  const double tol = 1e-12;
+  // Bounds and the uniform distribution
+  NS_TEST_EXPECT_MSG_EQ (BayesianPacketLossEstimator::incompleteBeta (0.0, 2, 3), 0.0, "I_0");
+  NS_TEST_EXPECT_MSG_EQ (BayesianPacketLossEstimator::incompleteBeta (1.0, 2, 3), 1.0, "I_1");
+  NS_TEST_EXPECT_MSG_EQ_TOL (BayesianPacketLossEstimator::incompleteBeta (0.37, 1, 1), 0.37, tol, "I_x(1, 1)");
+  // I_x(a, 1) = x^a and I_x(1, b) = 1 - (1 - x)^b
+  NS_TEST_EXPECT_MSG_EQ_TOL (BayesianPacketLossEstimator::incompleteBeta (0.3, 2.5, 1), std::pow (0.3, 2.5), tol, "I_x(a, 1)");
+  NS_TEST_EXPECT_MSG_EQ_TOL (BayesianPacketLossEstimator::incompleteBeta (0.3, 1, 4.5), 1 - std::pow (0.7, 4.5), tol, "I_x(1, b)");
+  // Arcsine distribution: I_x(1/2, 1/2) = 2 / pi * asin (sqrt (x))
+  NS_TEST_EXPECT_MSG_EQ_TOL (BayesianPacketLossEstimator::incompleteBeta (0.25, 0.5, 0.5), 1.0 / 3, tol, "I_1/4(1/2, 1/2)");
+  NS_TEST_EXPECT_MSG_EQ_TOL (BayesianPacketLossEstimator::incompleteBeta (0.9, 0.5, 0.5),
+                             2 / M_PI * std::asin (std::sqrt (0.9)), tol, "I_0.9(1/2, 1/2)");
+  // Symmetric distributions have their median at 1/2
+  NS_TEST_EXPECT_MSG_EQ_TOL (BayesianPacketLossEstimator::incompleteBeta (0.5, 7.5, 7.5), 0.5, tol, "I_1/2(a, a)");
+  NS_TEST_EXPECT_MSG_EQ_TOL (BayesianPacketLossEstimator::incompleteBeta (0.35, 3.7, 1.2)
+                             + BayesianPacketLossEstimator::incompleteBeta (0.65, 1.2, 3.7), 1.0, tol, "Symmetry");
+  // Integer parameters, on both sides of the switch of the continued fraction
+  struct
+  {
+    double x;
+    int a;
+    int b;
+  } cases[] = {{0.25, 2, 3}, {0.4, 5, 10}, {0.9, 5, 10}, {0.6, 50, 30}, {0.01, 3, 400}, {0.02, 3, 400}};
+  for (const auto & c : cases)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (BayesianPacketLossEstimator::incompleteBeta (c.x, c.a, c.b),
+                                 BinomialTail (c.x, c.a, c.b), 1e-10,
+                                 "I_" << c.x << "(" << c.a << ", " << c.b << ")");
+    }
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Check the percentiles of the conjugate posterior found by bisection.
+ */
+class LossPercentileTestCase : public TestCase
+{
+public:
+  LossPercentileTestCase ();
+  virtual ~LossPercentileTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LossPercentileTestCase::LossPercentileTestCase ()
+  : TestCase ("Check the percentiles of the conjugate posterior")
+{
+}
+
+LossPercentileTestCase::~LossPercentileTestCase ()
+{
+}
+
+void
+LossPercentileTestCase::DoRun (void)
+{
+  BayesianPacketLossEstimator prior (BayesianPacketLossEstimator::CONJUGATE);
+  NS_TEST_EXPECT_MSG_EQ (prior.getLossPctl (0.0), 0.0, "0th percentile");
+  NS_TEST_EXPECT_MSG_EQ (prior.getLossPctl (1.0), 1.0, "100th percentile");
+  NS_TEST_EXPECT_MSG_EQ_TOL (prior.getLossPctl (0.42), 0.42, 1e-11, "Percentile of the uniform prior");
+
+  // Beta(1, 10): the CDF is 1 - (1 - x)^10
+  BayesianPacketLossEstimator noLoss (BayesianPacketLossEstimator::CONJUGATE);
+  noLoss.reportObservation (9, 0);
+  NS_TEST_EXPECT_MSG_EQ_TOL (noLoss.getLossPctl (0.95), 1 - std::pow (0.05, 0.1), 1e-11, "95th percentile without loss");
+
+  // Beta(8, 31): the percentile is where the CDF reaches the target
+  BayesianPacketLossEstimator estimator (BayesianPacketLossEstimator::CONJUGATE);
+  estimator.reportObservation (20, 5);
+  estimator.reportObservation (10, 2);
+  for (double target : {0.05, 0.5, 0.95, 0.999})
+    {
+      double pctl = estimator.getLossPctl (target);
+      NS_TEST_EXPECT_MSG_EQ_TOL (BayesianPacketLossEstimator::incompleteBeta (pctl, 8, 31), target, 1e-9,
+                                 "CDF at the percentile " << target);
+    }
+  NS_TEST_EXPECT_MSG_LT (estimator.getLossPctl (0.5), estimator.getLossPctl (0.95), "Increasing percentiles");
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Check that the grid and the conjugate posteriors agree on the same
+ * observations, including counts large enough to underflow the likelihood.
+ */
+class LossEstimatorModesTestCase : public TestCase
+{
+public:
+  LossEstimatorModesTestCase ();
+  virtual ~LossEstimatorModesTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Report the same observations to both modes and compare them
+   * \param observations pairs of success and failure counts
+   * \param name name of the observations
+   */
+  void Compare (const std::vector<std::pair<int, int> > &observations, std::string name);
+};
+
+LossEstimatorModesTestCase::LossEstimatorModesTestCase ()
+  : TestCase ("Check that the grid and conjugate posteriors agree")
+{
+}
+
+LossEstimatorModesTestCase::~LossEstimatorModesTestCase ()
+{
+}
+
+void
+LossEstimatorModesTestCase::Compare (const std::vector<std::pair<int, int> > &observations, std::string name)
+{
+  BayesianPacketLossEstimator grid (BayesianPacketLossEstimator::GRID);
+  BayesianPacketLossEstimator conjugate (BayesianPacketLossEstimator::CONJUGATE);
+  for (const auto & observation : observations)
+    {
+      grid.reportObservation (observation.first, observation.second);
+      conjugate.reportObservation (observation.first, observation.second);
+    }
+  // Within the step of the grid
+  NS_TEST_EXPECT_MSG_EQ (std::isnan (grid.getExpectedLoss ()), false, "Expected loss of " << name);
+  NS_TEST_EXPECT_MSG_EQ_TOL (grid.getExpectedLoss (), conjugate.getExpectedLoss (), 1e-3, "Expected loss of " << name);
+  NS_TEST_EXPECT_MSG_EQ_TOL (grid.getMostLikelyLoss (), conjugate.getMostLikelyLoss (), 1e-3, "Most likely loss of " << name);
+  for (double target : {0.05, 0.5, 0.95})
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (grid.getLossPctl (target), conjugate.getLossPctl (target), 2e-3,
+                                 "Percentile " << target << " of " << name);
+    }
+}
+
+void
+LossEstimatorModesTestCase::DoRun (void)
+{
+  Compare ({}, "the prior");
+  Compare ({{30, 7}}, "one observation");
+  Compare ({{3, 1}, {5, 0}, {0, 2}, {12, 4}}, "several observations");
+  Compare ({{200, 0}}, "no loss");
+  // Multiplying the probabilities of the candidates underflowed to 0 / 0
+  Compare ({{10, 100000}}, "a large failure count");
+  Compare ({{100000, 40}}, "a large success count");
+  Compare ({{0, 1000}, {0, 1000}, {5, 1000}}, "repeated large failure counts");
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Bayesian packet loss estimator test suite
+ */
+class BayesianPacketLossEstimatorTestSuite : public TestSuite
+{
+public:
+  BayesianPacketLossEstimatorTestSuite ();
+};
+
+BayesianPacketLossEstimatorTestSuite::BayesianPacketLossEstimatorTestSuite ()
+  : TestSuite ("bayesian-packet-loss-estimator", UNIT)
+{
+  AddTestCase (new IncompleteBetaTestCase, TestCase::QUICK);
+  AddTestCase (new LossPercentileTestCase, TestCase::QUICK);
+  AddTestCase (new LossEstimatorModesTestCase, TestCase::QUICK);
+}
+
+static BayesianPacketLossEstimatorTestSuite bayesianPacketLossEstimatorTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/duplicate-filter.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Check the sequence numbers seen within the window of a source, in any
+ * order, independently of the other sources.
+ */
+class DuplicateFilterWindowTestCase : public TestCase
+{
+public:
+  DuplicateFilterWindowTestCase ();
+  virtual ~DuplicateFilterWindowTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+DuplicateFilterWindowTestCase::DuplicateFilterWindowTestCase ()
+  : TestCase ("Check the bitmap window")
+{
+}
+
+DuplicateFilterWindowTestCase::~DuplicateFilterWindowTestCase ()
+{
+}
+
+void
+DuplicateFilterWindowTestCase::DoRun (void)
+{
+  DuplicateFilter filter (64);
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 10), false, "Unknown source");
+  NS_TEST_EXPECT_MSG_EQ (filter.MarkSeen (1, 10), true, "First reception");
+  NS_TEST_EXPECT_MSG_EQ (filter.MarkSeen (1, 10), false, "Duplicate");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 10), true, "Seen");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 11), false, "Newer than the highest sequence number");
+
+  // Out of order, within the window
+  NS_TEST_EXPECT_MSG_EQ (filter.MarkSeen (1, 5), true, "Late first reception");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 5), true, "Late reception seen");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 6), false, "Gap in the window");
+  NS_TEST_EXPECT_MSG_EQ (filter.MarkSeen (1, 30), true, "Newer reception");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 10), true, "Still in the window");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 20), false, "Gap below the highest sequence number");
+
+  // The sources are independent
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (2, 10), false, "Other source");
+  NS_TEST_EXPECT_MSG_EQ (filter.MarkSeen (2, 10), true, "First reception of the other source");
+  NS_TEST_EXPECT_MSG_EQ (filter.GetNSources (), 2, "Sources");
+  filter.Remove (1);
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 10), false, "Removed source");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (2, 10), true, "Remaining source");
+  NS_TEST_EXPECT_MSG_EQ (filter.GetNSources (), 1, "Sources after Remove");
+  filter.Clear ();
+  NS_TEST_EXPECT_MSG_EQ (filter.GetNSources (), 0, "Sources after Clear");
+
+  // Sequence numbers wrap around
+  NS_TEST_EXPECT_MSG_EQ (filter.MarkSeen (3, 0xfffffff0), true, "Before the wrap");
+  NS_TEST_EXPECT_MSG_EQ (filter.MarkSeen (3, 5), true, "After the wrap");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (3, 0xfffffff0), true, "Before the wrap, still in the window");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (3, 0xfffffff8), false, "Gap across the wrap");
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Check that the window follows the highest sequence number, recycling the
+ * slots of the sequence numbers leaving it, and that the sequence numbers
+ * older than the window are reported as seen.
+ */
+class DuplicateFilterShiftTestCase : public TestCase
+{
+public:
+  DuplicateFilterShiftTestCase ();
+  virtual ~DuplicateFilterShiftTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+DuplicateFilterShiftTestCase::DuplicateFilterShiftTestCase ()
+  : TestCase ("Check the shift of the window and the old sequence numbers")
+{
+}
+
+DuplicateFilterShiftTestCase::~DuplicateFilterShiftTestCase ()
+{
+}
+
+void
+DuplicateFilterShiftTestCase::DoRun (void)
+{
+  DuplicateFilter filter (64);
+  filter.MarkSeen (1, 2);
+  filter.MarkSeenTwice (1, 3);
+  NS_TEST_EXPECT_MSG_EQ (filter.MarkSeen (1, 65), true, "Shift by 62");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 2), true, "Oldest sequence number of the window");
+  // 66 and 67 take the slots of 2 and 3, which were seen
+  NS_TEST_EXPECT_MSG_EQ (filter.MarkSeen (1, 66), true, "Recycled slot");
+  NS_TEST_EXPECT_MSG_EQ (filter.MarkSeen (1, 67), true, "Recycled slot of a packet seen twice");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeenTwice (1, 67), false, "Recycled twice bit");
+
+  // Older than the window: reported as seen and seen twice, not recorded
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 3), true, "Behind the window");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeenTwice (1, 3), true, "Behind the window, twice");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 1), true, "Never seen, behind the window");
+  NS_TEST_EXPECT_MSG_EQ (filter.MarkSeen (1, 1), false, "Stale packet");
+  filter.MarkSeenTwice (1, 1);
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 65), true, "The stale packet does not move the window");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 4), false, "Not seen, in the window");
+
+  // A jump beyond the window forgets everything
+  NS_TEST_EXPECT_MSG_EQ (filter.MarkSeen (1, 1000), true, "Jump");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 999), false, "Empty window after a jump");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 937), false, "Oldest slot after a jump");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 936), true, "Behind the window after a jump");
+
+  // The window size is rounded up to a multiple of 64
+  DuplicateFilter rounded (100);
+  rounded.MarkSeen (1, 0);
+  rounded.MarkSeen (1, 127);
+  NS_TEST_EXPECT_MSG_EQ (rounded.IsSeen (1, 0), true, "Window of 128");
+  NS_TEST_EXPECT_MSG_EQ (rounded.MarkSeen (1, 1), true, "Inside the window of 128");
+  rounded.MarkSeen (1, 128);
+  NS_TEST_EXPECT_MSG_EQ (rounded.MarkSeen (1, 0), false, "Behind the window of 128");
+  NS_TEST_EXPECT_MSG_EQ (rounded.IsSeen (1, 1), true, "Oldest sequence number of the window of 128");
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Check that the seen and seen twice states are kept apart.
+ */
+class DuplicateFilterTwiceTestCase : public TestCase
+{
+public:
+  DuplicateFilterTwiceTestCase ();
+  virtual ~DuplicateFilterTwiceTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+DuplicateFilterTwiceTestCase::DuplicateFilterTwiceTestCase ()
+  : TestCase ("Check the seen and seen twice states")
+{
+}
+
+DuplicateFilterTwiceTestCase::~DuplicateFilterTwiceTestCase ()
+{
+}
+
+void
+DuplicateFilterTwiceTestCase::DoRun (void)
+{
+  DuplicateFilter filter (64);
+  filter.MarkSeen (1, 10);
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeenTwice (1, 10), false, "Seen once");
+  filter.MarkSeenTwice (1, 10);
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 10), true, "Seen twice is seen");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeenTwice (1, 10), true, "Seen twice");
+
+  // Seen twice directly, as a forwarder hearing a copy does
+  filter.MarkSeenTwice (1, 12);
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 12), true, "Marked seen along");
+  NS_TEST_EXPECT_MSG_EQ (filter.MarkSeen (1, 12), false, "Already seen");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeenTwice (1, 11), false, "Neighbour not seen twice");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeen (1, 11), false, "Neighbour not seen");
+  NS_TEST_EXPECT_MSG_EQ (filter.IsSeenTwice (2, 12), false, "Other source");
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Duplicate filter test suite
+ */
+class DuplicateFilterTestSuite : public TestSuite
+{
+public:
+  DuplicateFilterTestSuite ();
+};
+
+DuplicateFilterTestSuite::DuplicateFilterTestSuite ()
+  : TestSuite ("duplicate-filter", UNIT)
+{
+  AddTestCase (new DuplicateFilterWindowTestCase, TestCase::QUICK);
+  AddTestCase (new DuplicateFilterShiftTestCase, TestCase::QUICK);
+  AddTestCase (new DuplicateFilterTwiceTestCase, TestCase::QUICK);
+}
+
+static DuplicateFilterTestSuite duplicateFilterTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,241 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/double.h"
+#include "ns3/flooding-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/pure-flooding-application.h"
+#include "ns3/rate-decay-flooding-application.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+namespace {
+
+/**
+ * Create nodes 100 m apart on a line, all in range of each other, sharing
+ * a SimpleChannel
+ *
+ * \param n number of nodes
+ * \returns the nodes
+ */
+NodeContainer
+CreateLine (uint32_t n)
+{
+  NodeContainer nodes;
+  nodes.Create (n);
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (100),
+                                 "GridWidth", UintegerValue (n));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+  SimpleNetDeviceHelper simple;
+  simple.Install (nodes);
+  return nodes;
+}
+
+} // unnamed namespace
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Set LossRate on running RateDecayFloodingApps, as a variant forked after
+ * the warm-up does, and check that the loss estimation starts above 1 and
+ * stops otherwise.
+ */
+class FloodingLossRateTestCase : public TestCase
+{
+public:
+  FloodingLossRateTestCase ();
+  virtual ~FloodingLossRateTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Set the LossRate attribute of the application
+   * \param app the application
+   * \param lossRate the loss rate
+   */
+  static void SetLossRate (Ptr<RateDecayFloodingApp> app, double lossRate);
+
+  /**
+   * Record the LossRate attribute of the application
+   * \param app the application
+   * \param lossRate the recorded loss rate
+   */
+  static void GetLossRate (Ptr<RateDecayFloodingApp> app, double *lossRate);
+};
+
+FloodingLossRateTestCase::FloodingLossRateTestCase ()
+  : TestCase ("Check that LossRate takes effect on a running application")
+{
+}
+
+FloodingLossRateTestCase::~FloodingLossRateTestCase ()
+{
+}
+
+void
+FloodingLossRateTestCase::SetLossRate (Ptr<RateDecayFloodingApp> app, double lossRate)
+{
+  app->SetAttribute ("LossRate", DoubleValue (lossRate));
+}
+
+void
+FloodingLossRateTestCase::GetLossRate (Ptr<RateDecayFloodingApp> app, double *lossRate)
+{
+  DoubleValue value;
+  app->GetAttribute ("LossRate", value);
+  *lossRate = value.Get ();
+}
+
+void
+FloodingLossRateTestCase::DoRun (void)
+{
+  NodeContainer nodes = CreateLine (3);
+  InternetStackHelper internet;
+  internet.Install (nodes);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.0.0", "255.255.0.0");
+  NetDeviceContainer devices;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      devices.Add (nodes.Get (i)->GetDevice (0));
+    }
+  ipv4.Assign (devices);
+
+  // The applications broadcast to port 3000
+  RateDecayFloodingAppHelper helper (3000, Seconds (1), Seconds (0.11), 100, 500, 1.5, 0, 0.3);
+  ApplicationContainer apps = helper.Install (nodes);
+  helper.AssignStreams (nodes, 0);
+  apps.Start (Seconds (0));
+  Ptr<RateDecayFloodingApp> app = apps.Get (0)->GetObject<RateDecayFloodingApp> ();
+
+  double beforeEstimation;
+  double estimated;
+  double afterEstimation;
+  Simulator::Schedule (Seconds (5), &FloodingLossRateTestCase::GetLossRate, app, &beforeEstimation);
+  Simulator::Schedule (Seconds (5), &FloodingLossRateTestCase::SetLossRate, app, 2.0);
+  Simulator::Schedule (Seconds (10), &FloodingLossRateTestCase::GetLossRate, app, &estimated);
+  Simulator::Schedule (Seconds (10), &FloodingLossRateTestCase::SetLossRate, app, 0.3);
+  Simulator::Schedule (Seconds (15), &FloodingLossRateTestCase::GetLossRate, app, &afterEstimation);
+  Simulator::Stop (Seconds (20));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (beforeEstimation, 0.3, "Configured loss rate");
+  // Nothing is lost on the SimpleChannel
+  NS_TEST_EXPECT_MSG_LT (estimated, 0.3, "The loss rate was not estimated");
+  NS_TEST_EXPECT_MSG_EQ (afterEstimation, 0.3, "The estimation was not stopped");
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Flood a chain of nodes without an IP stack over PACKET_TRANSPORT, the
+ * nodes hearing only their neighbours, and check that every node receives
+ * the updates of every other one.
+ */
+class FloodingPacketTransportTestCase : public TestCase
+{
+public:
+  FloodingPacketTransportTestCase ();
+  virtual ~FloodingPacketTransportTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FloodingPacketTransportTestCase::FloodingPacketTransportTestCase ()
+  : TestCase ("Check that the updates are flooded over packet sockets")
+{
+}
+
+FloodingPacketTransportTestCase::~FloodingPacketTransportTestCase ()
+{
+}
+
+void
+FloodingPacketTransportTestCase::DoRun (void)
+{
+  const uint32_t n = 4;
+  NodeContainer nodes = CreateLine (n);
+  Ptr<SimpleNetDevice> first = DynamicCast<SimpleNetDevice> (nodes.Get (0)->GetDevice (0));
+  Ptr<SimpleChannel> channel = DynamicCast<SimpleChannel> (first->GetChannel ());
+  for (uint32_t i = 0; i < n; i++)
+    {
+      for (uint32_t j = 0; j < n; j++)
+        {
+          if (i + 1 < j || j + 1 < i)
+            {
+              channel->BlackList (DynamicCast<SimpleNetDevice> (nodes.Get (i)->GetDevice (0)),
+                                  DynamicCast<SimpleNetDevice> (nodes.Get (j)->GetDevice (0)));
+            }
+        }
+    }
+
+  PureFloodingAppHelper helper (9, Seconds (1), Seconds (0.01), 100, 1.0);
+  helper.SetTransport (PACKET_TRANSPORT);
+  ApplicationContainer apps = helper.Install (nodes);
+  helper.AssignStreams (nodes, 0);
+  apps.Start (Seconds (0));
+  // The applications keep their send events past Stop
+  Simulator::Stop (Seconds (5));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<PureFloodingApp> app = apps.Get (i)->GetObject<PureFloodingApp> ();
+      NS_TEST_EXPECT_MSG_GT (app->GetNumSent (), 0, "Node " << i << " sent nothing");
+      NS_TEST_EXPECT_MSG_EQ (app->GetNumSeenNodes (), n - 1, "Sources seen by node " << i);
+    }
+  // The ends only hear each other through the two middle nodes
+  NS_TEST_EXPECT_MSG_GT (apps.Get (1)->GetObject<PureFloodingApp> ()->GetNumFwd (), 0, "Nothing forwarded");
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Flooding application test suite
+ */
+class FloodingApplicationTestSuite : public TestSuite
+{
+public:
+  FloodingApplicationTestSuite ();
+};
+
+FloodingApplicationTestSuite::FloodingApplicationTestSuite ()
+  : TestSuite ("flooding-application", UNIT)
+{
+  AddTestCase (new FloodingLossRateTestCase, TestCase::QUICK);
+  AddTestCase (new FloodingPacketTransportTestCase, TestCase::QUICK);
+}
+
+static FloodingApplicationTestSuite floodingApplicationTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,232 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/contention-based-flooding-header.h"
+#include "ns3/rate-decay-flooding-nc-header.h"
+#include "ns3/rate-decay-flooding-agg-header.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Check that the flooding headers write exactly GetSerializedSize bytes and
+ * read back what was written, in both wire formats.
+ */
+class FloodingHeaderTestCase : public TestCase
+{
+public:
+  FloodingHeaderTestCase ();
+  virtual ~FloodingHeaderTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /// Serialize and deserialize the headers at the current time
+  void CheckRoundTrip (void);
+
+  /**
+   * \param a the first position
+   * \param b the second position
+   * \param tolerance the tolerance on each coordinate
+   * \returns true if the positions are equal within the tolerance
+   */
+  static bool IsClose (Vector a, Vector b, double tolerance);
+};
+
+FloodingHeaderTestCase::FloodingHeaderTestCase ()
+  : TestCase ("Check the serialization of the flooding headers")
+{
+}
+
+FloodingHeaderTestCase::~FloodingHeaderTestCase ()
+{
+}
+
+bool
+FloodingHeaderTestCase::IsClose (Vector a, Vector b, double tolerance)
+{
+  return std::abs (a.x - b.x) <= tolerance && std::abs (a.y - b.y) <= tolerance
+         && std::abs (a.z - b.z) <= tolerance;
+}
+
+void
+FloodingHeaderTestCase::CheckRoundTrip (void)
+{
+  FloodingHeaderCodec::Format formats[] = {FloodingHeaderCodec::FIXED, FloodingHeaderCodec::COMPACT};
+  // The fixed format truncates the positions to whole meters
+  double tolerances[] = {1.0, FloodingHeaderCodec::POSITION_RESOLUTION / 2 + 1e-9};
+  Time ts = Simulator::Now () - MilliSeconds (250);
+
+  for (uint32_t f = 0; f < 2; f++)
+    {
+      ContentionBasedFloodingHeader header;
+      header.SetFormat (formats[f]);
+      header.SetSeq (300000);
+      header.SetSrc (42);
+      header.SetLastHop (7);
+      header.SetNumHops (3);
+      header.SetTs (ts);
+      header.SetStartPos (Vector (1234.56, 20.04, 1.5));
+      header.SetLastPos (Vector (1500.23, 15.0, 1.5));
+
+      Ptr<Packet> packet = Create<Packet> (10);
+      packet->AddHeader (header);
+      NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 10 + header.GetSerializedSize (), "Wrong serialized size");
+
+      ContentionBasedFloodingHeader read;
+      uint32_t n = packet->RemoveHeader (read);
+      NS_TEST_ASSERT_MSG_EQ (n, header.GetSerializedSize (), "Deserialize read a different size");
+      NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 10, "Payload not left intact");
+      NS_TEST_ASSERT_MSG_EQ (read.GetFormat (), formats[f], "Wrong format");
+      NS_TEST_ASSERT_MSG_EQ (read.GetSeq (), 300000, "Wrong seq");
+      NS_TEST_ASSERT_MSG_EQ (read.GetSrc (), 42, "Wrong src");
+      NS_TEST_ASSERT_MSG_EQ (read.GetLastHop (), 7, "Wrong last hop");
+      NS_TEST_ASSERT_MSG_EQ (read.GetNumHops (), 3, "Wrong number of hops");
+      NS_TEST_ASSERT_MSG_EQ (read.GetTs (), ts, "Wrong timestamp");
+      NS_TEST_ASSERT_MSG_EQ (IsClose (read.GetStartPos (), header.GetStartPos (), tolerances[f]), true,
+                             "Wrong start position");
+      NS_TEST_ASSERT_MSG_EQ (IsClose (read.GetLastPos (), header.GetLastPos (), tolerances[f]), true,
+                             "Wrong last position");
+    }
+
+  ContentionBasedFloodingHeader fixed;
+  fixed.SetFormat (FloodingHeaderCodec::FIXED);
+  ContentionBasedFloodingHeader compact;
+  NS_TEST_ASSERT_MSG_LT (compact.GetSerializedSize (), fixed.GetSerializedSize (),
+                         "The compact format should be shorter");
+
+  for (uint32_t f = 0; f < 2; f++)
+    {
+      for (bool coded : {false, true})
+        {
+          RateDecayFloodingNcHeader header;
+          header.SetFormat (formats[f]);
+          header.SetSeqLeft (12);
+          header.SetSrcLeft (5);
+          header.SetNumHopsLeft (1);
+          header.SetTsLeft (ts);
+          header.SetStartPosLeft (Vector (100.0, 5.0, 0.0));
+          header.SetLastHop (9);
+          header.SetLastPos (Vector (400.0, 10.0, 0.0));
+          if (coded)
+            {
+              header.SetSeqRight (70000);
+              header.SetSrcRight (130);
+              header.SetNumHopsRight (4);
+              header.SetTsRight (ts - MilliSeconds (100));
+              header.SetStartPosRight (Vector (900.0, 0.0, 0.0));
+            }
+
+          Ptr<Packet> packet = Create<Packet> (10);
+          packet->AddHeader (header);
+          NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 10 + header.GetSerializedSize (), "Wrong serialized size");
+
+          RateDecayFloodingNcHeader read;
+          uint32_t n = packet->RemoveHeader (read);
+          NS_TEST_ASSERT_MSG_EQ (n, header.GetSerializedSize (), "Deserialize read a different size");
+          NS_TEST_ASSERT_MSG_EQ (read.GetSeqLeft (), 12, "Wrong left seq");
+          NS_TEST_ASSERT_MSG_EQ (read.GetSrcLeft (), 5, "Wrong left src");
+          NS_TEST_ASSERT_MSG_EQ (read.GetNumHopsLeft (), 1, "Wrong left number of hops");
+          NS_TEST_ASSERT_MSG_EQ (read.GetTsLeft (), ts, "Wrong left timestamp");
+          NS_TEST_ASSERT_MSG_EQ (read.GetLastHop (), 9, "Wrong last hop");
+          NS_TEST_ASSERT_MSG_EQ (IsClose (read.GetStartPosLeft (), header.GetStartPosLeft (), tolerances[f]), true,
+                                 "Wrong left start position");
+          NS_TEST_ASSERT_MSG_EQ (IsClose (read.GetLastPos (), header.GetLastPos (), tolerances[f]), true,
+                                 "Wrong last position");
+          NS_TEST_ASSERT_MSG_EQ (read.GetSrcRight (), header.GetSrcRight (), "Wrong right src");
+          if (coded)
+            {
+              NS_TEST_ASSERT_MSG_EQ (read.GetSeqRight (), 70000, "Wrong right seq");
+              NS_TEST_ASSERT_MSG_EQ (read.GetNumHopsRight (), 4, "Wrong right number of hops");
+              NS_TEST_ASSERT_MSG_EQ (read.GetTsRight (), ts - MilliSeconds (100), "Wrong right timestamp");
+              NS_TEST_ASSERT_MSG_EQ (IsClose (read.GetStartPosRight (), header.GetStartPosRight (), tolerances[f]),
+                                     true, "Wrong right start position");
+            }
+        }
+    }
+
+  for (uint32_t f = 0; f < 2; f++)
+    {
+      RateDecayFloodingAggHeader header;
+      header.SetFormat (formats[f]);
+      header.SetLastHop (9);
+      header.SetLastPos (Vector (400.0, 10.0, 0.0));
+      for (uint32_t k = 0; k < 5; k++)
+        {
+          header.AddRecord (100 + k, 70000 + k, k, ts - MilliSeconds (10 * k), Vector (300.0 + 50 * k, 5.0, 0.0));
+        }
+
+      Ptr<Packet> packet = Create<Packet> (10);
+      packet->AddHeader (header);
+      NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 10 + header.GetSerializedSize (), "Wrong serialized size");
+      uint8_t version;
+      packet->CopyData (&version, 1);
+      NS_TEST_ASSERT_MSG_EQ (((version & FloodingHeaderCodec::AGGREGATE) != 0), true, "Aggregate flag not set");
+
+      RateDecayFloodingAggHeader read;
+      uint32_t n = packet->RemoveHeader (read);
+      NS_TEST_ASSERT_MSG_EQ (n, header.GetSerializedSize (), "Deserialize read a different size");
+      NS_TEST_ASSERT_MSG_EQ (read.GetFormat (), formats[f], "Wrong format");
+      NS_TEST_ASSERT_MSG_EQ (read.GetLastHop (), 9, "Wrong last hop");
+      NS_TEST_ASSERT_MSG_EQ (IsClose (read.GetLastPos (), header.GetLastPos (), tolerances[f]), true,
+                             "Wrong last position");
+      NS_TEST_ASSERT_MSG_EQ (read.GetNRecords (), 5, "Wrong number of records");
+      for (uint32_t k = 0; k < 5; k++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (read.GetRecord (k).src, 100 + k, "Wrong src");
+          NS_TEST_ASSERT_MSG_EQ (read.GetRecord (k).seq, 70000 + k, "Wrong seq");
+          NS_TEST_ASSERT_MSG_EQ (read.GetRecord (k).numHops, k, "Wrong number of hops");
+          NS_TEST_ASSERT_MSG_EQ (read.GetTs (k), ts - MilliSeconds (10 * k), "Wrong timestamp");
+          NS_TEST_ASSERT_MSG_EQ (IsClose (read.GetRecord (k).startPos, header.GetRecord (k).startPos, tolerances[f]),
+                                 true, "Wrong start position");
+        }
+    }
+}
+
+void
+FloodingHeaderTestCase::DoRun (void)
+{
+  // Also past the 32 bit wrap of the timestamp in microseconds
+  Simulator::Schedule (Seconds (1), &FloodingHeaderTestCase::CheckRoundTrip, this);
+  Simulator::Schedule (Seconds (5000), &FloodingHeaderTestCase::CheckRoundTrip, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Flooding headers TestSuite
+ */
+class FloodingHeaderTestSuite : public TestSuite
+{
+public:
+  FloodingHeaderTestSuite ();
+};
+
+FloodingHeaderTestSuite::FloodingHeaderTestSuite ()
+  : TestSuite ("flooding-header", UNIT)
+{
+  AddTestCase (new FloodingHeaderTestCase, TestCase::QUICK);
+}
+
+static FloodingHeaderTestSuite floodingHeaderTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ns3/flooding-kpi-sampler.h"
+#include "ns3/node-container.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Check the lines written by the sampler, with counters incremented as the
+ * applications would, before and after the reset of the warm-up.
+ */
+class FloodingKpiSamplerTestCase : public TestCase
+{
+public:
+  FloodingKpiSamplerTestCase ();
+  virtual ~FloodingKpiSamplerTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Count updates in the counters of the sampler
+   * \param counters the counters
+   * \param inTime updates received in time
+   * \param late updates received late
+   */
+  static void Count (Ptr<FloodingCounters> counters, uint64_t inTime, uint64_t late);
+};
+
+FloodingKpiSamplerTestCase::FloodingKpiSamplerTestCase ()
+  : TestCase ("Check the windowed KPIs")
+{
+}
+
+FloodingKpiSamplerTestCase::~FloodingKpiSamplerTestCase ()
+{
+}
+
+void
+FloodingKpiSamplerTestCase::Count (Ptr<FloodingCounters> counters, uint64_t inTime, uint64_t late)
+{
+  counters->sent++;
+  counters->seenPairs++;
+  counters->receivedInTime += inTime;
+  counters->receivedLate += late;
+  counters->received += inTime + late;
+  counters->forwarded += late;
+}
+
+void
+FloodingKpiSamplerTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (5);
+  std::string file = CreateTempDirFilename ("kpi.csv");
+
+  FloodingKpiSampler sampler;
+  sampler.SetInterval (Seconds (10));
+  sampler.Install (nodes);
+  sampler.Open (file);
+  Ptr<FloodingCounters> counters = sampler.GetCounters ();
+
+  // Warm-up, reset at 5 s
+  Simulator::Schedule (Seconds (1), &FloodingKpiSamplerTestCase::Count, counters, 7, 7);
+  Simulator::Schedule (Seconds (5), &FloodingKpiSampler::Start, &sampler);
+  // First window [5, 15] s, nothing received in the second, 3 s in the third
+  Simulator::Schedule (Seconds (6), &FloodingKpiSamplerTestCase::Count, counters, 3, 1);
+  Simulator::Schedule (Seconds (7), &FloodingKpiSamplerTestCase::Count, counters, 0, 0);
+  Simulator::Schedule (Seconds (26), &FloodingKpiSamplerTestCase::Count, counters, 2, 2);
+  Simulator::Stop (Seconds (28));
+  Simulator::Run ();
+  sampler.Finish ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ_TOL (sampler.GetDeliveryProbability (), 3.0 / 20, 1e-12, "P_D since the warm-up");
+  NS_TEST_ASSERT_MSG_EQ_TOL (sampler.GetExcessProbability (), 3.0 / 8, 1e-12, "P_EX since the warm-up");
+
+  std::ifstream in (file);
+  std::string line;
+  std::getline (in, line);
+  NS_TEST_ASSERT_MSG_EQ (line, "timestamp,pd,pe500,sumSent,sumSentCoded,sumRcvd,sumFwd,"
+                         "windowPe500,windowSent,windowSentCoded,windowRcvd,windowFwd", "Header");
+  std::vector<std::vector<double> > rows;
+  while (std::getline (in, line))
+    {
+      std::vector<double> row;
+      std::istringstream fields (line);
+      std::string field;
+      while (std::getline (fields, field, ','))
+        {
+          row.push_back (std::stod (field));
+        }
+      NS_TEST_ASSERT_MSG_EQ (row.size (), 12, "Columns of " << line);
+      rows.push_back (row);
+    }
+  // 15 s, 25 s and the last window ending at 28 s
+  NS_TEST_ASSERT_MSG_EQ (rows.size (), 3, "Lines");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[0][0], 15.0, 1e-9, "Time of the first window");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[0][1], 2.0 / 20, 1e-6, "P_D of the first window");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[0][2], 0.25, 1e-6, "P_EX of the first window");
+  NS_TEST_EXPECT_MSG_EQ (rows[0][3], 2, "Sent in the first window");
+  NS_TEST_EXPECT_MSG_EQ (rows[0][5], 4, "Received in the first window");
+  NS_TEST_EXPECT_MSG_EQ (std::isnan (rows[1][7]), true, "P_EX of a window without receptions");
+  NS_TEST_EXPECT_MSG_EQ (rows[1][8], 0, "Sent in the second window");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[1][2], 0.25, 1e-6, "P_EX since the warm-up at 25 s");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[2][0], 28.0, 1e-9, "Time of the last window");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[2][2], 3.0 / 8, 1e-6, "P_EX at the end");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[2][7], 0.5, 1e-6, "P_EX of the last window");
+  NS_TEST_EXPECT_MSG_EQ (rows[2][3], 3, "Sent since the warm-up");
+  NS_TEST_EXPECT_MSG_EQ (rows[2][6], 3, "Forwarded since the warm-up");
+  NS_TEST_EXPECT_MSG_EQ (rows[2][11], 2, "Forwarded in the last window");
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Flooding KPI sampler test suite
+ */
+class FloodingKpiSamplerTestSuite : public TestSuite
+{
+public:
+  FloodingKpiSamplerTestSuite ();
+};
+
+FloodingKpiSamplerTestSuite::FloodingKpiSamplerTestSuite ()
+  : TestSuite ("flooding-kpi-sampler", UNIT)
+{
+  AddTestCase (new FloodingKpiSamplerTestCase, TestCase::QUICK);
+}
+
+static FloodingKpiSamplerTestSuite floodingKpiSamplerTestSuite; //!< Static variable for test initialization
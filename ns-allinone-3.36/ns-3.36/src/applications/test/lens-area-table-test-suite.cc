@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <vector>
+#include "ns3/lens-area-table.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Check the tabulated overlap area of two circles against the closed form,
+ * within the error bound reported by the table.
+ */
+class LensAreaTableTestCase : public TestCase
+{
+public:
+  LensAreaTableTestCase ();
+  virtual ~LensAreaTableTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Check the table for the given radius.
+   * \param radius the radius of the circles
+   * \param nIntervals the number of interpolation intervals
+   */
+  void CheckRadius (double radius, uint32_t nIntervals);
+};
+
+LensAreaTableTestCase::LensAreaTableTestCase ()
+  : TestCase ("Check the tabulated lens area against the closed form")
+{
+}
+
+LensAreaTableTestCase::~LensAreaTableTestCase ()
+{
+}
+
+void
+LensAreaTableTestCase::CheckRadius (double radius, uint32_t nIntervals)
+{
+  LensAreaTable table (radius, nIntervals);
+  double bound = table.GetErrorBound ();
+  // Slack for the rounding errors of the closed form itself
+  double tolerance = bound + 1e-12 * radius * radius;
+
+  // The bound is dominated by the last interval, where the error grows
+  // like h^1.5; it must stay a small fraction of the circle area
+  NS_TEST_ASSERT_MSG_GT (bound, 0, "The error bound must be positive");
+  NS_TEST_ASSERT_MSG_LT (bound, 1e-3 * M_PI * radius * radius, "Error bound too large");
+
+  NS_TEST_ASSERT_MSG_EQ_TOL (table.GetOverlap (0), M_PI * radius * radius, tolerance,
+                             "Concentric circles overlap completely");
+  NS_TEST_ASSERT_MSG_EQ (table.GetOverlap (2 * radius), 0, "Tangent circles do not overlap");
+  NS_TEST_ASSERT_MSG_EQ (table.GetOverlap (3 * radius), 0, "Distant circles do not overlap");
+
+  // Dense sweep, including the points between the table entries and the
+  // steep part close to 2R
+  uint32_t nPoints = 20 * nIntervals;
+  std::vector<double> d;
+  for (uint32_t i = 0; i <= nPoints; i++)
+    {
+      d.push_back (2 * radius * i / nPoints);
+    }
+  for (uint32_t i = 1; i <= 100; i++)
+    {
+      d.push_back (2 * radius * (1 - std::pow (10.0, -0.1 * i)));
+    }
+  double maxError = 0;
+  for (double x : d)
+    {
+      double error = std::fabs (table.GetOverlap (x) - LensAreaTable::ComputeOverlap (x, radius));
+      maxError = std::max (maxError, error);
+    }
+  NS_TEST_ASSERT_MSG_LT_OR_EQ (maxError, tolerance, "Interpolation error above the bound for R=" << radius);
+
+  std::vector<double> batch (d.size ());
+  table.GetOverlaps (d.data (), batch.data (), d.size ());
+  for (size_t i = 0; i < d.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (batch[i], table.GetOverlap (d[i]), "Batched and scalar lookups differ");
+    }
+}
+
+void
+LensAreaTableTestCase::DoRun (void)
+{
+  CheckRadius (500.0, 4096);
+  CheckRadius (509.003, 4096);
+  CheckRadius (1.0, 64);
+
+  // Changing the radius rebuilds the table
+  LensAreaTable table (100.0);
+  table.SetRadius (200.0);
+  NS_TEST_ASSERT_MSG_EQ (table.GetRadius (), 200.0, "Radius not updated");
+  NS_TEST_ASSERT_MSG_EQ_TOL (table.GetOverlap (0), M_PI * 200.0 * 200.0, table.GetErrorBound (),
+                             "Table not rebuilt for the new radius");
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * \brief Lens area table TestSuite
+ */
+class LensAreaTableTestSuite : public TestSuite
+{
+public:
+  LensAreaTableTestSuite ();
+};
+
+LensAreaTableTestSuite::LensAreaTableTestSuite ()
+  : TestSuite ("lens-area-table", UNIT)
+{
+  AddTestCase (new LensAreaTableTestCase, TestCase::QUICK);
+}
+
+static LensAreaTableTestSuite lensAreaTableTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/reception-ratio-helper.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/node-container.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Check the potential receivers found with the spatial grid against a
+ * linear scan, with moving nodes and a grid older than the send times, and
+ * the accounting of the receptions.
+ */
+class ReceptionRatioHelperTestCase : public TestCase
+{
+public:
+  ReceptionRatioHelperTestCase ();
+  virtual ~ReceptionRatioHelperTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Send an update from a node and check its potential receivers
+   * \param src the sender
+   */
+  void Send (uint32_t src);
+
+  static constexpr double RANGE = 509.8;  //!< range of the helper
+
+  NodeContainer m_nodes;                  //!< nodes
+  ReceptionRatioHelper *m_helper;         //!< helper under test
+  uint32_t m_seq;                         //!< next sequence number
+};
+
+ReceptionRatioHelperTestCase::ReceptionRatioHelperTestCase ()
+  : TestCase ("Check the online reception ratio accounting"),
+    m_helper (0),
+    m_seq (0)
+{
+}
+
+ReceptionRatioHelperTestCase::~ReceptionRatioHelperTestCase ()
+{
+}
+
+void
+ReceptionRatioHelperTestCase::Send (uint32_t src)
+{
+  Vector position = m_nodes.Get (src)->GetObject<MobilityModel> ()->GetPosition ();
+  uint64_t expected = 0;
+  for (uint32_t i = 0; i < m_nodes.GetN (); i++)
+    {
+      Vector other = m_nodes.Get (i)->GetObject<MobilityModel> ()->GetPosition ();
+      if (i != src && CalculateDistance (position, other) <= RANGE)
+        {
+          expected++;
+        }
+    }
+  uint64_t before = m_helper->GetPotentialReceivers ();
+  m_helper->PacketSent (m_nodes.Get (src)->GetId (), m_seq++);
+  m_helper->Finish ();
+  NS_TEST_EXPECT_MSG_EQ (m_helper->GetPotentialReceivers () - before, expected,
+                         "Potential receivers of node " << src << " at " << Simulator::Now ().As (Time::S));
+}
+
+void
+ReceptionRatioHelperTestCase::DoRun (void)
+{
+  m_nodes.Create (200);
+  Ptr<UniformRandomVariable> position = CreateObject<UniformRandomVariable> ();
+  position->SetAttribute ("Max", DoubleValue (3000.0));
+  position->SetStream (1);
+  Ptr<UniformRandomVariable> velocity = CreateObject<UniformRandomVariable> ();
+  velocity->SetAttribute ("Min", DoubleValue (-20.0));
+  velocity->SetAttribute ("Max", DoubleValue (20.0));
+  velocity->SetStream (2);
+  for (uint32_t i = 0; i < m_nodes.GetN (); i++)
+    {
+      Ptr<ConstantVelocityMobilityModel> mobility = CreateObject<ConstantVelocityMobilityModel> ();
+      mobility->SetPosition (Vector (position->GetValue (), position->GetValue (), 0.0));
+      mobility->SetVelocity (Vector (velocity->GetValue (), velocity->GetValue (), 0.0));
+      m_nodes.Get (i)->AggregateObject (mobility);
+    }
+
+  ReceptionRatioHelper helper (RANGE);
+  // Speeds are at most 20 * sqrt (2) m/s
+  helper.SetGridUpdateInterval (Seconds (10));
+  helper.SetMaxSpeed (30.0);
+  helper.Install (m_nodes);
+  m_helper = &helper;
+
+  for (uint32_t k = 0; k < 100; k++)
+    {
+      Simulator::Schedule (Seconds (0.37 * k), &ReceptionRatioHelperTestCase::Send, this, (k * 37) % m_nodes.GetN ());
+    }
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (helper.GetPackets (), 100, "Updates accounted");
+  NS_TEST_ASSERT_MSG_GT (helper.GetPotentialReceivers (), 0, "No potential receivers");
+
+  // Receptions: only those from the source, within the window, are counted
+  helper.ResetStats ();
+  helper.SetReceptionWindow (Seconds (1));
+  uint32_t src = m_nodes.Get (0)->GetId ();
+  helper.PacketSent (src, 1000, 0.25);
+  helper.PacketReceived (m_nodes.Get (1)->GetId (), src, 1000, 0);
+  helper.PacketReceived (m_nodes.Get (2)->GetId (), src, 1000, 0);
+  helper.PacketReceived (m_nodes.Get (3)->GetId (), src, 1000, 1);
+  helper.PacketReceived (m_nodes.Get (4)->GetId (), src, 999, 0);
+  NS_TEST_ASSERT_MSG_EQ (helper.GetPackets (), 0, "Update accounted before the end of its window");
+  helper.Finish ();
+  NS_TEST_ASSERT_MSG_EQ (helper.GetPackets (), 1, "Update not accounted by Finish");
+  NS_TEST_ASSERT_MSG_EQ (helper.GetReceivers (), 2, "Receivers of the update");
+  helper.PacketReceived (m_nodes.Get (5)->GetId (), src, 1000, 0);
+  NS_TEST_ASSERT_MSG_EQ (helper.GetReceivers (), 2, "Reception counted after the update was accounted");
+  if (helper.GetPotentialReceivers () > 0)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (helper.GetReceptionRatio (), 2.0 / helper.GetPotentialReceivers (), 1e-12, "Reception ratio");
+    }
+
+  m_helper = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Reception ratio helper test suite
+ */
+class ReceptionRatioHelperTestSuite : public TestSuite
+{
+public:
+  ReceptionRatioHelperTestSuite ();
+};
+
+ReceptionRatioHelperTestSuite::ReceptionRatioHelperTestSuite ()
+  : TestSuite ("reception-ratio-helper", UNIT)
+{
+  AddTestCase (new ReceptionRatioHelperTestCase, TestCase::QUICK);
+}
+
+static ReceptionRatioHelperTestSuite receptionRatioHelperTestSuite; //!< Static variable for test initialization
@@ -124,7 +124,7 @@ BuildingListPriv::Get (void)
 Ptr<BuildingListPriv> *
 BuildingListPriv::DoGet (void)
 {
-  static Ptr<BuildingListPriv> ptr = 0;
+  static thread_local Ptr<BuildingListPriv> ptr = 0;
   if (ptr == 0)
     {
       ptr = CreateObject<BuildingListPriv> ();
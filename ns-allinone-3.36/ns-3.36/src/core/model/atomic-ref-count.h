@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef ATOMIC_REF_COUNT_H
+#define ATOMIC_REF_COUNT_H
+
+#include "empty.h"
+#include "default-deleter.h"
+#include "assert.h"
+#include <stdint.h>
+#include <atomic>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup ptr
+ * ns3::AtomicRefCount declaration and template implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup ptr
+ * \brief A SimpleRefCount whose count may be changed by several threads
+ * at once.
+ *
+ * The attribute values, accessors and checkers registered in the TypeId
+ * database are shared by every object of a type, and every construction
+ * copies Ptr's to them: with a plain counter, objects created concurrently
+ * on several threads would corrupt the count and free them early. The
+ * atomic operations are slower than the plain increment, so this template
+ * is kept for these process-wide objects; everything owned by one thread
+ * keeps using SimpleRefCount.
+ *
+ * The template arguments are those of SimpleRefCount.
+ *
+ * \tparam T \explicit The typename of the subclass which derives
+ *      from this template class.
+ * \tparam PARENT \explicit The typename of the parent of this template.
+ * \tparam DELETER \explicit The typename of a class which implements
+ *      a public static method named 'Delete'.
+ */
+template <typename T, typename PARENT = empty, typename DELETER = DefaultDeleter<T> >
+class AtomicRefCount : public PARENT
+{
+public:
+  /** Default constructor.  */
+  AtomicRefCount ()
+    : m_count (1)
+  {}
+  /**
+   * Copy constructor
+   * \param [in] o The object to copy into this one.
+   */
+  AtomicRefCount (const AtomicRefCount & o [[maybe_unused]])
+    : m_count (1)
+  {
+  }
+  /**
+   * Assignment operator
+   * \param [in] o The object to copy
+   * \returns The copy of \pname{o}
+   */
+  AtomicRefCount &operator = ([[maybe_unused]] const AtomicRefCount &o)
+  {
+    return *this;
+  }
+  /**
+   * Increment the reference count. This method should not be called
+   * by user code: use the Ptr template.
+   */
+  inline void Ref (void) const
+  {
+    NS_ASSERT (m_count.load (std::memory_order_relaxed) < std::numeric_limits<uint32_t>::max ());
+    // The caller already holds a reference, so nothing needs ordering
+    m_count.fetch_add (1, std::memory_order_relaxed);
+  }
+  /**
+   * Decrement the reference count, and delete the object when it was the
+   * last reference. This method should not be called by user code: use
+   * the Ptr template.
+   */
+  inline void Unref (void) const
+  {
+    // Release our writes to the object, and acquire those of the other
+    // threads before the last one deletes it
+    if (m_count.fetch_sub (1, std::memory_order_acq_rel) == 1)
+      {
+        DELETER::Delete (static_cast<T*> (const_cast<AtomicRefCount *> (this)));
+      }
+  }
+
+  /**
+   * Get the reference count of the object.
+   * Normally not needed; for language bindings.
+   *
+   * \return The reference count.
+   */
+  inline uint32_t GetReferenceCount (void) const
+  {
+    return m_count.load (std::memory_order_relaxed);
+  }
+
+private:
+  /**
+   * The reference count.
+   *
+   * \internal
+   * Note we make this mutable so that the const methods can still
+   * change it.
+   */
+  mutable std::atomic<uint32_t> m_count;
+};
+
+} // namespace ns3
+
+#endif /* ATOMIC_REF_COUNT_H */
@@ -18,7 +18,6 @@
  * Authors: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "config.h"
-#include "singleton.h"
 #include "object.h"
 #include "global-value.h"
 #include "object-ptr-container.h"
@@ -613,10 +612,19 @@ Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &conta
 /**
  * \ingroup config-impl
  * Config system implementation class.
+ *
+ * The root namespace objects are those of the simulation of the calling
+ * thread, so there is one instance per thread.
  */
-class ConfigImpl : public Singleton<ConfigImpl>
+class ConfigImpl
 {
 public:
+  /**
+   * Get the instance of the calling thread.
+   * \returns The ConfigImpl of the calling thread.
+   */
+  static ConfigImpl * Get (void);
+
   // Keep Set and SetFailSafe since their errors are triggered
   // by the underlying ObjecBase functions.
   /** \copydoc ns3::Config::Set() */
@@ -803,6 +811,13 @@ ConfigImpl::UnregisterRootNamespaceObject (Ptr<Object> obj)
     }
 }
 
+ConfigImpl *
+ConfigImpl::Get (void)
+{
+  static thread_local ConfigImpl impl;
+  return &impl;
+}
+
 std::size_t
 ConfigImpl::GetRootNamespaceObjectN (void) const
 {
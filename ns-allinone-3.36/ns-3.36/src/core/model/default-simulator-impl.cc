@@ -273,6 +273,26 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
     }
 }
 
+void
+DefaultSimulatorImpl::RescheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+  NS_ASSERT_MSG (SystemThread::Equals (m_main), "Simulator::RescheduleWithContext Thread-unsafe invocation!");
+  NS_ASSERT_MSG (m_currentUid >= EventId::UID::VALID, "Simulator::RescheduleWithContext must be called from within an event");
+  NS_ASSERT_MSG (delay.IsPositive (), "DefaultSimulatorImpl::RescheduleWithContext(): Negative delay");
+
+  Time tAbsolute = delay + TimeStep (m_currentTs);
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = (uint64_t) tAbsolute.GetTimeStep ();
+  ev.key.m_context = context;
+  // Reuse the uid of the current event, which has already been removed
+  // from the scheduler, so that the order among simultaneous events is kept
+  ev.key.m_uid = m_currentUid;
+  m_unscheduledEvents++;
+  m_events->Insert (ev);
+}
+
 EventId
 DefaultSimulatorImpl::ScheduleNow (EventImpl *event)
 {
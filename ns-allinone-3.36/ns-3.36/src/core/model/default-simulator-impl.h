@@ -64,6 +64,7 @@ public:
   virtual void Stop (const Time &delay);
   virtual EventId Schedule (const Time &delay, EventImpl *event);
   virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual void RescheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
   virtual EventId ScheduleNow (EventImpl *event);
   virtual EventId ScheduleDestroy (EventImpl *event);
   virtual void Remove (const EventId &id);
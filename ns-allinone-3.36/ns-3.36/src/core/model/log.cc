@@ -41,15 +41,15 @@ namespace ns3 {
 
 /**
  * \ingroup logging
- * The Log TimePrinter.
+ * The Log TimePrinter, of the simulator of the calling thread.
  * This is private to the logging implementation.
  */
-static TimePrinter g_logTimePrinter = 0;
+static thread_local TimePrinter g_logTimePrinter = 0;
 /**
  * \ingroup logging
- * The Log NodePrinter.
+ * The Log NodePrinter, of the simulator of the calling thread.
  */
-static NodePrinter g_logNodePrinter = 0;
+static thread_local NodePrinter g_logNodePrinter = 0;
 
 /**
  * \ingroup logging
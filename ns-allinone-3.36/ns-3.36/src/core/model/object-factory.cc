@@ -98,8 +98,7 @@ Ptr<Object>
 ObjectFactory::Create (void) const
 {
   NS_LOG_FUNCTION (this);
-  Callback<ObjectBase *> cb = m_tid.GetConstructor ();
-  ObjectBase *base = cb ();
+  ObjectBase *base = m_tid.GetConstructor () ();
   Object *derived = dynamic_cast<Object *> (base);
   NS_ASSERT (derived != 0);
   derived->SetTypeId (m_tid);
@@ -24,6 +24,8 @@
 #include "config.h"
 #include "log.h"
 
+#include <thread>
+
 /**
  * \file
  * \ingroup randomvariable
@@ -39,7 +41,24 @@ NS_LOG_COMPONENT_DEFINE ("RngSeedManager");
  * The next random number generator stream number to use
  * for automatic assignment.
  */
-static uint64_t g_nextStreamIndex = 0;
+static thread_local uint64_t g_nextStreamIndex = 0;
+/**
+ * \relates RngSeedManager
+ * The thread which loaded the library, whose seed and run are the
+ * global values.
+ */
+static const std::thread::id g_mainThread = std::this_thread::get_id ();
+/**
+ * \relates RngSeedManager
+ * Seed and run set by a thread other than the main one.
+ */
+static thread_local struct
+{
+  bool seedSet = false;
+  uint32_t seed = 0;
+  bool runSet = false;
+  uint64_t run = 0;
+} g_threadRng;
 /**
  * \relates RngSeedManager
  * \anchor GlobalValueRngSeed
@@ -73,6 +92,10 @@ static ns3::GlobalValue g_rngRun ("RngRun",
 uint32_t RngSeedManager::GetSeed (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
+  if (g_threadRng.seedSet)
+    {
+      return g_threadRng.seed;
+    }
   UintegerValue seedValue;
   g_rngSeed.GetValue (seedValue);
   return static_cast<uint32_t> (seedValue.Get ());
@@ -81,18 +104,34 @@ void
 RngSeedManager::SetSeed (uint32_t seed)
 {
   NS_LOG_FUNCTION (seed);
+  if (std::this_thread::get_id () != g_mainThread)
+    {
+      g_threadRng.seedSet = true;
+      g_threadRng.seed = seed;
+      return;
+    }
   Config::SetGlobal ("RngSeed", UintegerValue (seed));
 }
 
 void RngSeedManager::SetRun (uint64_t run)
 {
   NS_LOG_FUNCTION (run);
+  if (std::this_thread::get_id () != g_mainThread)
+    {
+      g_threadRng.runSet = true;
+      g_threadRng.run = run;
+      return;
+    }
   Config::SetGlobal ("RngRun", UintegerValue (run));
 }
 
 uint64_t RngSeedManager::GetRun ()
 {
   NS_LOG_FUNCTION_NOARGS ();
+  if (g_threadRng.runSet)
+    {
+      return g_threadRng.run;
+    }
   UintegerValue value;
   g_rngRun.GetValue (value);
   uint64_t run = value.Get ();
@@ -107,4 +146,11 @@ uint64_t RngSeedManager::GetNextStreamIndex (void)
   return next;
 }
 
+void
+RngSeedManager::ResetNextStreamIndex (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  g_nextStreamIndex = 0;
+}
+
 } // namespace ns3
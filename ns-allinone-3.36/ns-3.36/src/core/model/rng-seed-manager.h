@@ -35,6 +35,11 @@ namespace ns3 {
  *
  * Manage the seed number and run number of the underlying
  * random number generator, and automatic assignment of stream numbers.
+ *
+ * The seed and run of the main thread are the RngSeed and RngRun global
+ * values. Any other thread running its own simulation gets its own seed
+ * and run once it calls SetSeed or SetRun, and reads the global values
+ * until then. Stream numbers are assigned per thread.
  */
 class RngSeedManager
 {
@@ -105,6 +110,13 @@ public:
    */
   static uint64_t GetNextStreamIndex (void);
 
+  /**
+   * Restart the automatic assignment of stream indices from zero, so that
+   * a simulation run after Simulator::Destroy in the same process draws
+   * the same random numbers as in a new process.
+   */
+  static void ResetNextStreamIndex (void);
+
 };
 
 /** Alias for compatibility. */
@@ -98,7 +98,7 @@ template <typename T>
 T **
 SimulationSingleton<T>::GetObject (void)
 {
-  static T *pobject = 0;
+  static thread_local T *pobject = 0;
   if (pobject == 0)
     {
       pobject = new T ();
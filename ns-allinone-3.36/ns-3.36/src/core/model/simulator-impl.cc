@@ -42,4 +42,11 @@ SimulatorImpl::GetTypeId (void)
   return tid;
 }
 
+void
+SimulatorImpl::RescheduleWithContext (uint32_t context, const Time &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay << event);
+  ScheduleWithContext (context, delay, event);
+}
+
 } // namespace ns3
@@ -67,6 +67,13 @@ public:
   virtual EventId Schedule (const Time &delay, EventImpl *event) = 0;
   /** \copydoc Simulator::ScheduleWithContext(uint32_t,const Time&,EventImpl*) */
   virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event) = 0;
+  /**
+   * \copydoc Simulator::RescheduleWithContext(uint32_t,const Time&,EventImpl*)
+   *
+   * The default implementation calls ScheduleWithContext, which does not
+   * preserve the position of the current event.
+   */
+  virtual void RescheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
   /** \copydoc Simulator::ScheduleNow(const Ptr<EventImpl>&) */
   virtual EventId ScheduleNow (EventImpl *event) = 0;
   /** \copydoc Simulator::ScheduleDestroy(const Ptr<EventImpl>&) */
@@ -80,12 +80,12 @@ static GlobalValue g_schedTypeImpl = GlobalValue ("SchedulerType",
 
 /**
  * \ingroup simulator
- * \brief Get the static SimulatorImpl instance.
+ * \brief Get the SimulatorImpl instance of the calling thread.
  * \return The SimulatorImpl instance pointer.
  */
 static SimulatorImpl ** PeekImpl (void)
 {
-  static SimulatorImpl *impl = 0;
+  static thread_local SimulatorImpl *impl = 0;
   return &impl;
 }
 
@@ -226,6 +226,15 @@ Simulator::ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *
 #endif
   return GetImpl ()->ScheduleWithContext (context, delay, impl);
 }
+
+void
+Simulator::RescheduleWithContext (uint32_t context, const Time &delay, EventImpl *impl)
+{
+#ifdef ENABLE_DES_METRICS
+  DesMetrics::Get ()->TraceWithContext (context, Now (), delay);
+#endif
+  return GetImpl ()->RescheduleWithContext (context, delay, impl);
+}
 EventId
 Simulator::ScheduleDestroy (const Ptr<EventImpl> &ev)
 {
@@ -61,6 +61,13 @@ class Scheduler;
  * first event inserted in the scheduling queue is scheduled to
  * expire first.
  *
+ * Every thread has its own simulator, as well as its own NodeList,
+ * ChannelList, Config root namespace and RngSeedManager seed, run and
+ * stream numbering, so independent simulations can run concurrently in
+ * one process. Attribute defaults, global values and TypeIds stay shared
+ * by all threads: set them before starting the threads. Objects must not
+ * be shared between threads, as their reference counts are not atomic.
+ *
  * A simple example of how to use the Simulator class to schedule events
  * is shown in sample-simulator.cc:
  * @include src/core/examples/sample-simulator.cc
@@ -292,6 +299,50 @@ public:
    */
   template <typename... Us, typename... Ts>
   static void ScheduleWithContext (uint32_t context, Time const &delay, void (*f)(Us...), Ts&&... args);
+
+  /**
+   * Schedule an event with the given context which takes over the
+   * position of the currently executing event among simultaneous events.
+   *
+   * The new event keeps the unique id of the event being executed, so it
+   * expires before any event that was scheduled after the current one
+   * for the same time. This lets an event re-arm itself to replay a
+   * sequence of events that would otherwise all have been scheduled at
+   * once, in the same order.
+   *
+   * This method must be called from within an event, at most once per
+   * event invocation, and only from the main simulation thread.
+   * Simulator implementations which do not support it fall back to
+   * ScheduleWithContext.
+   *
+   * @tparam FUNC @deduced Template type for the function to invoke.
+   * @tparam Ts @deduced Argument types.
+   * @param [in] context User-specified context parameter
+   * @param [in] delay The relative expiration time of the event.
+   * @param [in] f The function to invoke.
+   * @param [in] args Arguments to pass to MakeEvent.
+   */
+  template <typename FUNC,
+            typename std::enable_if<!std::is_convertible<FUNC, Ptr<EventImpl>>::value,int>::type = 0,
+            typename std::enable_if<!std::is_function<typename std::remove_pointer<FUNC>::type>::value,int>::type = 0,
+            typename... Ts>
+  static void RescheduleWithContext (uint32_t context, Time const &delay, FUNC f, Ts&&... args);
+
+  /**
+   * Schedule an event with the given context which takes over the
+   * position of the currently executing event among simultaneous events.
+   *
+   * \see RescheduleWithContext(uint32_t,Time const&,FUNC,Ts&&...)
+   *
+   * @tparam Us @deduced Formal function argument types.
+   * @tparam Ts @deduced Actual function argument types.
+   * @param [in] context User-specified context parameter
+   * @param [in] delay The relative expiration time of the event.
+   * @param [in] f The function to invoke.
+   * @param [in] args Arguments to pass to the invoked function.
+   */
+  template <typename... Us, typename... Ts>
+  static void RescheduleWithContext (uint32_t context, Time const &delay, void (*f)(Us...), Ts&&... args);
   /** @} */  // Schedule events (in a different context) to run now or at a future time.
 
   /**
@@ -467,6 +518,17 @@ public:
    */
   static void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
 
+  /**
+   * Schedule a future event execution (in a different context) which
+   * takes over the position of the currently executing event among
+   * simultaneous events.
+   *
+   * @param [in] delay Delay until the event expires.
+   * @param [in] context Event context.
+   * @param [in] event The event to schedule.
+   */
+  static void RescheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+
   /**
    * Schedule an event to run at the end of the simulation, after
    * the Stop() time or condition has been reached.
@@ -579,6 +641,21 @@ void Simulator::ScheduleWithContext (uint32_t context, Time const &delay, void (
   return ScheduleWithContext (context, delay, MakeEvent (f, std::forward<Ts> (args)...));
 }
 
+template <typename FUNC,
+          typename std::enable_if<!std::is_convertible<FUNC, Ptr<EventImpl>>::value,int>::type,
+          typename std::enable_if<!std::is_function<typename std::remove_pointer<FUNC>::type>::value,int>::type,
+          typename... Ts>
+void Simulator::RescheduleWithContext (uint32_t context, Time const &delay, FUNC f, Ts&&... args)
+{
+  return RescheduleWithContext (context, delay, MakeEvent (f, std::forward<Ts> (args)...));
+}
+
+template <typename... Us, typename... Ts>
+void Simulator::RescheduleWithContext (uint32_t context, Time const &delay, void (*f)(Us...), Ts&&... args)
+{
+  return RescheduleWithContext (context, delay, MakeEvent (f, std::forward<Ts> (args)...));
+}
+
 template <typename FUNC,
           typename std::enable_if<!std::is_convertible<FUNC, Ptr<EventImpl>>::value,int>::type,
           typename std::enable_if<!std::is_function<typename std::remove_pointer<FUNC>::type>::value,int>::type,
@@ -23,7 +23,7 @@
 #include <stdint.h>
 #include "callback.h"
 #include "ptr.h"
-#include "simple-ref-count.h"
+#include "atomic-ref-count.h"
 
 /**
  * \file
@@ -43,7 +43,7 @@ class ObjectBase;
  * This class abstracts the kind of trace source to which we want to connect
  * and provides services to Connect and Disconnect a sink to a trace source.
  */
-class TraceSourceAccessor : public SimpleRefCount<TraceSourceAccessor>
+class TraceSourceAccessor : public AtomicRefCount<TraceSourceAccessor>
 {
 public:
   /** Constructor. */
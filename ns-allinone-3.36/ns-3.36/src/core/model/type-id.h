@@ -52,6 +52,15 @@ class ObjectBase;
  *
  * \see attribute_TypeId
  *
+ * The TypeId database is shared by all the threads of the process and
+ * is not locked: objects may be created on several threads at once, but
+ * a TypeId is registered the first time its GetTypeId is called, which
+ * appends to the database. Most types are registered when the library is
+ * loaded, by NS_OBJECT_ENSURE_REGISTERED, but those whose GetTypeId only
+ * runs on first use, such as the instantiations of a templated class,
+ * must be registered by calling their GetTypeId before the worker threads
+ * start.
+ *
  * \internal
  *  See the discussion in IidManager about hash chaining of TypeId's.
  */
@@ -269,10 +278,14 @@ public:
   /**
    * Get the constructor callback.
    *
+   * The callback is returned by reference, so that objects created on
+   * several threads do not all change the reference count of the shared
+   * callback; the reference is valid until the next TypeId is registered.
+   *
    * \returns A callback which can be used to instantiate an object
    *          of this type.
    */
-  Callback<ObjectBase *> GetConstructor (void) const;
+  const Callback<ObjectBase *> &GetConstructor (void) const;
 
   /**
    * Check if this TypeId should not be listed in documentation.
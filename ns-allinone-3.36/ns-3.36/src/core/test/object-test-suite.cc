@@ -22,6 +22,9 @@
 #include "ns3/object.h"
 #include "ns3/object-factory.h"
 #include "ns3/assert.h"
+#include "ns3/uinteger.h"
+#include <thread>
+#include <vector>
 
 /**
  * \file
@@ -151,10 +154,49 @@ protected:
   }
 };
 
+/**
+ * \ingroup object-tests
+ * Class with an attribute, created on several threads.
+ */
+class AttributeA : public ns3::Object
+{
+public:
+  /**
+   * Register this type.
+   * \return The TypeId.
+   */
+  static ns3::TypeId GetTypeId (void)
+  {
+    static ns3::TypeId tid = ns3::TypeId ("ObjectTest:AttributeA")
+      .SetParent<Object> ()
+      .SetGroupName ("Core")
+      .HideFromDocumentation ()
+      .AddConstructor<AttributeA> ()
+      .AddAttribute ("Value", "A value.",
+                     ns3::UintegerValue (7),
+                     ns3::MakeUintegerAccessor (&AttributeA::m_value),
+                     ns3::MakeUintegerChecker<uint32_t> ());
+    return tid;
+  }
+  /** Constructor. */
+  AttributeA ()
+    : m_value (0)
+  {}
+  /** \returns The value of the attribute. */
+  uint32_t GetValue (void) const
+  {
+    return m_value;
+  }
+
+private:
+  uint32_t m_value;  //!< The attribute.
+};
+
 NS_OBJECT_ENSURE_REGISTERED (BaseA);
 NS_OBJECT_ENSURE_REGISTERED (DerivedA);
 NS_OBJECT_ENSURE_REGISTERED (BaseB);
 NS_OBJECT_ENSURE_REGISTERED (DerivedB);
+NS_OBJECT_ENSURE_REGISTERED (AttributeA);
 
 }  // unnamed namespace
 
@@ -475,6 +517,85 @@ ObjectFactoryTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_NE (a->GetObject<DerivedA> (), 0, "Unexpectedly able to work around C++ type system");
 }
 
+/**
+ * \ingroup object-tests
+ * Test that Objects can be created on several threads at once: the
+ * accessor, checker and initial value of an attribute are shared by all
+ * the objects of a type, so their reference counts must not be corrupted.
+ */
+class ThreadedCreateObjectTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ThreadedCreateObjectTestCase ();
+  /** Destructor. */
+  virtual ~ThreadedCreateObjectTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Create objects, with and without setting their attribute.
+   * \param [out] errors The number of objects with a wrong value.
+   */
+  static void CreateObjects (uint32_t *errors);
+};
+
+ThreadedCreateObjectTestCase::ThreadedCreateObjectTestCase ()
+  : TestCase ("Check that CreateObject can be called on several threads")
+{}
+
+ThreadedCreateObjectTestCase::~ThreadedCreateObjectTestCase ()
+{}
+
+void
+ThreadedCreateObjectTestCase::CreateObjects (uint32_t *errors)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (AttributeA::GetTypeId ());
+  for (uint32_t i = 0; i < 20000; i++)
+    {
+      if (CreateObject<AttributeA> ()->GetValue () != 7)
+        {
+          (*errors)++;
+        }
+      factory.Set ("Value", UintegerValue (i));
+      if (factory.Create<AttributeA> ()->GetValue () != i)
+        {
+          (*errors)++;
+        }
+    }
+}
+
+void
+ThreadedCreateObjectTestCase::DoRun (void)
+{
+  TypeId tid = AttributeA::GetTypeId ();
+  struct TypeId::AttributeInformation info;
+  NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName ("Value", &info), true, "Attribute not found");
+  uint32_t checkerCount = info.checker->GetReferenceCount ();
+  uint32_t accessorCount = info.accessor->GetReferenceCount ();
+  uint32_t valueCount = info.initialValue->GetReferenceCount ();
+
+  std::vector<uint32_t> errors (4, 0);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < errors.size (); i++)
+    {
+      threads.emplace_back (&ThreadedCreateObjectTestCase::CreateObjects, &errors[i]);
+    }
+  for (auto & thread : threads)
+    {
+      thread.join ();
+    }
+
+  for (uint32_t i = 0; i < errors.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (errors[i], 0, "Objects with a wrong value on thread " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (info.checker->GetReferenceCount (), checkerCount, "Reference count of the checker changed");
+  NS_TEST_EXPECT_MSG_EQ (info.accessor->GetReferenceCount (), accessorCount, "Reference count of the accessor changed");
+  NS_TEST_EXPECT_MSG_EQ (info.initialValue->GetReferenceCount (), valueCount, "Reference count of the initial value changed");
+}
+
 /**
  * \ingroup object-tests
  * The Test Suite that glues the Test Cases together.
@@ -492,6 +613,7 @@ ObjectTestSuite::ObjectTestSuite ()
   AddTestCase (new CreateObjectTestCase);
   AddTestCase (new AggregateObjectTestCase);
   AddTestCase (new ObjectFactoryTestCase);
+  AddTestCase (new ThreadedCreateObjectTestCase);
 }
 
 /**
@@ -24,6 +24,9 @@
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/rng-seed-manager.h"
+
+#include <thread>
 
 using namespace ns3;
 
@@ -213,6 +216,154 @@ SimulatorEventsTestCase::DoRun (void)
 }
 
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that an event rescheduled with RescheduleWithContext keeps
+ * the position of the original event among simultaneous events.
+ */
+class SimulatorRescheduleTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param schedulerFactory Scheduler factory.
+   */
+  SimulatorRescheduleTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  /**
+   * Test Event.
+   * \param value Event parameter.
+   * @{
+   */
+  void EventFirst (int value);
+  void EventSecond (int value);
+  void EventOther (int value);
+  /** @} */
+
+  std::vector<int> m_order;         //!< Values of the events, in execution order.
+  std::vector<uint32_t> m_contexts; //!< Contexts of the events, in execution order.
+  ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SimulatorRescheduleTestCase::SimulatorRescheduleTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that RescheduleWithContext keeps the event order with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{}
+
+void
+SimulatorRescheduleTestCase::EventFirst (int value)
+{
+  m_order.push_back (value);
+  m_contexts.push_back (Simulator::GetContext ());
+  Simulator::RescheduleWithContext (7, MicroSeconds (10), &SimulatorRescheduleTestCase::EventSecond, this, 2);
+}
+
+void
+SimulatorRescheduleTestCase::EventSecond (int value)
+{
+  NS_TEST_EXPECT_MSG_EQ (Now (), MicroSeconds (20), "Rescheduled event expired at the wrong time");
+  m_order.push_back (value);
+  m_contexts.push_back (Simulator::GetContext ());
+}
+
+void
+SimulatorRescheduleTestCase::EventOther (int value)
+{
+  m_order.push_back (value);
+  m_contexts.push_back (Simulator::GetContext ());
+}
+
+void
+SimulatorRescheduleTestCase::DoRun (void)
+{
+  Simulator::SetScheduler (m_schedulerFactory);
+
+  Simulator::ScheduleWithContext (1, MicroSeconds (10), &SimulatorRescheduleTestCase::EventFirst, this, 1);
+  // Scheduled after EventFirst, for the same time as the rescheduled event
+  Simulator::ScheduleWithContext (3, MicroSeconds (20), &SimulatorRescheduleTestCase::EventOther, this, 3);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_order.size (), 3, "Unexpected number of events");
+  NS_TEST_EXPECT_MSG_EQ (m_order[0], 1, "Unexpected event order");
+  NS_TEST_EXPECT_MSG_EQ (m_order[1], 2, "Rescheduled event did not keep the position of the original event");
+  NS_TEST_EXPECT_MSG_EQ (m_order[2], 3, "Unexpected event order");
+  NS_TEST_EXPECT_MSG_EQ (m_contexts[0], 1, "Unexpected context");
+  NS_TEST_EXPECT_MSG_EQ (m_contexts[1], 7, "Rescheduled event did not get its own context");
+  NS_TEST_EXPECT_MSG_EQ (m_contexts[2], 3, "Unexpected context");
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that a simulation run in another thread does not share
+ * the simulator nor the seed of the calling thread.
+ */
+class SimulatorThreadTestCase : public TestCase
+{
+public:
+  SimulatorThreadTestCase ();
+  virtual void DoRun (void);
+  /** Run a simulation up to 10 s in the calling thread. */
+  void RunWorker (void);
+  /** Count an event. */
+  void Event (void);
+
+  Time m_workerStart;      //!< Time of the worker simulator before its run.
+  Time m_workerEnd;        //!< Time of the worker simulator after its run.
+  uint32_t m_workerSeed;   //!< Seed read in the worker.
+  uint32_t m_events;       //!< Number of events run in the worker.
+};
+
+SimulatorThreadTestCase::SimulatorThreadTestCase ()
+  : TestCase ("Check that every thread has its own simulator"),
+    m_workerSeed (0),
+    m_events (0)
+{}
+
+void
+SimulatorThreadTestCase::Event (void)
+{
+  m_events++;
+}
+
+void
+SimulatorThreadTestCase::RunWorker (void)
+{
+  m_workerStart = Simulator::Now ();
+  RngSeedManager::SetSeed (7);
+  m_workerSeed = RngSeedManager::GetSeed ();
+  for (uint32_t i = 1; i <= 10; i++)
+    {
+      Simulator::Schedule (Seconds (i), &SimulatorThreadTestCase::Event, this);
+    }
+  Simulator::Run ();
+  m_workerEnd = Simulator::Now ();
+  Simulator::Destroy ();
+}
+
+void
+SimulatorThreadTestCase::DoRun (void)
+{
+  uint32_t seed = RngSeedManager::GetSeed ();
+  Simulator::Schedule (Seconds (1), &SimulatorThreadTestCase::Event, this);
+  Simulator::Stop (Seconds (2));
+  Simulator::Run ();
+
+  std::thread worker (&SimulatorThreadTestCase::RunWorker, this);
+  worker.join ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_workerStart, Seconds (0), "Worker started from the time of the main simulator");
+  NS_TEST_EXPECT_MSG_EQ (m_workerEnd, Seconds (10), "Worker did not run its own events");
+  NS_TEST_EXPECT_MSG_EQ (m_events, 11, "Unexpected number of events");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), Seconds (2), "Worker changed the time of the main simulator");
+  NS_TEST_EXPECT_MSG_EQ (m_workerSeed, 7, "Worker seed not set");
+  NS_TEST_EXPECT_MSG_EQ (RngSeedManager::GetSeed (), seed, "Worker changed the seed of the main thread");
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup simulator-tests
  *  
@@ -554,6 +705,19 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    factory.SetTypeId (ListScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRescheduleTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRescheduleTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRescheduleTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRescheduleTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
+    AddTestCase (new SimulatorRescheduleTestCase (factory), TestCase::QUICK);
+
+    AddTestCase (new SimulatorThreadTestCase, TestCase::QUICK);
   }
 };
 
@@ -0,0 +1,251 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/trajectory-recorder.h"
+#include "ns3/mobility-model.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TrajectoryRecorder");
+
+namespace {
+
+const char MAGIC[8] = {'N', 'S', '3', 'E', 'V', 'L', 'O', 'G'};
+const uint32_t VERSION = 1;
+/// Number of segments buffered before they are written
+const size_t BUFFER_SEGMENTS = 4096;
+
+} // unnamed namespace
+
+TrajectoryRecorder::TrajectoryRecorder ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TrajectoryRecorder::~TrajectoryRecorder ()
+{
+  Close ();
+  for (auto &installed : m_installed)
+    {
+      installed.model->TraceDisconnectWithoutContext ("CourseChange", installed.sink);
+    }
+}
+
+std::string
+TrajectoryRecorder::GetSchema (void)
+{
+  return "timestamp:f8,nodeId:u4,pos_x:f8,pos_y:f8,pos_z:f8,vel_x:f8,vel_y:f8,vel_z:f8";
+}
+
+void
+TrajectoryRecorder::Open (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Close ();
+  m_file.open (filename, std::ios::binary | std::ios::trunc);
+  NS_ABORT_MSG_UNLESS (m_file.is_open (), "Cannot write trajectory file " << filename);
+
+  std::string schema = GetSchema ();
+  uint32_t header[3] = {VERSION, sizeof (Segment), static_cast<uint32_t> (schema.size ())};
+  m_file.write (MAGIC, sizeof (MAGIC));
+  m_file.write (reinterpret_cast<const char *> (header), sizeof (header));
+  m_file.write (schema.data (), schema.size ());
+  m_buffer.reserve (BUFFER_SEGMENTS);
+
+  for (const auto &installed : m_installed)
+    {
+      Write (installed.nodeId, installed.model);
+    }
+}
+
+bool
+TrajectoryRecorder::IsOpen (void) const
+{
+  return m_file.is_open ();
+}
+
+void
+TrajectoryRecorder::Install (Ptr<Node> node)
+{
+  NS_LOG_FUNCTION (this << node);
+  Ptr<MobilityModel> model = node->GetObject<MobilityModel> ();
+  NS_ABORT_MSG_UNLESS (model, "Node " << node->GetId () << " has no MobilityModel");
+  Installed installed;
+  installed.nodeId = node->GetId ();
+  installed.model = model;
+  installed.sink = MakeBoundCallback (&TrajectoryRecorder::CourseChanged, this, node->GetId ());
+  model->TraceConnectWithoutContext ("CourseChange", installed.sink);
+  m_installed.push_back (installed);
+  Write (installed.nodeId, model);
+}
+
+void
+TrajectoryRecorder::Install (NodeContainer c)
+{
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      Install (*i);
+    }
+}
+
+void
+TrajectoryRecorder::CourseChanged (TrajectoryRecorder *recorder, uint32_t nodeId, Ptr<const MobilityModel> model)
+{
+  recorder->Write (nodeId, model);
+}
+
+void
+TrajectoryRecorder::Write (uint32_t nodeId, Ptr<const MobilityModel> model)
+{
+  if (!m_file.is_open ())
+    {
+      return;
+    }
+  Vector position = model->GetPosition ();
+  Vector velocity = model->GetVelocity ();
+  Segment segment;
+  segment.time = Simulator::Now ().GetSeconds ();
+  segment.nodeId = nodeId;
+  segment.x = position.x;
+  segment.y = position.y;
+  segment.z = position.z;
+  segment.vx = velocity.x;
+  segment.vy = velocity.y;
+  segment.vz = velocity.z;
+  m_buffer.push_back (segment);
+  if (m_buffer.size () >= BUFFER_SEGMENTS)
+    {
+      Flush ();
+    }
+}
+
+void
+TrajectoryRecorder::Flush (void)
+{
+  if (!m_file.is_open ())
+    {
+      return;
+    }
+  m_file.write (reinterpret_cast<const char *> (m_buffer.data ()), m_buffer.size () * sizeof (Segment));
+  m_file.flush ();
+  m_buffer.clear ();
+}
+
+void
+TrajectoryRecorder::Close (void)
+{
+  if (!m_file.is_open ())
+    {
+      return;
+    }
+  Flush ();
+  m_file.close ();
+}
+
+
+TrajectoryReader::TrajectoryReader ()
+{
+}
+
+TrajectoryReader::TrajectoryReader (std::string filename)
+{
+  Load (filename);
+}
+
+void
+TrajectoryReader::Load (std::string filename)
+{
+  std::ifstream file (filename, std::ios::binary);
+  NS_ABORT_MSG_UNLESS (file.is_open (), "Cannot read trajectory file " << filename);
+
+  char magic[sizeof (MAGIC)];
+  uint32_t header[3];
+  file.read (magic, sizeof (magic));
+  file.read (reinterpret_cast<char *> (header), sizeof (header));
+  NS_ABORT_MSG_UNLESS (file && std::equal (magic, magic + sizeof (magic), MAGIC),
+                       filename << " is not an event log");
+  NS_ABORT_MSG_UNLESS (header[0] == VERSION, "Unknown event log version " << header[0] << " in " << filename);
+  std::string schema (header[2], '\0');
+  file.read (&schema[0], header[2]);
+  NS_ABORT_MSG_UNLESS (schema == TrajectoryRecorder::GetSchema ()
+                       && header[1] == sizeof (TrajectoryRecorder::Segment),
+                       filename << " is not a trajectory file");
+
+  m_segments.clear ();
+  TrajectoryRecorder::Segment record;
+  while (file.read (reinterpret_cast<char *> (&record), sizeof (record)))
+    {
+      Segment segment;
+      segment.time = record.time;
+      segment.position = Vector (record.x, record.y, record.z);
+      segment.velocity = Vector (record.vx, record.vy, record.vz);
+      m_segments[record.nodeId].push_back (segment);
+    }
+
+  // Segments are written in time order, but keep the reader robust
+  for (auto &node : m_segments)
+    {
+      std::stable_sort (node.second.begin (), node.second.end (),
+                        [] (const Segment &a, const Segment &b) { return a.time < b.time; });
+    }
+}
+
+std::vector<uint32_t>
+TrajectoryReader::GetNodes (void) const
+{
+  std::vector<uint32_t> nodes;
+  for (const auto &node : m_segments)
+    {
+      nodes.push_back (node.first);
+    }
+  return nodes;
+}
+
+const TrajectoryReader::Segment &
+TrajectoryReader::Find (uint32_t nodeId, Time t) const
+{
+  auto node = m_segments.find (nodeId);
+  NS_ABORT_MSG_IF (node == m_segments.end (), "No trajectory for node " << nodeId);
+  const std::vector<Segment> &segments = node->second;
+  // Last segment starting at or before t; of several starting at the same
+  // time, the last one written is the current one
+  double seconds = t.GetSeconds ();
+  auto next = std::upper_bound (segments.begin (), segments.end (), seconds,
+                                [] (double time, const Segment &s) { return time < s.time; });
+  return next == segments.begin () ? segments.front () : *(next - 1);
+}
+
+Vector
+TrajectoryReader::GetPosition (uint32_t nodeId, Time t) const
+{
+  const Segment &segment = Find (nodeId, t);
+  double dt = std::max (0.0, t.GetSeconds () - segment.time);
+  return Vector (segment.position.x + segment.velocity.x * dt,
+                 segment.position.y + segment.velocity.y * dt,
+                 segment.position.z + segment.velocity.z * dt);
+}
+
+Vector
+TrajectoryReader::GetVelocity (uint32_t nodeId, Time t) const
+{
+  return Find (nodeId, t).velocity;
+}
+
+} // namespace ns3
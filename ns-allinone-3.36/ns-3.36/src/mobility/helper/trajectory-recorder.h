@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TRAJECTORY_RECORDER_H
+#define TRAJECTORY_RECORDER_H
+
+#include "ns3/callback.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+class MobilityModel;
+
+/**
+ * \ingroup mobility
+ *
+ * \brief Records the trajectories of nodes as linear segments.
+ *
+ * Instead of sampling the positions of the nodes periodically, the
+ * recorder listens to the CourseChange trace source of their mobility
+ * models and writes one segment (time, node id, position, velocity) each
+ * time a course changes. Between two segments of a node, its position is
+ * exactly position + velocity * (t - time) for the mobility models that
+ * move at a constant velocity between course changes (constant position,
+ * constant velocity, random walk, random direction, random waypoint,
+ * waypoint, ...). Models that accelerate between course changes (e.g.,
+ * ConstantAccelerationMobilityModel) are not linear and cannot be
+ * recorded this way.
+ *
+ * The file uses the binary event log format of the flooding scenarios, so
+ * that it can be read without parsing:
+ *
+ *   "NS3EVLOG"   magic, 8 bytes
+ *   uint32       format version (1)
+ *   uint32       record size, in bytes
+ *   uint32       schema size, then the schema, "name:type,..." with numpy
+ *                type codes
+ *   records      packed, little endian
+ *
+ * TrajectoryReader and analysis_scripts/trajectory.py give the position of
+ * a node at any time from such a file.
+ */
+class TrajectoryRecorder
+{
+public:
+  TrajectoryRecorder ();
+  ~TrajectoryRecorder ();
+
+  TrajectoryRecorder (const TrajectoryRecorder &) = delete;
+  TrajectoryRecorder & operator= (const TrajectoryRecorder &) = delete;
+
+  /**
+   * \param filename the file to write the segments to
+   *
+   * Closes the current file, if any. The current segment of every node
+   * already installed is written first, so that a file opened during the
+   * simulation holds the full trajectories from that time on.
+   */
+  void Open (std::string filename);
+
+  /**
+   * \returns true if a file is open
+   */
+  bool IsOpen (void) const;
+
+  /**
+   * \param node the node whose trajectory is recorded
+   *
+   * The node must have a MobilityModel. Its current segment is written
+   * immediately.
+   */
+  void Install (Ptr<Node> node);
+
+  /**
+   * \param c the nodes whose trajectories are recorded
+   */
+  void Install (NodeContainer c);
+
+  /**
+   * Write the buffered segments to the file.
+   */
+  void Flush (void);
+
+  /**
+   * Write the buffered segments and close the file. The nodes stay
+   * installed, and are recorded again in the next file opened.
+   */
+  void Close (void);
+
+  /**
+   * \returns the schema of the segment records
+   */
+  static std::string GetSchema (void);
+
+private:
+  friend class TrajectoryReader;
+
+  /**
+   * Segment of a trajectory, as written to the file
+   */
+#pragma pack(push, 1)
+  struct Segment
+  {
+    double time;      //!< start of the segment, in seconds
+    uint32_t nodeId;  //!< node id
+    double x;         //!< position at the start
+    double y;         //!< position at the start
+    double z;         //!< position at the start
+    double vx;        //!< velocity over the segment
+    double vy;        //!< velocity over the segment
+    double vz;        //!< velocity over the segment
+  };
+#pragma pack(pop)
+
+  /**
+   * CourseChange sink
+   * \param recorder the recorder
+   * \param nodeId the id of the node of the model
+   * \param model the mobility model whose course changed
+   */
+  static void CourseChanged (TrajectoryRecorder *recorder, uint32_t nodeId, Ptr<const MobilityModel> model);
+
+  /**
+   * Write the current segment of a model
+   * \param nodeId the id of the node of the model
+   * \param model the mobility model
+   */
+  void Write (uint32_t nodeId, Ptr<const MobilityModel> model);
+
+  /// Installed node
+  struct Installed
+  {
+    uint32_t nodeId;                                 //!< node id
+    Ptr<MobilityModel> model;                        //!< its mobility model
+    Callback<void, Ptr<const MobilityModel> > sink;  //!< connected sink
+  };
+
+  std::vector<Installed> m_installed;  //!< installed nodes
+  std::ofstream m_file;                //!< output file
+  std::vector<Segment> m_buffer;       //!< segments not written yet
+};
+
+/**
+ * \ingroup mobility
+ *
+ * \brief Gives the position of nodes at any time from a TrajectoryRecorder
+ * file.
+ */
+class TrajectoryReader
+{
+public:
+  TrajectoryReader ();
+
+  /**
+   * \param filename a file written by TrajectoryRecorder
+   *
+   * Aborts if the file cannot be read or is not a trajectory file.
+   */
+  explicit TrajectoryReader (std::string filename);
+
+  /**
+   * \param filename a file written by TrajectoryRecorder
+   *
+   * Replaces the trajectories loaded before.
+   */
+  void Load (std::string filename);
+
+  /**
+   * \returns the ids of the nodes of the file, in increasing order
+   */
+  std::vector<uint32_t> GetNodes (void) const;
+
+  /**
+   * \param nodeId the id of a node of the file
+   * \param t the time
+   * \returns the position of the node at time t
+   *
+   * Before the first segment of the node, its first position is returned.
+   */
+  Vector GetPosition (uint32_t nodeId, Time t) const;
+
+  /**
+   * \param nodeId the id of a node of the file
+   * \param t the time
+   * \returns the velocity of the node at time t
+   */
+  Vector GetVelocity (uint32_t nodeId, Time t) const;
+
+private:
+  /// Segment of a trajectory
+  struct Segment
+  {
+    double time;       //!< start of the segment, in seconds
+    Vector position;   //!< position at the start
+    Vector velocity;   //!< velocity over the segment
+  };
+
+  /**
+   * \param nodeId the id of a node of the file
+   * \param t the time
+   * \returns the segment of the node at time t
+   */
+  const Segment & Find (uint32_t nodeId, Time t) const;
+
+  /// Segments of every node, in time order
+  std::map<uint32_t, std::vector<Segment> > m_segments;
+};
+
+} // namespace ns3
+
+#endif /* TRAJECTORY_RECORDER_H */
@@ -0,0 +1,253 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "position-snapshot.h"
+#include "mobility-model.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/callback.h"
+#include "ns3/log.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PositionSnapshot");
+
+namespace {
+
+/**
+ * \ingroup mobility
+ * \brief Private state of the PositionSnapshot API.
+ */
+struct SnapshotState
+{
+  bool allValid = false;                       //!< Whether every node is known at allTime
+  bool destroyScheduled = false;               //!< Whether Clear is scheduled at Simulator::Destroy
+  Time allTime;                                //!< Time at which all the positions were last known
+  std::vector<double> x;                       //!< x coordinates, by node id
+  std::vector<double> y;                       //!< y coordinates, by node id
+  std::vector<double> z;                       //!< z coordinates, by node id
+  std::vector<int64_t> time;                   //!< Time step of the position of each node, -1 if none
+  std::vector<Ptr<MobilityModel> > mobility;   //!< Mobility models, by node id
+};
+
+/**
+ * \returns the state of the snapshot
+ */
+SnapshotState &
+GetState (void)
+{
+  static thread_local SnapshotState state;
+  return state;
+}
+
+/**
+ * Release the mobility models at the end of the simulation.
+ */
+void
+Clear (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  GetState () = SnapshotState ();
+}
+
+/**
+ * Keep the snapshot up to date when a position changes at the current time.
+ *
+ * \param nodeId the id of the node
+ * \param model the mobility model of the node
+ */
+void
+CourseChanged (uint32_t nodeId, Ptr<const MobilityModel> model)
+{
+  SnapshotState &state = GetState ();
+  if (nodeId < state.x.size ())
+    {
+      Vector position = model->GetPosition ();
+      state.x[nodeId] = position.x;
+      state.y[nodeId] = position.y;
+      state.z[nodeId] = position.z;
+      state.time[nodeId] = Simulator::Now ().GetTimeStep ();
+    }
+}
+
+/**
+ * Make room for the nodes of the NodeList.
+ *
+ * \returns the state of the snapshot
+ */
+SnapshotState &
+Resize (void)
+{
+  SnapshotState &state = GetState ();
+  uint32_t nNodes = NodeList::GetNNodes ();
+  if (state.x.size () == nNodes)
+    {
+      return state;
+    }
+  if (!state.destroyScheduled)
+    {
+      Simulator::ScheduleDestroy (&Clear);
+      state.destroyScheduled = true;
+    }
+  state.mobility.resize (nNodes);
+  state.x.resize (nNodes);
+  state.y.resize (nNodes);
+  state.z.resize (nNodes);
+  state.time.resize (nNodes, -1);
+  state.allValid = false;
+  return state;
+}
+
+/**
+ * Compute the position of a node, unless it was already computed at the
+ * current time.
+ *
+ * \param state the state of the snapshot
+ * \param i the id of the node
+ * \param now the current time step
+ */
+void
+UpdateNode (SnapshotState &state, uint32_t i, int64_t now)
+{
+  if (state.time[i] == now)
+    {
+      return;
+    }
+  Ptr<MobilityModel> mobility = state.mobility[i];
+  if (mobility == 0)
+    {
+      // The mobility model may be aggregated after the node is created
+      mobility = NodeList::GetNode (i)->GetObject<MobilityModel> ();
+      if (mobility == 0)
+        {
+          state.x[i] = state.y[i] = state.z[i] = 0;
+          state.time[i] = now;
+          return;
+        }
+      mobility->TraceConnectWithoutContext ("CourseChange", MakeBoundCallback (&CourseChanged, i));
+      state.mobility[i] = mobility;
+    }
+  Vector position = mobility->GetPosition ();
+  state.x[i] = position.x;
+  state.y[i] = position.y;
+  state.z[i] = position.z;
+  state.time[i] = now;
+}
+
+/**
+ * Compute the position of a node only, as needed at the current time.
+ *
+ * \param nodeId the id of the node
+ * \returns the state of the snapshot
+ */
+SnapshotState &
+Update (uint32_t nodeId)
+{
+  SnapshotState &state = Resize ();
+  NS_ASSERT_MSG (nodeId < state.x.size (), "Invalid node id " << nodeId);
+  UpdateNode (state, nodeId, Simulator::Now ().GetTimeStep ());
+  return state;
+}
+
+/**
+ * Compute the positions of all the nodes, unless they were already
+ * computed at the current time.
+ *
+ * \returns the state of the snapshot
+ */
+SnapshotState &
+Update (void)
+{
+  SnapshotState &state = Resize ();
+  if (state.allValid && state.allTime == Simulator::Now ())
+    {
+      return state;
+    }
+  NS_LOG_FUNCTION_NOARGS ();
+  int64_t now = Simulator::Now ().GetTimeStep ();
+  for (uint32_t i = 0; i < state.x.size (); i++)
+    {
+      UpdateNode (state, i, now);
+    }
+  state.allTime = Simulator::Now ();
+  state.allValid = true;
+  return state;
+}
+
+} // unnamed namespace
+
+Vector
+PositionSnapshot::GetPosition (uint32_t nodeId)
+{
+  const SnapshotState &state = Update (nodeId);
+  return Vector (state.x[nodeId], state.y[nodeId], state.z[nodeId]);
+}
+
+double
+PositionSnapshot::GetDistance (uint32_t a, uint32_t b)
+{
+  Update (a);
+  const SnapshotState &state = Update (b);
+  double dx = state.x[b] - state.x[a];
+  double dy = state.y[b] - state.y[a];
+  double dz = state.z[b] - state.z[a];
+  return std::sqrt (dx * dx + dy * dy + dz * dz);
+}
+
+bool
+PositionSnapshot::HasPosition (uint32_t nodeId)
+{
+  return GetMobility (nodeId) != 0;
+}
+
+Ptr<MobilityModel>
+PositionSnapshot::GetMobility (uint32_t nodeId)
+{
+  const SnapshotState &state = Update (nodeId);
+  return state.mobility[nodeId];
+}
+
+const std::vector<double> &
+PositionSnapshot::GetX (void)
+{
+  return Update ().x;
+}
+
+const std::vector<double> &
+PositionSnapshot::GetY (void)
+{
+  return Update ().y;
+}
+
+const std::vector<double> &
+PositionSnapshot::GetZ (void)
+{
+  return Update ().z;
+}
+
+void
+PositionSnapshot::Invalidate (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  SnapshotState &state = GetState ();
+  state.allValid = false;
+  std::fill (state.time.begin (), state.time.end (), -1);
+}
+
+} // namespace ns3
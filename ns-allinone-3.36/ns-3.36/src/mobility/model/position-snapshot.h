@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef POSITION_SNAPSHOT_H
+#define POSITION_SNAPSHOT_H
+
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+#include <vector>
+
+namespace ns3 {
+
+class MobilityModel;
+
+/**
+ * \ingroup mobility
+ *
+ * \brief The positions of all the nodes at the current simulation time.
+ *
+ * The positions are stored in contiguous arrays indexed by node id, each
+ * with the time at which it was computed. A query about one or two nodes
+ * only computes the positions of these nodes, if not yet done at the
+ * current time; GetX, GetY and GetZ compute those of all the nodes of the
+ * NodeList. The following queries made at the same time are served from
+ * the arrays, without looking up the MobilityModel aggregated to the node
+ * nor asking it for its position.
+ *
+ * The snapshot listens to the CourseChange trace source of the mobility
+ * models, so that a position set at the current time (e.g., with
+ * MobilityModel::SetPosition) is immediately visible.
+ *
+ * Nodes without a MobilityModel are reported at the origin; use
+ * HasPosition to tell them apart.
+ */
+class PositionSnapshot
+{
+public:
+  /**
+   * \param nodeId the id of the node
+   * \returns the position of the node at the current time
+   */
+  static Vector GetPosition (uint32_t nodeId);
+
+  /**
+   * \param a the id of the first node
+   * \param b the id of the second node
+   * \returns the distance between the two nodes at the current time
+   */
+  static double GetDistance (uint32_t a, uint32_t b);
+
+  /**
+   * \param nodeId the id of the node
+   * \returns true if a MobilityModel is aggregated to the node
+   */
+  static bool HasPosition (uint32_t nodeId);
+
+  /**
+   * \param nodeId the id of the node
+   * \returns the MobilityModel aggregated to the node, or 0 if there is none
+   */
+  static Ptr<MobilityModel> GetMobility (uint32_t nodeId);
+
+  /**
+   * \returns the x coordinates of all the nodes at the current time,
+   *          indexed by node id
+   *
+   * The reference is only valid until the simulation time advances.
+   */
+  static const std::vector<double> & GetX (void);
+  /**
+   * \returns the y coordinates of all the nodes at the current time,
+   *          indexed by node id
+   */
+  static const std::vector<double> & GetY (void);
+  /**
+   * \returns the z coordinates of all the nodes at the current time,
+   *          indexed by node id
+   */
+  static const std::vector<double> & GetZ (void);
+
+  /**
+   * Discard the current snapshot, so that the next query computes the
+   * positions again.
+   */
+  static void Invalidate (void);
+};
+
+} // namespace ns3
+
+#endif /* POSITION_SNAPSHOT_H */
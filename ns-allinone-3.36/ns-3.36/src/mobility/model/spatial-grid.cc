@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "spatial-grid.h"
+#include "ns3/assert.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+
+SpatialGrid::SpatialGrid ()
+  : m_cellSize (0.0),
+    m_nCellsX (0),
+    m_nCellsY (0)
+{
+}
+
+void
+SpatialGrid::Build (const std::vector<Vector> &positions, double minCellSize)
+{
+  NS_ASSERT (minCellSize > 0);
+  m_cellStart.clear ();
+  m_cellItems.clear ();
+  m_nCellsX = 0;
+  m_nCellsY = 0;
+  if (positions.empty ())
+    {
+      return;
+    }
+  Vector lower (std::numeric_limits<double>::max (), std::numeric_limits<double>::max (), 0);
+  Vector upper (std::numeric_limits<double>::lowest (), std::numeric_limits<double>::lowest (), 0);
+  for (const auto & position : positions)
+    {
+      lower.x = std::min (lower.x, position.x);
+      lower.y = std::min (lower.y, position.y);
+      upper.x = std::max (upper.x, position.x);
+      upper.y = std::max (upper.y, position.y);
+    }
+
+  uint64_t maxCells = std::max<uint64_t> (16, 4 * positions.size ());
+  m_cellSize = minCellSize;
+  m_origin = lower;
+  while (true)
+    {
+      m_nCellsX = static_cast<uint32_t> ((upper.x - lower.x) / m_cellSize) + 1;
+      m_nCellsY = static_cast<uint32_t> ((upper.y - lower.y) / m_cellSize) + 1;
+      if (static_cast<uint64_t> (m_nCellsX) * m_nCellsY <= maxCells)
+        {
+          break;
+        }
+      m_cellSize *= 2;
+    }
+
+  // Counting sort of the indices by cell
+  std::vector<uint32_t> cellOf (positions.size ());
+  m_cellStart.assign (m_nCellsX * m_nCellsY + 1, 0);
+  for (uint32_t i = 0; i < positions.size (); i++)
+    {
+      uint32_t cx = static_cast<uint32_t> ((positions[i].x - lower.x) / m_cellSize);
+      uint32_t cy = static_cast<uint32_t> ((positions[i].y - lower.y) / m_cellSize);
+      cellOf[i] = std::min (cy, m_nCellsY - 1) * m_nCellsX + std::min (cx, m_nCellsX - 1);
+      m_cellStart[cellOf[i] + 1]++;
+    }
+  for (uint32_t c = 1; c < m_cellStart.size (); c++)
+    {
+      m_cellStart[c] += m_cellStart[c - 1];
+    }
+  m_cellItems.resize (positions.size ());
+  std::vector<uint32_t> fill (m_cellStart.begin (), m_cellStart.end () - 1);
+  for (uint32_t i = 0; i < positions.size (); i++)
+    {
+      m_cellItems[fill[cellOf[i]]++] = i;
+    }
+}
+
+void
+SpatialGrid::GetCandidates (const Vector &position, double radius,
+                            std::vector<uint32_t> *candidates) const
+{
+  candidates->clear ();
+  if (m_cellItems.empty ())
+    {
+      return;
+    }
+  int64_t minX = static_cast<int64_t> (std::floor ((position.x - radius - m_origin.x) / m_cellSize));
+  int64_t maxX = static_cast<int64_t> (std::floor ((position.x + radius - m_origin.x) / m_cellSize));
+  int64_t minY = static_cast<int64_t> (std::floor ((position.y - radius - m_origin.y) / m_cellSize));
+  int64_t maxY = static_cast<int64_t> (std::floor ((position.y + radius - m_origin.y) / m_cellSize));
+  minX = std::max<int64_t> (minX, 0);
+  minY = std::max<int64_t> (minY, 0);
+  maxX = std::min<int64_t> (maxX, m_nCellsX - 1);
+  maxY = std::min<int64_t> (maxY, m_nCellsY - 1);
+
+  for (int64_t cy = minY; cy <= maxY; cy++)
+    {
+      for (int64_t cx = minX; cx <= maxX; cx++)
+        {
+          uint32_t cell = static_cast<uint32_t> (cy * m_nCellsX + cx);
+          candidates->insert (candidates->end (),
+                              m_cellItems.begin () + m_cellStart[cell],
+                              m_cellItems.begin () + m_cellStart[cell + 1]);
+        }
+    }
+}
+
+} // namespace ns3
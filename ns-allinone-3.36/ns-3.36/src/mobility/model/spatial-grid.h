@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "ns3/vector.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup mobility
+ *
+ * \brief Uniform grid of a set of positions in the xy plane, to find the
+ * positions near a point without visiting all of them.
+ *
+ * Build sorts the indices of the positions by cell, with a counting sort,
+ * in one contiguous array. The cells are squares at least as large as
+ * requested, doubled as long as there would be more cells than about four
+ * per position, so that sparse deployments over a large area do not
+ * allocate a huge grid.
+ *
+ * The grid does not track the positions: the caller rebuilds it when they
+ * have changed too much, and checks the candidates against their current
+ * positions.
+ */
+class SpatialGrid
+{
+public:
+  SpatialGrid ();
+
+  /**
+   * Rebuild the grid.
+   *
+   * \param positions the positions; the z coordinates are ignored
+   * \param minCellSize lower bound on the edge length of a cell (m),
+   *        which must be strictly positive
+   */
+  void Build (const std::vector<Vector> &positions, double minCellSize);
+
+  /**
+   * Find the indices of the positions in the cells which overlap the
+   * square of half-side radius centered on a point: all the positions
+   * within radius of the point, and possibly others.
+   *
+   * \param position the point; its z coordinate is ignored
+   * \param radius the distance (m) to cover
+   * \param candidates filled with the indices in the vector given to
+   *        Build, in no particular order
+   */
+  void GetCandidates (const Vector &position, double radius,
+                      std::vector<uint32_t> *candidates) const;
+
+private:
+  double m_cellSize;                    //!< Edge length of a cell (m)
+  Vector m_origin;                      //!< Lower left corner of the grid
+  uint32_t m_nCellsX;                   //!< Number of cells along the x axis
+  uint32_t m_nCellsY;                   //!< Number of cells along the y axis
+  std::vector<uint32_t> m_cellStart;    //!< Offset of the first index of each cell in m_cellItems
+  std::vector<uint32_t> m_cellItems;    //!< Indices of the positions, sorted by cell
+};
+
+} // namespace ns3
+
+#endif /* SPATIAL_GRID_H */
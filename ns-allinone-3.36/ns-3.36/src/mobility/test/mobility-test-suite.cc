@@ -31,6 +31,8 @@
 #include "ns3/mobility-model.h"
 #include "ns3/waypoint-mobility-model.h"
 #include "ns3/mobility-helper.h"
+#include "ns3/position-snapshot.h"
+#include "ns3/constant-velocity-mobility-model.h"
 
 using namespace ns3;
 
@@ -410,6 +412,86 @@ WaypointMobilityModelViaHelper::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief PositionSnapshot Test
+ */
+class PositionSnapshotTestCase : public TestCase
+{
+public:
+  PositionSnapshotTestCase ();
+  virtual ~PositionSnapshotTestCase ();
+
+private:
+  /**
+   * Check the snapshot against the mobility models, then move a node and
+   * check that the snapshot follows.
+   * \param c the nodes
+   */
+  void CheckPositions (NodeContainer c);
+  virtual void DoRun (void);
+};
+
+PositionSnapshotTestCase::PositionSnapshotTestCase ()
+  : TestCase ("Test the positions returned by PositionSnapshot")
+{
+}
+
+PositionSnapshotTestCase::~PositionSnapshotTestCase ()
+{
+}
+
+void
+PositionSnapshotTestCase::CheckPositions (NodeContainer c)
+{
+  // The last node has no mobility model
+  for (uint32_t i = 0; i + 1 < c.GetN (); i++)
+    {
+      Ptr<MobilityModel> mob = c.Get (i)->GetObject<MobilityModel> ();
+      Vector expected = mob->GetPosition ();
+      Vector position = PositionSnapshot::GetPosition (c.Get (i)->GetId ());
+      NS_TEST_EXPECT_MSG_EQ (PositionSnapshot::HasPosition (c.Get (i)->GetId ()), true, "Missing mobility");
+      NS_TEST_EXPECT_MSG_EQ_TOL (position.x, expected.x, 1e-9, "Position not equal");
+      NS_TEST_EXPECT_MSG_EQ_TOL (position.y, expected.y, 1e-9, "Position not equal");
+      NS_TEST_EXPECT_MSG_EQ_TOL (position.z, expected.z, 1e-9, "Position not equal");
+    }
+  double distance = CalculateDistance (c.Get (0)->GetObject<MobilityModel> ()->GetPosition (),
+                                       c.Get (1)->GetObject<MobilityModel> ()->GetPosition ());
+  NS_TEST_EXPECT_MSG_EQ_TOL (PositionSnapshot::GetDistance (c.Get (0)->GetId (), c.Get (1)->GetId ()),
+                             distance, 1e-9, "Distance not equal");
+  NS_TEST_EXPECT_MSG_EQ (PositionSnapshot::HasPosition (c.Get (2)->GetId ()), false, "Unexpected mobility");
+
+  // A position set at the current time is visible immediately
+  Ptr<MobilityModel> mob = c.Get (1)->GetObject<MobilityModel> ();
+  mob->SetPosition (Vector (-5, 7, 1));
+  NS_TEST_EXPECT_MSG_EQ_TOL (PositionSnapshot::GetX ()[c.Get (1)->GetId ()], -5, 1e-9, "Position not updated");
+  NS_TEST_EXPECT_MSG_EQ_TOL (PositionSnapshot::GetY ()[c.Get (1)->GetId ()], 7, 1e-9, "Position not updated");
+}
+
+void
+PositionSnapshotTestCase::DoRun (void)
+{
+  NodeContainer c;
+  c.Create (3);
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (100.0, 50.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (NodeContainer (c.Get (0), c.Get (1)));
+  c.Get (0)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (10, 0, 0));
+  c.Get (1)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (0, -3, 0));
+
+  NS_TEST_EXPECT_MSG_EQ (PositionSnapshot::HasPosition (c.Get (2)->GetId ()), false, "Unexpected mobility");
+  Simulator::Schedule (Seconds (1.5), &PositionSnapshotTestCase::CheckPositions, this, c);
+  Simulator::Schedule (Seconds (4), &PositionSnapshotTestCase::CheckPositions, this, c);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup mobility-test
  * \ingroup tests
@@ -429,6 +511,7 @@ MobilityTestSuite::MobilityTestSuite ()
   AddTestCase (new WaypointLazyNotifyTrue, TestCase::QUICK);
   AddTestCase (new WaypointInitialPositionIsWaypoint, TestCase::QUICK);
   AddTestCase (new WaypointMobilityModelViaHelper, TestCase::QUICK);
+  AddTestCase (new PositionSnapshotTestCase, TestCase::QUICK);
 }
 
 static MobilityTestSuite mobilityTestSuite; ///< the test suite
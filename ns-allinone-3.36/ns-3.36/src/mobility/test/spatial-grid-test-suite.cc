@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/spatial-grid.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Checks that the candidates given by SpatialGrid include all the
+ * positions within the radius, once each, for deployments which fit the
+ * requested cell size and for deployments which make the grid enlarge its
+ * cells.
+ */
+class SpatialGridTestCase : public TestCase
+{
+public:
+  SpatialGridTestCase ();
+  virtual ~SpatialGridTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Query the grid around points of the area, and around points outside
+   * of it, and compare with a search over all the positions
+   * \param positions the positions
+   * \param cellSize the minimum cell size
+   * \param name name of the deployment
+   */
+  void Check (const std::vector<Vector> &positions, double cellSize, std::string name);
+
+  Ptr<UniformRandomVariable> m_random;  //!< coordinates of the positions and points
+};
+
+SpatialGridTestCase::SpatialGridTestCase ()
+  : TestCase ("Check the candidates of the spatial grid against an exhaustive search")
+{
+}
+
+SpatialGridTestCase::~SpatialGridTestCase ()
+{
+}
+
+void
+SpatialGridTestCase::Check (const std::vector<Vector> &positions, double cellSize, std::string name)
+{
+  SpatialGrid grid;
+  grid.Build (positions, cellSize);
+  Vector lower (0, 0, 0);
+  Vector upper (0, 0, 0);
+  for (const auto & position : positions)
+    {
+      lower.x = std::min (lower.x, position.x);
+      lower.y = std::min (lower.y, position.y);
+      upper.x = std::max (upper.x, position.x);
+      upper.y = std::max (upper.y, position.y);
+    }
+  std::vector<uint32_t> candidates;
+  for (uint32_t k = 0; k < 50; k++)
+    {
+      // Up to a third of the extent outside of the area on every side
+      double width = upper.x - lower.x;
+      double height = upper.y - lower.y;
+      Vector point (m_random->GetValue (lower.x - width / 3, upper.x + width / 3),
+                    m_random->GetValue (lower.y - height / 3, upper.y + height / 3),
+                    m_random->GetValue (-10, 10));
+      double radius = m_random->GetValue (0, 2 * cellSize);
+      grid.GetCandidates (point, radius, &candidates);
+
+      std::vector<uint32_t> sorted (candidates);
+      std::sort (sorted.begin (), sorted.end ());
+      NS_TEST_EXPECT_MSG_EQ ((std::adjacent_find (sorted.begin (), sorted.end ()) == sorted.end ()), true,
+                             "Duplicate candidate for " << name);
+      for (uint32_t i = 0; i < positions.size (); i++)
+        {
+          if (std::hypot (positions[i].x - point.x, positions[i].y - point.y) <= radius)
+            {
+              NS_TEST_EXPECT_MSG_EQ (std::binary_search (sorted.begin (), sorted.end (), i), true,
+                                     "Position " << i << " within " << radius << " m of " << point
+                                     << " missed for " << name);
+            }
+        }
+    }
+}
+
+void
+SpatialGridTestCase::DoRun (void)
+{
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (1);
+
+  std::vector<Vector> dense;
+  for (uint32_t i = 0; i < 200; i++)
+    {
+      dense.push_back (Vector (m_random->GetValue (0, 1000), m_random->GetValue (0, 1000), 0));
+    }
+  Check (dense, 100, "a dense square");
+
+  // 10 nodes on 100 km: the cells are enlarged up to 40 of them
+  std::vector<Vector> sparse;
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      sparse.push_back (Vector (m_random->GetValue (-50000, 50000), m_random->GetValue (-50000, 50000), 0));
+    }
+  Check (sparse, 100, "a sparse square");
+
+  std::vector<Vector> line;
+  for (uint32_t i = 0; i < 50; i++)
+    {
+      line.push_back (Vector (i * 37.0, 12.0, i));
+    }
+  Check (line, 100, "a line");
+
+  // Several positions in the same place
+  std::vector<Vector> stacked (5, Vector (3, 4, 0));
+  stacked.push_back (Vector (300, 400, 0));
+  Check (stacked, 100, "stacked positions");
+
+  std::vector<uint32_t> candidates (3, 0);
+  SpatialGrid unbuilt;
+  unbuilt.GetCandidates (Vector (0, 0, 0), 100, &candidates);
+  NS_TEST_EXPECT_MSG_EQ (candidates.size (), 0, "Candidates of a grid never built");
+  SpatialGrid empty;
+  empty.Build (std::vector<Vector> (), 100);
+  candidates.assign (3, 0);
+  empty.GetCandidates (Vector (0, 0, 0), 100, &candidates);
+  NS_TEST_EXPECT_MSG_EQ (candidates.size (), 0, "Candidates of an empty grid");
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Spatial Grid Test Suite
+ */
+class SpatialGridTestSuite : public TestSuite
+{
+public:
+  SpatialGridTestSuite ();
+};
+
+SpatialGridTestSuite::SpatialGridTestSuite ()
+  : TestSuite ("spatial-grid", UNIT)
+{
+  AddTestCase (new SpatialGridTestCase, TestCase::QUICK);
+}
+
+static SpatialGridTestSuite spatialGridTestSuite; ///< the test suite
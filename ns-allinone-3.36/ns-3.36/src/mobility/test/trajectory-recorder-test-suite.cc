@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <string>
+#include <vector>
+
+#include "ns3/string.h"
+#include "ns3/simulator.h"
+#include "ns3/rectangle.h"
+#include "ns3/mobility-model.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/trajectory-recorder.h"
+#include "ns3/node-container.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Checks that the positions given by TrajectoryReader are those of
+ * the mobility models at any time, including for a file opened during the
+ * simulation.
+ */
+class TrajectoryRecorderTestCase : public TestCase
+{
+public:
+  /**
+   * \param model the mobility model type
+   * \param attribute a bounds attribute of the model
+   * \param value its value
+   */
+  TrajectoryRecorderTestCase (std::string model, std::string attribute, std::string value);
+  virtual ~TrajectoryRecorderTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /// Position of a node at a time
+  struct Sample
+  {
+    Time time;        //!< sampling time
+    uint32_t nodeId;  //!< node id
+    Vector position;  //!< position given by the mobility model
+  };
+
+  /**
+   * Sample the positions of the nodes
+   * \param nodes the nodes
+   */
+  void TakeSamples (NodeContainer nodes);
+
+  std::string m_model;      //!< mobility model type
+  std::string m_attribute;  //!< bounds attribute
+  std::string m_value;      //!< its value
+  std::vector<Sample> m_samples;  //!< samples taken
+};
+
+TrajectoryRecorderTestCase::TrajectoryRecorderTestCase (std::string model, std::string attribute, std::string value)
+  : TestCase ("Trajectory of " + model),
+    m_model (model),
+    m_attribute (attribute),
+    m_value (value)
+{
+}
+
+TrajectoryRecorderTestCase::~TrajectoryRecorderTestCase ()
+{
+}
+
+void
+TrajectoryRecorderTestCase::TakeSamples (NodeContainer nodes)
+{
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i)
+    {
+      Sample sample;
+      sample.time = Simulator::Now ();
+      sample.nodeId = (*i)->GetId ();
+      sample.position = (*i)->GetObject<MobilityModel> ()->GetPosition ();
+      m_samples.push_back (sample);
+    }
+  Simulator::Schedule (Seconds (0.37), &TrajectoryRecorderTestCase::TakeSamples, this, nodes);
+}
+
+void
+TrajectoryRecorderTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (5);
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::RandomRectanglePositionAllocator",
+                                 "X", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=100.0]"),
+                                 "Y", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=100.0]"));
+  mobility.SetMobilityModel (m_model,
+                             "Speed", StringValue ("ns3::UniformRandomVariable[Min=5.0|Max=20.0]"),
+                             m_attribute, StringValue (m_value));
+  mobility.Install (nodes);
+  mobility.AssignStreams (nodes, 0);
+
+  std::string fullFile = CreateTempDirFilename ("trajectory-full.evlog");
+  std::string lateFile = CreateTempDirFilename ("trajectory-late.evlog");
+  TrajectoryRecorder recorder;
+  TrajectoryRecorder lateRecorder;
+  recorder.Open (fullFile);
+  recorder.Install (nodes);
+  lateRecorder.Install (nodes);
+  Simulator::Schedule (Seconds (30.0), &TrajectoryRecorder::Open, &lateRecorder, lateFile);
+  Simulator::Schedule (Seconds (0.0), &TrajectoryRecorderTestCase::TakeSamples, this, nodes);
+  Simulator::Stop (Seconds (60.0));
+  Simulator::Run ();
+  recorder.Close ();
+  lateRecorder.Close ();
+  Simulator::Destroy ();
+
+  TrajectoryReader full (fullFile);
+  TrajectoryReader late (lateFile);
+  NS_TEST_ASSERT_MSG_EQ (full.GetNodes ().size (), nodes.GetN (), "Missing trajectories");
+  NS_TEST_ASSERT_MSG_GT (m_samples.size (), 100, "Too few samples");
+  for (const Sample &sample : m_samples)
+    {
+      Vector position = full.GetPosition (sample.nodeId, sample.time);
+      NS_TEST_EXPECT_MSG_LT (CalculateDistance (position, sample.position), 1e-6,
+                             "Node " << sample.nodeId << " at " << sample.time.As (Time::S));
+      if (sample.time >= Seconds (30.0))
+        {
+          position = late.GetPosition (sample.nodeId, sample.time);
+          NS_TEST_EXPECT_MSG_LT (CalculateDistance (position, sample.position), 1e-6,
+                                 "Node " << sample.nodeId << " at " << sample.time.As (Time::S) << " in the late file");
+        }
+    }
+}
+
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Trajectory Recorder Test Suite
+ */
+class TrajectoryRecorderTestSuite : public TestSuite
+{
+public:
+  TrajectoryRecorderTestSuite ();
+};
+
+TrajectoryRecorderTestSuite::TrajectoryRecorderTestSuite ()
+  : TestSuite ("trajectory-recorder", UNIT)
+{
+  AddTestCase (new TrajectoryRecorderTestCase ("ns3::RandomDirection2dMobilityModel", "Bounds",
+                                               "0|100|0|100"), TestCase::QUICK);
+  AddTestCase (new TrajectoryRecorderTestCase ("ns3::RandomWalk2dMobilityModel", "Bounds",
+                                               "0|100|0|100"), TestCase::QUICK);
+}
+
+static TrajectoryRecorderTestSuite trajectoryRecorderTestSuite; ///< the test suite
@@ -50,7 +50,7 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("Buffer");
 
 
-uint32_t Buffer::g_recommendedStart = 0;
+thread_local uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -75,9 +75,9 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED (x) && !IS_DESTROYED (x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList *Buffer::g_freeList = 0;
-struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+thread_local uint32_t Buffer::g_maxSize = 0;
+thread_local Buffer::FreeList *Buffer::g_freeList = 0;
+thread_local struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor(void)
 {
@@ -123,6 +123,8 @@ Buffer::Create (uint32_t dataSize)
   if (IS_UNINITIALIZED (g_freeList))
     {
       g_freeList = new Buffer::FreeList ();
+      // The destructor of a thread_local only runs if it was used in the thread
+      static_cast<void> (&g_localStaticDestructor);
     }
   else if (IS_INITIALIZED (g_freeList))
     {
@@ -767,7 +767,7 @@ private:
    * writing data. i.e., m_start should be initialized to this 
    * value.
    */
-  static uint32_t g_recommendedStart;
+  static thread_local uint32_t g_recommendedStart;
 
   /**
    * offset to the start of the virtual zero area from the start
@@ -798,9 +798,9 @@ private:
   {
     ~LocalStaticDestructor ();
   };
-  static uint32_t g_maxSize; //!< Max observed data size
-  static FreeList *g_freeList; //!< Buffer data container
-  static struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
+  static thread_local uint32_t g_maxSize; //!< Max observed data size
+  static thread_local FreeList *g_freeList; //!< Buffer data container
+  static thread_local struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
 #endif
 };
 
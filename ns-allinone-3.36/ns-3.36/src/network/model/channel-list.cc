@@ -128,7 +128,7 @@ Ptr<ChannelListPriv> *
 ChannelListPriv::DoGet (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  static Ptr<ChannelListPriv> ptr = 0;
+  static thread_local Ptr<ChannelListPriv> ptr = 0;
   if (ptr == 0)
     {
       ptr = CreateObject<ChannelListPriv> ();
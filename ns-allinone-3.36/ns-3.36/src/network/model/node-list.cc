@@ -130,7 +130,7 @@ Ptr<NodeListPriv> *
 NodeListPriv::DoGet (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  static Ptr<NodeListPriv> ptr = 0;
+  static thread_local Ptr<NodeListPriv> ptr = 0;
   if (ptr == 0)
     {
       ptr = CreateObject<NodeListPriv> ();
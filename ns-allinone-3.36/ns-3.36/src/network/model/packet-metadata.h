@@ -661,7 +661,7 @@ public:
    */
   static void Deallocate (struct PacketMetadata::Data *data);
 
-  static DataFreeList m_freeList; //!< the metadata data storage
+  static thread_local DataFreeList m_freeList; //!< the metadata data storage
   static bool m_enable; //!< Enable the packet metadata
   static bool m_enableChecking; //!< Enable the packet metadata checking
 
@@ -670,10 +670,10 @@ public:
    * m_enable is false; used to detect enabling of metadata in the
    * middle of a simulation, which isn't allowed.
    */
-  static bool m_metadataSkipped;
+  static thread_local bool m_metadataSkipped;
 
-  static uint32_t m_maxSize; //!< maximum metadata size
-  static uint16_t m_chunkUid; //!< Chunk Uid
+  static thread_local uint32_t m_maxSize; //!< maximum metadata size
+  static thread_local uint16_t m_chunkUid; //!< Chunk Uid
 
   struct Data *m_data; //!< Metadata storage
   /*
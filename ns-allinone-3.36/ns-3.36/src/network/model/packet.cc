@@ -28,7 +28,7 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Packet");
 
-uint32_t Packet::m_globalUid = 0;
+thread_local uint32_t Packet::m_globalUid = 0;
 
 TypeId 
 ByteTagIterator::Item::GetTypeId (void) const
@@ -400,7 +400,7 @@ Packet::PrintByteTags (std::ostream &os) const
     {
       ByteTagIterator::Item item = i.Next ();
       os << item.GetTypeId ().GetName () << " [" << item.GetStart () << "-" << item.GetEnd () << "]";
-      Callback<ObjectBase *> constructor = item.GetTypeId ().GetConstructor ();
+      const Callback<ObjectBase *> &constructor = item.GetTypeId ().GetConstructor ();
       if (constructor.IsNull ())
         {
           if (i.HasNext ())
@@ -462,7 +462,7 @@ Packet::Print (std::ostream &os) const
               os << item.tid.GetName () << " (";
               {
                 NS_ASSERT (item.tid.HasConstructor ());
-                Callback<ObjectBase *> constructor = item.tid.GetConstructor ();
+                const Callback<ObjectBase *> &constructor = item.tid.GetConstructor ();
                 NS_ASSERT (!constructor.IsNull ());
                 ObjectBase *instance = constructor ();
                 NS_ASSERT (instance != 0);
@@ -530,7 +530,7 @@ Packet::Print (std::ostream &os) const
               os << item.tid.GetName () << "(";
               {
                 NS_ASSERT (item.tid.HasConstructor ());
-                Callback<ObjectBase *> constructor = item.tid.GetConstructor ();
+                const Callback<ObjectBase *> &constructor = item.tid.GetConstructor ();
                 NS_ASSERT (constructor.IsNull ());
                 ObjectBase *instance = constructor ();
                 NS_ASSERT (instance != 0);
@@ -995,7 +995,7 @@ Packet::PrintPacketTags (std::ostream &os) const
     {
       PacketTagIterator::Item item = i.Next ();
       NS_ASSERT (item.GetTypeId ().HasConstructor ());
-      Callback<ObjectBase *> constructor = item.GetTypeId ().GetConstructor ();
+      const Callback<ObjectBase *> &constructor = item.GetTypeId ().GetConstructor ();
       NS_ASSERT (!constructor.IsNull ());
       ObjectBase *instance = constructor ();
       Tag *tag = dynamic_cast<Tag *> (instance);
@@ -791,7 +791,7 @@ private:
   /* Please see comments above about nix-vector */
   mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-  static uint32_t m_globalUid; //!< Global counter of packets Uid
+  static thread_local uint32_t m_globalUid; //!< Counter of packets Uid, of the calling thread
 };
 
 /**
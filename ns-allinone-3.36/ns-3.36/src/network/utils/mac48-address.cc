@@ -135,7 +135,7 @@ Mac48Address
 Mac48Address::Allocate (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  static uint64_t id = 0;
+  static thread_local uint64_t id = 0;
   id++;
   Mac48Address address;
   address.m_address[0] = (id >> 40) & 0xff;
@@ -91,7 +91,7 @@ Mac8Address::GetBroadcast ()
 Mac8Address
 Mac8Address::Allocate ()
 {
-  static uint8_t nextAllocated = 0;
+  static thread_local uint8_t nextAllocated = 0;
 
   uint8_t address = nextAllocated++;
   if (nextAllocated == 255)
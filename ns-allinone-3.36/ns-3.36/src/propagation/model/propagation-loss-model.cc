@@ -24,6 +24,7 @@
 #include "propagation-loss-model.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
+#include "ns3/constant-position-mobility-model.h"
 #include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/string.h"
@@ -36,6 +37,30 @@ NS_LOG_COMPONENT_DEFINE ("PropagationLossModel");
 
 // ------------------------------------------------------------------------- //
 
+void
+PositionBatch::Clear (void)
+{
+  x.clear ();
+  y.clear ();
+  z.clear ();
+}
+
+void
+PositionBatch::Add (const Vector &position)
+{
+  x.push_back (position.x);
+  y.push_back (position.y);
+  z.push_back (position.z);
+}
+
+std::size_t
+PositionBatch::GetSize (void) const
+{
+  return x.size ();
+}
+
+// ------------------------------------------------------------------------- //
+
 NS_OBJECT_ENSURE_REGISTERED (PropagationLossModel);
 
 TypeId 
@@ -82,6 +107,54 @@ PropagationLossModel::CalcRxPower (double txPowerDbm,
   return self;
 }
 
+void
+PropagationLossModel::CalcRxPowerBatch (double txPowerDbm,
+                                        const Vector &a,
+                                        const PositionBatch &b,
+                                        double *rxPowerDbm) const
+{
+  NS_LOG_FUNCTION (this << txPowerDbm << a << b.GetSize ());
+  std::fill (rxPowerDbm, rxPowerDbm + b.GetSize (), txPowerDbm);
+  for (const PropagationLossModel *model = this; model != 0; model = PeekPointer (model->m_next))
+    {
+      model->DoCalcRxPowerBatch (a, b, rxPowerDbm);
+    }
+}
+
+bool
+PropagationLossModel::SupportsBatch (void) const
+{
+  for (const PropagationLossModel *model = this; model != 0; model = PeekPointer (model->m_next))
+    {
+      if (!model->DoSupportsBatch ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+PropagationLossModel::DoCalcRxPowerBatch (const Vector &a,
+                                          const PositionBatch &b,
+                                          double *rxPowerDbm) const
+{
+  Ptr<MobilityModel> ma = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<MobilityModel> mb = CreateObject<ConstantPositionMobilityModel> ();
+  ma->SetPosition (a);
+  for (std::size_t i = 0; i < b.GetSize (); i++)
+    {
+      mb->SetPosition (Vector (b.x[i], b.y[i], b.z[i]));
+      rxPowerDbm[i] = DoCalcRxPower (rxPowerDbm[i], ma, mb);
+    }
+}
+
+bool
+PropagationLossModel::DoSupportsBatch (void) const
+{
+  return false;
+}
+
 int64_t
 PropagationLossModel::AssignStreams (int64_t stream)
 {
@@ -271,6 +344,36 @@ FriisPropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm - std::max (lossDb, m_minLoss);
 }
 
+void
+FriisPropagationLossModel::DoCalcRxPowerBatch (const Vector &a,
+                                               const PositionBatch &b,
+                                               double *rxPowerDbm) const
+{
+  // Same computation as DoCalcRxPower, without branches so that the loop
+  // can be vectorized. A null distance gives an infinite denominator, hence
+  // a loss of -inf which is clamped to m_minLoss as in DoCalcRxPower.
+  const double *x = b.x.data ();
+  const double *y = b.y.data ();
+  const double *z = b.z.data ();
+  double numerator = m_lambda * m_lambda;
+  for (std::size_t i = 0; i < b.GetSize (); i++)
+    {
+      double dx = x[i] - a.x;
+      double dy = y[i] - a.y;
+      double dz = z[i] - a.z;
+      double distance = std::sqrt (dx * dx + dy * dy + dz * dz);
+      double denominator = 16 * M_PI * M_PI * distance * distance * m_systemLoss;
+      double lossDb = -10 * std::log10 (numerator / denominator);
+      rxPowerDbm[i] -= std::max (lossDb, m_minLoss);
+    }
+}
+
+bool
+FriisPropagationLossModel::DoSupportsBatch (void) const
+{
+  return true;
+}
+
 int64_t
 FriisPropagationLossModel::DoAssignStreams (int64_t stream)
 {
@@ -445,6 +548,41 @@ TwoRayGroundPropagationLossModel::DoCalcRxPower (double txPowerDbm,
     }
 }
 
+void
+TwoRayGroundPropagationLossModel::DoCalcRxPowerBatch (const Vector &a,
+                                                      const PositionBatch &b,
+                                                      double *rxPowerDbm) const
+{
+  const double *x = b.x.data ();
+  const double *y = b.y.data ();
+  const double *z = b.z.data ();
+  double txAntHeight = a.z + m_heightAboveZ;
+  for (std::size_t i = 0; i < b.GetSize (); i++)
+    {
+      double dx = x[i] - a.x;
+      double dy = y[i] - a.y;
+      double dz = z[i] - a.z;
+      double distance = std::sqrt (dx * dx + dy * dy + dz * dz);
+      double rxAntHeight = z[i] + m_heightAboveZ;
+      double dCross = (4 * M_PI * txAntHeight * rxAntHeight) / m_lambda;
+      // Evaluate both branches of DoCalcRxPower and select the result
+      double tmp = M_PI * distance;
+      double friisPr = 10 * std::log10 ((m_lambda * m_lambda) / (16 * tmp * tmp * m_systemLoss));
+      tmp = txAntHeight * rxAntHeight;
+      double rayNumerator = tmp * tmp;
+      tmp = distance * distance;
+      double rayPr = 10 * std::log10 (rayNumerator / (tmp * tmp * m_systemLoss));
+      double pr = distance <= dCross ? friisPr : rayPr;
+      rxPowerDbm[i] += distance <= m_minDistance ? 0.0 : pr;
+    }
+}
+
+bool
+TwoRayGroundPropagationLossModel::DoSupportsBatch (void) const
+{
+  return true;
+}
+
 int64_t
 TwoRayGroundPropagationLossModel::DoAssignStreams (int64_t stream)
 {
@@ -534,6 +672,32 @@ LogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm + rxc;
 }
 
+void
+LogDistancePropagationLossModel::DoCalcRxPowerBatch (const Vector &a,
+                                                     const PositionBatch &b,
+                                                     double *rxPowerDbm) const
+{
+  const double *x = b.x.data ();
+  const double *y = b.y.data ();
+  const double *z = b.z.data ();
+  for (std::size_t i = 0; i < b.GetSize (); i++)
+    {
+      double dx = x[i] - a.x;
+      double dy = y[i] - a.y;
+      double dz = z[i] - a.z;
+      double distance = std::sqrt (dx * dx + dy * dy + dz * dz);
+      double pathLossDb = 10 * m_exponent * std::log10 (distance / m_referenceDistance);
+      double rxc = -m_referenceLoss - pathLossDb;
+      rxPowerDbm[i] += distance <= m_referenceDistance ? -m_referenceLoss : rxc;
+    }
+}
+
+bool
+LogDistancePropagationLossModel::DoSupportsBatch (void) const
+{
+  return true;
+}
+
 int64_t
 LogDistancePropagationLossModel::DoAssignStreams (int64_t stream)
 {
@@ -924,6 +1088,30 @@ RangePropagationLossModel::DoCalcRxPower (double txPowerDbm,
     }
 }
 
+void
+RangePropagationLossModel::DoCalcRxPowerBatch (const Vector &a,
+                                               const PositionBatch &b,
+                                               double *rxPowerDbm) const
+{
+  const double *x = b.x.data ();
+  const double *y = b.y.data ();
+  const double *z = b.z.data ();
+  for (std::size_t i = 0; i < b.GetSize (); i++)
+    {
+      double dx = x[i] - a.x;
+      double dy = y[i] - a.y;
+      double dz = z[i] - a.z;
+      double distance = std::sqrt (dx * dx + dy * dy + dz * dz);
+      rxPowerDbm[i] = distance <= m_range ? rxPowerDbm[i] : -1000;
+    }
+}
+
+bool
+RangePropagationLossModel::DoSupportsBatch (void) const
+{
+  return true;
+}
+
 int64_t
 RangePropagationLossModel::DoAssignStreams (int64_t stream)
 {
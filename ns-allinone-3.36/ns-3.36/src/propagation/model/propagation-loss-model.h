@@ -27,7 +27,9 @@
 
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/vector.h"
 #include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -43,6 +45,35 @@ namespace ns3 {
 
 class MobilityModel;
 
+/**
+ * \ingroup propagation
+ *
+ * \brief The positions of a set of nodes, stored as a structure of arrays
+ *
+ * Used to compute the propagation loss from one transmitter to many
+ * receivers at once, see PropagationLossModel::CalcRxPowerBatch.
+ */
+struct PositionBatch
+{
+  /**
+   * Remove all the positions.
+   */
+  void Clear (void);
+  /**
+   * Append a position.
+   * \param position the position to append
+   */
+  void Add (const Vector &position);
+  /**
+   * \returns the number of positions
+   */
+  std::size_t GetSize (void) const;
+
+  std::vector<double> x; //!< x coordinates (m)
+  std::vector<double> y; //!< y coordinates (m)
+  std::vector<double> z; //!< z coordinates (m)
+};
+
 /**
  * \ingroup propagation
  *
@@ -102,6 +133,33 @@ public:
                       Ptr<MobilityModel> a,
                       Ptr<MobilityModel> b) const;
 
+  /**
+   * Returns the Rx Power from one source to a batch of destinations, taking
+   * into account all the PropagationLossModel(s) chained to the current one.
+   *
+   * Models which do not implement a batched computation are evaluated
+   * one destination at a time, through temporary constant position mobility
+   * models; this is only correct for models whose loss depends on the
+   * positions of the nodes alone.
+   *
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param a the position of the source
+   * \param b the positions of the destinations
+   * \param rxPowerDbm array of b.GetSize () elements which receives the
+   *        reception powers after adding/multiplying propagation loss (in dBm)
+   */
+  void CalcRxPowerBatch (double txPowerDbm,
+                         const Vector &a,
+                         const PositionBatch &b,
+                         double *rxPowerDbm) const;
+
+  /**
+   * \returns true if the current model and all the models chained to it
+   *          implement a batched computation of the Rx power, in which case
+   *          CalcRxPowerBatch gives the same results as CalcRxPower
+   */
+  bool SupportsBatch (void) const;
+
   /**
    * If this loss model uses objects of type RandomVariableStream,
    * set the stream numbers to the integers starting with the offset
@@ -140,6 +198,24 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const = 0;
 
+  /**
+   * Batched version of DoCalcRxPower. The default implementation calls
+   * DoCalcRxPower for each destination.
+   *
+   * \param a the position of the source
+   * \param b the positions of the destinations
+   * \param rxPowerDbm array of b.GetSize () elements which holds the
+   *        transmission powers on entry and the reception powers on exit (in dBm)
+   */
+  virtual void DoCalcRxPowerBatch (const Vector &a,
+                                   const PositionBatch &b,
+                                   double *rxPowerDbm) const;
+
+  /**
+   * \returns true if DoCalcRxPowerBatch is overridden by this model
+   */
+  virtual bool DoSupportsBatch (void) const;
+
   Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
 };
 
@@ -304,6 +380,10 @@ private:
   double DoCalcRxPower (double txPowerDbm,
                         Ptr<MobilityModel> a,
                         Ptr<MobilityModel> b) const override;
+  void DoCalcRxPowerBatch (const Vector &a,
+                           const PositionBatch &b,
+                           double *rxPowerDbm) const override;
+  bool DoSupportsBatch (void) const override;
   int64_t DoAssignStreams (int64_t stream) override;
 
   /**
@@ -414,6 +494,10 @@ private:
   double DoCalcRxPower (double txPowerDbm,
                         Ptr<MobilityModel> a,
                         Ptr<MobilityModel> b) const override;
+  void DoCalcRxPowerBatch (const Vector &a,
+                           const PositionBatch &b,
+                           double *rxPowerDbm) const override;
+  bool DoSupportsBatch (void) const override;
   int64_t DoAssignStreams (int64_t stream) override;
 
   /**
@@ -492,6 +576,10 @@ private:
   double DoCalcRxPower (double txPowerDbm,
                         Ptr<MobilityModel> a,
                         Ptr<MobilityModel> b) const override;
+  void DoCalcRxPowerBatch (const Vector &a,
+                           const PositionBatch &b,
+                           double *rxPowerDbm) const override;
+  bool DoSupportsBatch (void) const override;
 
   int64_t DoAssignStreams (int64_t stream) override;
 
@@ -771,6 +859,10 @@ private:
   double DoCalcRxPower (double txPowerDbm,
                         Ptr<MobilityModel> a,
                         Ptr<MobilityModel> b) const override;
+  void DoCalcRxPowerBatch (const Vector &a,
+                           const PositionBatch &b,
+                           double *rxPowerDbm) const override;
+  bool DoSupportsBatch (void) const override;
 
   int64_t DoAssignStreams (int64_t stream) override;
 
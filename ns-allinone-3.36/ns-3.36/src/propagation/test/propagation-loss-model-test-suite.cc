@@ -473,6 +473,89 @@ RangePropagationLossModelTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Check that CalcRxPowerBatch gives the same results as CalcRxPower
+ */
+class BatchPropagationLossModelTestCase : public TestCase
+{
+public:
+  BatchPropagationLossModelTestCase ();
+  virtual ~BatchPropagationLossModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Compare the batched and the scalar RX powers for the given model.
+   * \param lossModel the loss model (possibly a chain) to check
+   * \param supportsBatch the expected result of SupportsBatch
+   */
+  void CheckModel (Ptr<PropagationLossModel> lossModel, bool supportsBatch);
+};
+
+BatchPropagationLossModelTestCase::BatchPropagationLossModelTestCase ()
+  : TestCase ("Check that the batched propagation loss computation matches the scalar one")
+{
+}
+
+BatchPropagationLossModelTestCase::~BatchPropagationLossModelTestCase ()
+{
+}
+
+void
+BatchPropagationLossModelTestCase::CheckModel (Ptr<PropagationLossModel> lossModel, bool supportsBatch)
+{
+  NS_TEST_EXPECT_MSG_EQ (lossModel->SupportsBatch (), supportsBatch, "Unexpected batch support");
+
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (10, 20, 1.5));
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+
+  // Include a null distance and distances around the crossover and range thresholds
+  PositionBatch positions;
+  positions.Add (Vector (10, 20, 1.5));
+  positions.Add (Vector (10.5, 20, 1.5));
+  positions.Add (Vector (11, 21, 3));
+  for (double distance = 5; distance < 1500; distance *= 1.37)
+    {
+      positions.Add (Vector (10 + distance, 20 - distance / 3, 1.5));
+    }
+
+  double txPowerDbm = 16.0206;
+  std::vector<double> rxPowerDbm (positions.GetSize ());
+  lossModel->CalcRxPowerBatch (txPowerDbm, a->GetPosition (), positions, rxPowerDbm.data ());
+  for (std::size_t i = 0; i < positions.GetSize (); i++)
+    {
+      b->SetPosition (Vector (positions.x[i], positions.y[i], positions.z[i]));
+      double expected = lossModel->CalcRxPower (txPowerDbm, a, b);
+      NS_TEST_EXPECT_MSG_EQ_TOL (rxPowerDbm[i], expected, 1e-9, "Got unexpected rcv power at index " << i);
+    }
+}
+
+void
+BatchPropagationLossModelTestCase::DoRun (void)
+{
+  CheckModel (CreateObject<FriisPropagationLossModel> (), true);
+  CheckModel (CreateObject<TwoRayGroundPropagationLossModel> (), true);
+  CheckModel (CreateObject<LogDistancePropagationLossModel> (), true);
+  Ptr<RangePropagationLossModel> range = CreateObject<RangePropagationLossModel> ();
+  range->SetAttribute ("MaxRange", DoubleValue (300));
+  CheckModel (range, true);
+
+  // A chain of batched models
+  Ptr<LogDistancePropagationLossModel> logDistance = CreateObject<LogDistancePropagationLossModel> ();
+  logDistance->SetNext (range);
+  CheckModel (logDistance, true);
+
+  // A chain including a model evaluated by the scalar fallback
+  Ptr<FriisPropagationLossModel> friis = CreateObject<FriisPropagationLossModel> ();
+  friis->SetNext (CreateObject<ThreeLogDistancePropagationLossModel> ());
+  CheckModel (friis, false);
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup propagation-tests
  *
@@ -499,6 +582,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite ()
   AddTestCase (new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new MatrixPropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new RangePropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new BatchPropagationLossModelTestCase, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
@@ -20,6 +20,7 @@
  */
 
 #include <cmath>
+#include <mutex>
 #include "ns3/log.h"
 #include "wifi-mode.h"
 #include "wifi-tx-vector.h"
@@ -252,8 +253,34 @@ WifiMode::WifiMode (std::string name)
 
 ATTRIBUTE_HELPER_CPP (WifiMode);
 
+namespace {
+
+/**
+ * \returns the lock of the creation of the modes
+ */
+std::mutex &
+GetCreationMutex (void)
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+} // unnamed namespace
+
 WifiModeFactory::WifiModeFactory ()
 {
+  uint32_t uid = AllocateUid ("Invalid-WifiMode");
+  WifiModeItem *item = Get (uid);
+  item->uniqueUid = "Invalid-WifiMode";
+  item->modClass = WIFI_MOD_CLASS_UNKNOWN;
+  item->isMandatory = false;
+  item->mcsValue = 0;
+  item->GetCodeRateCallback = MakeNullCallback<WifiCodeRate> ();
+  item->GetConstellationSizeCallback = MakeNullCallback<uint16_t> ();
+  item->GetPhyRateCallback = MakeNullCallback<uint64_t, const WifiTxVector&, uint16_t> ();
+  item->GetDataRateCallback = MakeNullCallback<uint64_t, const WifiTxVector&, uint16_t> ();
+  item->GetNonHtReferenceRateCallback = MakeNullCallback<uint64_t> ();
+  item->IsAllowedCallback = MakeNullCallback<bool, const WifiTxVector&> ();
 }
 
 WifiMode
@@ -266,6 +293,7 @@ WifiModeFactory::CreateWifiMode (std::string uniqueName,
                                  DataRateCallback dataRateCallback,
                                  AllowedCallback isAllowedCallback)
 {
+  std::lock_guard<std::mutex> lock (GetCreationMutex ());
   WifiModeFactory *factory = GetFactory ();
   uint32_t uid = factory->AllocateUid (uniqueName);
   WifiModeItem *item = factory->Get (uid);
@@ -313,6 +341,7 @@ WifiModeFactory::CreateWifiMcs (std::string uniqueName,
                                 NonHtReferenceRateCallback nonHtReferenceRateCallback,
                                 AllowedCallback isAllowedCallback)
 {
+  std::lock_guard<std::mutex> lock (GetCreationMutex ());
   WifiModeFactory *factory = GetFactory ();
   uint32_t uid = factory->AllocateUid (uniqueName);
   WifiModeItem *item = factory->Get (uid);
@@ -396,24 +425,8 @@ WifiModeFactory::Get (uint32_t uid)
 WifiModeFactory *
 WifiModeFactory::GetFactory (void)
 {
-  static bool isFirstTime = true;
+  // Initialized once, even if several threads get here first
   static WifiModeFactory factory;
-  if (isFirstTime)
-    {
-      uint32_t uid = factory.AllocateUid ("Invalid-WifiMode");
-      WifiModeItem *item = factory.Get (uid);
-      item->uniqueUid = "Invalid-WifiMode";
-      item->modClass = WIFI_MOD_CLASS_UNKNOWN;
-      item->isMandatory = false;
-      item->mcsValue = 0;
-      item->GetCodeRateCallback = MakeNullCallback<WifiCodeRate> ();
-      item->GetConstellationSizeCallback = MakeNullCallback<uint16_t> ();
-      item->GetPhyRateCallback = MakeNullCallback<uint64_t, const WifiTxVector&, uint16_t> ();
-      item->GetDataRateCallback = MakeNullCallback<uint64_t, const WifiTxVector&, uint16_t> ();
-      item->GetNonHtReferenceRateCallback = MakeNullCallback<uint64_t> ();
-      item->IsAllowedCallback = MakeNullCallback<bool, const WifiTxVector&> ();
-      isFirstTime = false;
-    }
   return &factory;
 }
 
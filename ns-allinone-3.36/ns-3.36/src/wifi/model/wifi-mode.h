@@ -268,6 +268,11 @@ typedef WifiModeList::const_iterator WifiModeListIterator;
  *
  * This factory ensures that each WifiMode created has a unique name
  * and assigns to each of them a unique integer.
+ *
+ * The factory is shared by all the threads. The PHY entities create their
+ * modes during static initialization, under a lock; the modes are then
+ * only read, through raw pointers and without copying their callbacks, so
+ * that several threads can simulate at the same time.
  */
 class WifiModeFactory
 {
@@ -615,12 +615,12 @@ WifiPhy::CalculateSnr (const WifiTxVector& txVector, double ber) const
   return m_interference.GetErrorRateModel ()->CalculateSnr (txVector, ber);
 }
 
-const Ptr<const PhyEntity>
+const PhyEntity *
 WifiPhy::GetStaticPhyEntity (WifiModulationClass modulation)
 {
   const auto it = GetStaticPhyEntities ().find (modulation);
   NS_ABORT_MSG_IF (it == GetStaticPhyEntities ().end (), "Unimplemented Wi-Fi modulation class");
-  return it->second;
+  return PeekPointer (it->second);
 }
 
 Ptr<PhyEntity>
@@ -1601,7 +1601,7 @@ WifiPhy::Reset (void)
 }
 
 void
-WifiPhy::StartReceivePreamble (Ptr<WifiPpdu> ppdu, RxPowerWattPerChannelBand& rxPowersW, Time rxDuration)
+WifiPhy::StartReceivePreamble (Ptr<const WifiPpdu> ppdu, RxPowerWattPerChannelBand& rxPowersW, Time rxDuration)
 {
   WifiModulationClass modulation = ppdu->GetTxVector ().GetModulationClass ();
   auto it = m_phyEntities.find (modulation);
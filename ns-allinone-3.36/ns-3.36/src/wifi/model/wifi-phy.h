@@ -99,11 +99,14 @@ public:
   /**
    * Start receiving the PHY preamble of a PPDU (i.e. the first bit of the preamble has arrived).
    *
+   * The PPDU may be shared with the other receivers of the same transmission
+   * and must therefore not be modified; use WifiPpdu::Copy if needed.
+   *
    * \param ppdu the arriving PPDU
    * \param rxPowersW the receive power in W per band
    * \param rxDuration the duration of the PPDU
    */
-  void StartReceivePreamble (Ptr<WifiPpdu> ppdu, RxPowerWattPerChannelBand& rxPowersW, Time rxDuration);
+  void StartReceivePreamble (Ptr<const WifiPpdu> ppdu, RxPowerWattPerChannelBand& rxPowersW, Time rxDuration);
 
   /**
    * Reset PHY at the end of the packet under reception after it has failed the PHY header.
@@ -1002,10 +1005,13 @@ public:
    * This is used to compute the different amendment-specific parameters within
    * calling static methods.
    *
+   * The entities are shared by all the threads: a raw pointer is returned,
+   * so that the reference count of the entity is not touched.
+   *
    * \param modulation the modulation class
    * \return the pointer to the static implemented PHY entity
    */
-  static const Ptr<const PhyEntity> GetStaticPhyEntity (WifiModulationClass modulation);
+  static const PhyEntity * GetStaticPhyEntity (WifiModulationClass modulation);
 
   /**
    * Get the supported PHY entity corresponding to the modulation class, for
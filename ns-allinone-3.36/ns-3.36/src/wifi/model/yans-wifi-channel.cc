@@ -21,16 +21,20 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/wifi-net-device.h"
 #include "ns3/node.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-delay-model.h"
 #include "ns3/mobility-model.h"
+#include "ns3/position-snapshot.h"
 #include "yans-wifi-channel.h"
 #include "yans-wifi-phy.h"
 #include "wifi-utils.h"
 #include "wifi-ppdu.h"
 #include "wifi-psdu.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -53,11 +57,41 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("MaxRange",
+                   "Distance (m) beyond which a transmission can neither be detected nor interfere. "
+                   "If strictly positive, Send only visits the PHYs within this distance of the "
+                   "sender, using a uniform grid of the PHY positions. Zero disables the culling.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("GridUpdateInterval",
+                   "Maximum age of the spatial grid before it is rebuilt from the current positions. "
+                   "Zero rebuilds the grid whenever the simulation time has advanced.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&YansWifiChannel::m_gridUpdateInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("MaxSpeed",
+                   "Upper bound on the speed (m/s) of any PHY, used to widen the grid search "
+                   "when the grid is older than the current time.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_maxSpeed),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("GroupedDelivery",
+                   "If true, schedule a single event per PPDU which triggers the receptions "
+                   "in order of arrival, instead of one event per receiver.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansWifiChannel::m_groupedDelivery),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_maxRange (0.0),
+    m_gridUpdateInterval (Seconds (0)),
+    m_maxSpeed (0.0),
+    m_groupedDelivery (false),
+    m_gridValid (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -88,42 +122,176 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
   NS_LOG_FUNCTION (this << sender << ppdu << txPowerDbm);
   Ptr<MobilityModel> senderMobility = sender->GetMobility ();
   NS_ASSERT (senderMobility != 0);
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
+  Ptr<DeliveryGroup> group;
+  std::vector<Delivery> *deliveries = nullptr;
+  if (m_groupedDelivery)
     {
-      if (sender != (*i))
+      group = Create<DeliveryGroup> ();
+      group->ppdu = ppdu;
+      group->txTime = Simulator::Now ();
+      group->next = 0;
+      deliveries = &group->deliveries;
+    }
+  Vector senderPosition = GetPhyPosition (sender, senderMobility);
+  m_receivers.clear ();
+  m_receiverMobility.clear ();
+  m_receiverNodes.clear ();
+  m_receiverPositions.Clear ();
+  if (m_maxRange > 0)
+    {
+      GetCandidates (senderPosition);
+      NS_LOG_DEBUG ("visiting " << m_candidates.size () << " out of " << m_phyList.size () << " PHYs");
+      for (uint32_t index : m_candidates)
+        {
+          AddReceiver (sender, senderPosition, m_phyList[index]);
+        }
+    }
+  else
+    {
+      for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
+        {
+          AddReceiver (sender, senderPosition, *i);
+        }
+    }
+
+  if (m_loss->SupportsBatch ())
+    {
+      m_rxPowersDbm.resize (m_receivers.size ());
+      m_loss->CalcRxPowerBatch (txPowerDbm, senderPosition,
+                                m_receiverPositions, m_rxPowersDbm.data ());
+    }
+  else
+    {
+      m_rxPowersDbm.clear ();
+      for (const auto & mobility : m_receiverMobility)
         {
-          //For now don't account for inter channel interference nor channel bonding
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
-            {
-              continue;
-            }
-
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
-          NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
-                        "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
-          Ptr<WifiPpdu> copy = ppdu->Copy ();
-          Ptr<NetDevice> dstNetDevice = (*i)->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
-            {
-              dstNode = 0xffffffff;
-            }
-          else
-            {
-              dstNode = dstNetDevice->GetNode ()->GetId ();
-            }
-
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive,
-                                          (*i), copy, rxPowerDbm);
+          m_rxPowersDbm.push_back (m_loss->CalcRxPower (txPowerDbm, senderMobility, mobility));
         }
     }
+
+  for (std::size_t i = 0; i < m_receivers.size (); i++)
+    {
+      SendTo (senderMobility, m_receivers[i], m_receiverMobility[i], m_receiverNodes[i],
+              ppdu, txPowerDbm, m_rxPowersDbm[i], deliveries);
+    }
+  if (group != 0 && !group->deliveries.empty ())
+    {
+      // Events expiring at the same time are executed in the order they were
+      // scheduled, i.e. in the order of the PHY list: keep it for equal delays
+      std::stable_sort (group->deliveries.begin (), group->deliveries.end (),
+                        [] (const Delivery &a, const Delivery &b) { return a.delay < b.delay; });
+      const Delivery &first = group->deliveries.front ();
+      Simulator::ScheduleWithContext (first.context, first.delay,
+                                      &YansWifiChannel::ReceiveGrouped, group);
+    }
+}
+
+Vector
+YansWifiChannel::GetPhyPosition (Ptr<YansWifiPhy> phy, Ptr<MobilityModel> mobility)
+{
+  Ptr<NetDevice> device = phy->GetDevice ();
+  if (device != 0 && device->GetNode () != 0)
+    {
+      uint32_t nodeId = device->GetNode ()->GetId ();
+      // The PHY may have its own mobility model, distinct from the node's
+      if (PositionSnapshot::GetMobility (nodeId) == mobility)
+        {
+          return PositionSnapshot::GetPosition (nodeId);
+        }
+    }
+  return mobility->GetPosition ();
+}
+
+void
+YansWifiChannel::AddReceiver (Ptr<YansWifiPhy> sender, const Vector &senderPosition,
+                              Ptr<YansWifiPhy> receiver) const
+{
+  if (sender == receiver)
+    {
+      return;
+    }
+  //For now don't account for inter channel interference nor channel bonding
+  if (receiver->GetChannelNumber () != sender->GetChannelNumber ())
+    {
+      return;
+    }
+
+  Ptr<MobilityModel> receiverMobility = receiver->GetMobility ();
+  Vector receiverPosition = GetPhyPosition (receiver, receiverMobility);
+  if (m_maxRange > 0 && CalculateDistance (senderPosition, receiverPosition) > m_maxRange)
+    {
+      return;
+    }
+  Ptr<NetDevice> dstNetDevice = receiver->GetDevice ();
+  uint32_t dstNode;
+  if (dstNetDevice == 0)
+    {
+      dstNode = 0xffffffff;
+    }
+  else
+    {
+      dstNode = dstNetDevice->GetNode ()->GetId ();
+    }
+  m_receivers.push_back (receiver);
+  m_receiverMobility.push_back (receiverMobility);
+  m_receiverNodes.push_back (dstNode);
+  m_receiverPositions.Add (receiverPosition);
+}
+
+void
+YansWifiChannel::SendTo (Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver,
+                         Ptr<MobilityModel> receiverMobility, uint32_t dstNode,
+                         Ptr<const WifiPpdu> ppdu, double txPowerDbm, double rxPowerDbm,
+                         std::vector<Delivery> *deliveries) const
+{
+  Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+  NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
+                "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
+
+  if (deliveries != nullptr)
+    {
+      deliveries->push_back ({delay, receiver, dstNode, rxPowerDbm});
+      return;
+    }
+  Simulator::ScheduleWithContext (dstNode,
+                                  delay, &YansWifiChannel::Receive,
+                                  receiver, ppdu, rxPowerDbm);
 }
 
 void
-YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<WifiPpdu> ppdu, double rxPowerDbm)
+YansWifiChannel::BuildGrid (void) const
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<Vector> positions;
+  positions.reserve (m_phyList.size ());
+  for (const auto & phy : m_phyList)
+    {
+      Ptr<MobilityModel> mobility = phy->GetMobility ();
+      NS_ASSERT (mobility != 0);
+      positions.push_back (mobility->GetPosition ());
+    }
+  m_grid.Build (positions, m_maxRange);
+  m_gridTime = Simulator::Now ();
+  m_gridValid = true;
+}
+
+void
+YansWifiChannel::GetCandidates (const Vector &position) const
+{
+  if (!m_gridValid || Simulator::Now () - m_gridTime > m_gridUpdateInterval)
+    {
+      BuildGrid ();
+    }
+  // PHYs may have moved since the grid was built
+  double radius = m_maxRange + m_maxSpeed * (Simulator::Now () - m_gridTime).GetSeconds ();
+  m_grid.GetCandidates (position, radius, &m_candidates);
+  // Visit the PHYs in the same order as without the grid, so that the
+  // reception events are scheduled in the same order
+  std::sort (m_candidates.begin (), m_candidates.end ());
+}
+
+void
+YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<const WifiPpdu> ppdu, double rxPowerDbm)
 {
   NS_LOG_FUNCTION (phy << ppdu << rxPowerDbm);
   // Do no further processing if signal is too weak
@@ -138,6 +306,23 @@ YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<WifiPpdu> ppdu, double rxPow
   phy->StartReceivePreamble (ppdu, rxPowerW, ppdu->GetTxDuration ());
 }
 
+void
+YansWifiChannel::ReceiveGrouped (Ptr<DeliveryGroup> group)
+{
+  NS_LOG_FUNCTION (group << group->next);
+  const Delivery &delivery = group->deliveries[group->next++];
+  Receive (delivery.receiver, group->ppdu, delivery.rxPowerDbm);
+  if (group->next < group->deliveries.size ())
+    {
+      // Take over the position of this event among simultaneous events, as
+      // the per-receiver events would all have been scheduled at once by Send
+      const Delivery &next = group->deliveries[group->next];
+      Simulator::RescheduleWithContext (next.context,
+                                        group->txTime + next.delay - Simulator::Now (),
+                                        &YansWifiChannel::ReceiveGrouped, group);
+    }
+}
+
 std::size_t
 YansWifiChannel::GetNDevices (void) const
 {
@@ -155,6 +340,7 @@ YansWifiChannel::Add (Ptr<YansWifiPhy> phy)
 {
   NS_LOG_FUNCTION (this << phy);
   m_phyList.push_back (phy);
+  m_gridValid = false;
 }
 
 int64_t
@@ -22,6 +22,11 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include "ns3/channel.h"
+#include "ns3/nstime.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/spatial-grid.h"
+#include "ns3/vector.h"
+#include "ns3/propagation-loss-model.h"
 
 namespace ns3 {
 
@@ -30,8 +35,8 @@ class PropagationLossModel;
 class PropagationDelayModel;
 class YansWifiPhy;
 class Packet;
-class Time;
 class WifiPpdu;
+class MobilityModel;
 
 /**
  * \brief a channel to interconnect ns3::YansWifiPhy objects.
@@ -41,6 +46,23 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * If the MaxRange attribute is strictly positive, the channel keeps a
+ * uniform grid of the PHY positions and Send only visits the PHYs whose
+ * grid cells are within MaxRange of the sender. PHYs farther away than
+ * MaxRange do not receive the PPDU at all, so MaxRange must be chosen
+ * large enough to cover both the detection and the interference range.
+ *
+ * If all the propagation loss models of the chain support it, the RX
+ * powers of all the receivers of a PPDU are computed in a single call to
+ * PropagationLossModel::CalcRxPowerBatch.
+ *
+ * If the GroupedDelivery attribute is set, Send inserts a single event per
+ * transmission in the scheduler instead of one per receiver. This event
+ * hands the PPDU over to the receivers in order of arrival, each time
+ * re-arming itself for the next receiver with the context of its node.
+ * The receptions happen in exactly the same order as with one event per
+ * receiver.
  */
 class YansWifiChannel : public Channel
 {
@@ -103,20 +125,121 @@ private:
    */
   typedef std::vector<Ptr<YansWifiPhy> > PhyList;
 
+  /**
+   * A reception to be triggered by a grouped delivery.
+   */
+  struct Delivery
+  {
+    Time delay;                 //!< propagation delay from the sender
+    Ptr<YansWifiPhy> receiver;  //!< the receiving PHY
+    uint32_t context;           //!< the context (node ID) of the receiver
+    double rxPowerDbm;          //!< the RX power, in dBm
+  };
+
+  /**
+   * All the receptions of a PPDU, sorted by propagation delay.
+   */
+  struct DeliveryGroup : public SimpleRefCount<DeliveryGroup>
+  {
+    Ptr<const WifiPpdu> ppdu;           //!< the PPDU being sent
+    Time txTime;                        //!< the time at which the PPDU was sent
+    std::vector<Delivery> deliveries;   //!< the receptions, in order
+    std::size_t next;                   //!< the index of the next reception
+  };
+
+  /**
+   * Get the position of a PHY, from the PositionSnapshot if the PHY uses the
+   * mobility model of its node.
+   *
+   * \param phy the PHY
+   * \param mobility the mobility model of the PHY
+   * \returns the current position of the PHY
+   */
+  static Vector GetPhyPosition (Ptr<YansWifiPhy> phy, Ptr<MobilityModel> mobility);
+
+  /**
+   * Append the given PHY to m_receivers if it has to receive the PPDU sent
+   * by the given sender.
+   *
+   * \param sender the PHY object from which the packet is originating
+   * \param senderPosition the position of the sender
+   * \param receiver the candidate receiver
+   */
+  void AddReceiver (Ptr<YansWifiPhy> sender, const Vector &senderPosition,
+                    Ptr<YansWifiPhy> receiver) const;
+
+  /**
+   * Deliver the PPDU to a single PHY: compute the propagation delay and
+   * schedule the reception.
+   *
+   * \param senderMobility the mobility model of the sender
+   * \param receiver the PHY to which the PPDU is delivered
+   * \param receiverMobility the mobility model of the receiver
+   * \param dstNode the context (node ID) of the receiver
+   * \param ppdu the PPDU to send
+   * \param txPowerDbm the TX power associated to the packet, in dBm
+   * \param rxPowerDbm the RX power of the PPDU at the receiver, in dBm
+   * \param deliveries if not null, the reception is appended to this list
+   *        instead of being scheduled
+   */
+  void SendTo (Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver,
+               Ptr<MobilityModel> receiverMobility, uint32_t dstNode,
+               Ptr<const WifiPpdu> ppdu, double txPowerDbm, double rxPowerDbm,
+               std::vector<Delivery> *deliveries) const;
+
+  /**
+   * Rebuild the spatial grid from the current positions of all the PHYs.
+   */
+  void BuildGrid (void) const;
+
+  /**
+   * Fill m_candidates with the indices (in m_phyList, in ascending order) of
+   * the PHYs that may be located within MaxRange of the given position.
+   *
+   * \param position the position of the sender
+   */
+  void GetCandidates (const Vector &position) const;
+
   /**
    * This method is scheduled by Send for each associated YansWifiPhy.
    * The method then calls the corresponding YansWifiPhy that the first
-   * bit of the PPDU has arrived.
+   * bit of the PPDU has arrived. All the receivers share the same,
+   * immutable, PPDU.
    *
    * \param receiver the device to which the packet is destined
    * \param ppdu the PPDU being sent
    * \param txPowerDbm the TX power associated to the packet being sent (dBm)
    */
-  static void Receive (Ptr<YansWifiPhy> receiver, Ptr<WifiPpdu> ppdu, double txPowerDbm);
+  static void Receive (Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, double txPowerDbm);
+
+  /**
+   * This method is scheduled by Send once per PPDU when the grouped
+   * delivery is enabled. It triggers the next reception of the group and
+   * re-arms itself for the following one.
+   *
+   * \param group the receptions of the PPDU
+   */
+  static void ReceiveGrouped (Ptr<DeliveryGroup> group);
 
   PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
   Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
   Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+
+  double m_maxRange;                   //!< Range (m) beyond which receivers are skipped, 0 to disable
+  Time m_gridUpdateInterval;           //!< Maximum age of the spatial grid
+  double m_maxSpeed;                   //!< Upper bound on the node speed (m/s) between two grid updates
+  bool m_groupedDelivery;              //!< Whether to schedule a single event per PPDU
+
+  mutable bool m_gridValid;                     //!< Whether the spatial grid has been built for m_phyList
+  mutable Time m_gridTime;                      //!< Time at which the spatial grid was built
+  mutable SpatialGrid m_grid;                   //!< Spatial grid of the positions of the PHYs in m_phyList
+  mutable std::vector<uint32_t> m_candidates;   //!< Scratch list of the PHYs visited by Send
+
+  mutable PhyList m_receivers;                                //!< Scratch list of the receivers of a PPDU
+  mutable std::vector<Ptr<MobilityModel> > m_receiverMobility; //!< Mobility models of m_receivers
+  mutable std::vector<uint32_t> m_receiverNodes;              //!< Node IDs of m_receivers
+  mutable PositionBatch m_receiverPositions;                  //!< Positions of m_receivers
+  mutable std::vector<double> m_rxPowersDbm;                  //!< RX powers (dBm) at m_receivers
 };
 
 } //namespace ns3
@@ -0,0 +1,300 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <string>
+#include <thread>
+#include <vector>
+#include "ns3/boolean.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/yans-wifi-channel.h"
+#include "ns3/yans-wifi-helper.h"
+
+using namespace ns3;
+
+namespace {
+
+/**
+ * Reception event seen by a PHY: start of a payload or drop of a PPDU
+ */
+struct RxEvent
+{
+  int64_t time;     //!< time of the event (ns)
+  uint32_t node;    //!< index of the receiving node
+  bool drop;        //!< whether the PPDU was dropped
+  double value;     //!< received power (W), or drop reason
+};
+
+/**
+ * \param events the events
+ * \param node index of the receiving node
+ * \param packet the packet
+ * \param rxPowersW the received power per band
+ */
+void
+RxBegin (std::vector<RxEvent> *events, uint32_t node,
+         Ptr<const Packet> packet, RxPowerWattPerChannelBand rxPowersW)
+{
+  double power = 0;
+  for (const auto & band : rxPowersW)
+    {
+      power += band.second;
+    }
+  events->push_back ({Simulator::Now ().GetNanoSeconds (), node, false, power});
+}
+
+/**
+ * \param events the events
+ * \param node index of the receiving node
+ * \param packet the packet
+ * \param reason the drop reason
+ */
+void
+RxDrop (std::vector<RxEvent> *events, uint32_t node,
+        Ptr<const Packet> packet, WifiPhyRxfailureReason reason)
+{
+  events->push_back ({Simulator::Now ().GetNanoSeconds (), node, true, static_cast<double> (reason)});
+}
+
+/**
+ * \param device the sending device
+ */
+void
+SendBroadcast (Ptr<WifiNetDevice> device)
+{
+  device->Send (Create<Packet> (500), device->GetBroadcast (), 1);
+}
+
+/**
+ * Run two ad hoc senders broadcasting at the same times to six receivers,
+ * two of which are at the same distance from a sender, and record what the
+ * PHYs receive.
+ *
+ * \param grouped whether the channel uses grouped delivery
+ * \param events the reception events, in order of execution
+ */
+void
+RunBroadcasts (bool grouped, std::vector<RxEvent> *events)
+{
+  RngSeedManager::ResetNextStreamIndex ();
+  NodeContainer nodes;
+  nodes.Create (8);
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  positions->Add (Vector (0, 0, 0));
+  positions->Add (Vector (30, 0, 0));
+  positions->Add (Vector (60, 0, 0));
+  positions->Add (Vector (0, 60, 0));
+  positions->Add (Vector (120, 0, 0));
+  positions->Add (Vector (200, 0, 0));
+  positions->Add (Vector (250, 0, 0));
+  positions->Add (Vector (300, 0, 0));
+  mobility.SetPositionAllocator (positions);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  Ptr<YansWifiChannel> channel = YansWifiChannelHelper::Default ().Create ()->GetObject<YansWifiChannel> ();
+  channel->SetAttribute ("GroupedDelivery", BooleanValue (grouped));
+  YansWifiPhyHelper phy;
+  phy.SetChannel (channel);
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  wifi.AssignStreams (devices, 0);
+
+  for (uint32_t i = 0; i < devices.GetN (); i++)
+    {
+      Ptr<WifiPhy> wifiPhy = devices.Get (i)->GetObject<WifiNetDevice> ()->GetPhy ();
+      wifiPhy->TraceConnectWithoutContext ("PhyRxBegin", MakeBoundCallback (&RxBegin, events, i));
+      wifiPhy->TraceConnectWithoutContext ("PhyRxDrop", MakeBoundCallback (&RxDrop, events, i));
+    }
+  // Both ends send at once every 10 ms, so that the middle nodes see the
+  // two PPDUs overlap
+  for (uint32_t k = 0; k < 10; k++)
+    {
+      for (uint32_t sender : {0, 7})
+        {
+          Ptr<WifiNetDevice> device = devices.Get (sender)->GetObject<WifiNetDevice> ();
+          Simulator::ScheduleWithContext (sender, Seconds (1) + MilliSeconds (10 * k),
+                                          &SendBroadcast, device);
+        }
+    }
+  Simulator::Stop (Seconds (2));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+} // unnamed namespace
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Grouped delivery test
+ *
+ * Run the same topology with one event per receiver and with grouped
+ * delivery, and check that the PHYs see the same receptions and drops, at
+ * the same times, with the same powers and in the same order.
+ */
+class YansWifiChannelGroupedDeliveryTest : public TestCase
+{
+public:
+  YansWifiChannelGroupedDeliveryTest ();
+  virtual ~YansWifiChannelGroupedDeliveryTest ();
+
+private:
+  virtual void DoRun (void);
+};
+
+YansWifiChannelGroupedDeliveryTest::YansWifiChannelGroupedDeliveryTest ()
+  : TestCase ("Check that grouped delivery gives the same receptions as per-receiver delivery")
+{
+}
+
+YansWifiChannelGroupedDeliveryTest::~YansWifiChannelGroupedDeliveryTest ()
+{
+}
+
+void
+YansWifiChannelGroupedDeliveryTest::DoRun (void)
+{
+  std::vector<RxEvent> perReceiver;
+  std::vector<RxEvent> grouped;
+  RunBroadcasts (false, &perReceiver);
+  RunBroadcasts (true, &grouped);
+
+  bool dropped = false;
+  for (const auto & event : perReceiver)
+    {
+      dropped = dropped || event.drop;
+    }
+  NS_TEST_ASSERT_MSG_GT (perReceiver.size (), 0, "No reception");
+  NS_TEST_ASSERT_MSG_EQ (dropped, true, "The PPDUs were expected to overlap");
+  NS_TEST_ASSERT_MSG_EQ (grouped.size (), perReceiver.size (), "Number of reception events");
+  for (std::size_t i = 0; i < perReceiver.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (grouped[i].time, perReceiver[i].time, "Time of event " << i);
+      NS_TEST_EXPECT_MSG_EQ (grouped[i].node, perReceiver[i].node, "Receiver of event " << i);
+      NS_TEST_EXPECT_MSG_EQ (grouped[i].drop, perReceiver[i].drop, "Kind of event " << i);
+      NS_TEST_EXPECT_MSG_EQ (grouped[i].value, perReceiver[i].value, "Power or reason of event " << i);
+    }
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Concurrent simulations test
+ *
+ * Run the topology on two threads at the same time, each with its own
+ * simulator, and check that both see the receptions of a run on the main
+ * thread. The threads share the wifi modes and the PHY entities of the
+ * process.
+ */
+class YansWifiChannelThreadsTest : public TestCase
+{
+public:
+  YansWifiChannelThreadsTest ();
+  virtual ~YansWifiChannelThreadsTest ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Compare the events of a run with the reference
+   * \param reference the events of the run on the main thread
+   * \param events the events of a run on another thread
+   * \param name name of the run
+   */
+  void Compare (const std::vector<RxEvent> &reference,
+                const std::vector<RxEvent> &events, std::string name);
+};
+
+YansWifiChannelThreadsTest::YansWifiChannelThreadsTest ()
+  : TestCase ("Check that two wifi simulations can run concurrently")
+{
+}
+
+YansWifiChannelThreadsTest::~YansWifiChannelThreadsTest ()
+{
+}
+
+void
+YansWifiChannelThreadsTest::Compare (const std::vector<RxEvent> &reference,
+                                     const std::vector<RxEvent> &events, std::string name)
+{
+  NS_TEST_ASSERT_MSG_EQ (events.size (), reference.size (), "Number of reception events of " << name);
+  for (std::size_t i = 0; i < reference.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (events[i].time, reference[i].time, "Time of event " << i << " of " << name);
+      NS_TEST_EXPECT_MSG_EQ (events[i].node, reference[i].node, "Receiver of event " << i << " of " << name);
+      NS_TEST_EXPECT_MSG_EQ (events[i].drop, reference[i].drop, "Kind of event " << i << " of " << name);
+      NS_TEST_EXPECT_MSG_EQ (events[i].value, reference[i].value, "Power or reason of event " << i << " of " << name);
+    }
+}
+
+void
+YansWifiChannelThreadsTest::DoRun (void)
+{
+  std::vector<RxEvent> reference;
+  RunBroadcasts (false, &reference);
+  NS_TEST_ASSERT_MSG_GT (reference.size (), 0, "No reception");
+
+  // Many rounds, to give the threads a chance to race
+  for (uint32_t round = 0; round < 20; round++)
+    {
+      std::vector<RxEvent> first;
+      std::vector<RxEvent> second;
+      std::thread a (&RunBroadcasts, false, &first);
+      std::thread b (&RunBroadcasts, true, &second);
+      a.join ();
+      b.join ();
+      Compare (reference, first, "the first thread");
+      Compare (reference, second, "the second thread");
+    }
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief YansWifiChannel Test Suite
+ */
+class YansWifiChannelTestSuite : public TestSuite
+{
+public:
+  YansWifiChannelTestSuite ();
+};
+
+YansWifiChannelTestSuite::YansWifiChannelTestSuite ()
+  : TestSuite ("yans-wifi-channel", UNIT)
+{
+  AddTestCase (new YansWifiChannelGroupedDeliveryTest, TestCase::QUICK);
+  AddTestCase (new YansWifiChannelThreadsTest, TestCase::QUICK);
+}
+
+static YansWifiChannelTestSuite g_yansWifiChannelTestSuite; ///< the test suite